@@ -0,0 +1,301 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include <application_core/CheckpointFile.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
+/** the table of the reflected polynomial 0xedb88320 **/
+uint32_t computeCyclicRedundancyCheck(const char*data,int bytes){
+	static uint32_t table[256];
+	static bool tableIsReady=false;
+
+	if(!tableIsReady){
+		for(uint32_t i=0;i<256;i++){
+			uint32_t value=i;
+			for(int bit=0;bit<8;bit++){
+				if(value&1)
+					value=0xedb88320^(value>>1);
+				else
+					value>>=1;
+			}
+			table[i]=value;
+		}
+		tableIsReady=true;
+	}
+
+	uint32_t checksum=0xffffffff;
+
+	for(int i=0;i<bytes;i++)
+		checksum=table[(checksum^(uint8_t)data[i])&0xff]^(checksum>>8);
+
+	return checksum^0xffffffff;
+}
+
+void CheckpointBuffer::openForWriting(Parameters*parameters,const char*checkpointName){
+	m_name=checkpointName;
+	m_file=parameters->getCheckpointFile(checkpointName);
+	m_rank=parameters->getRank();
+	m_writing=true;
+	m_reachedEnd=false;
+	m_bytes=0;
+	m_storedBytes=0;
+
+	m_output.open(m_file.c_str(),ios_base::out|ios_base::binary|ios_base::trunc);
+
+	CheckpointHeader header;
+	header.m_magicNumber=CHECKPOINT_MAGIC_NUMBER;
+	header.m_version=CHECKPOINT_FORMAT_VERSION;
+	header.m_kmerLength=parameters->getWordSize();
+	header.m_maximumKmerLength=MAXKMERLENGTH;
+	header.m_ranks=parameters->getSize();
+	header.m_rank=parameters->getRank();
+	header.m_minimizerLength=parameters->getMinimizerLength();
+
+	m_output.write((char*)&header,sizeof(CheckpointHeader));
+
+	m_chunk.resize(CHECKPOINT_CHUNK_SIZE);
+	setp(&(m_chunk[0]),&(m_chunk[0])+m_chunk.size());
+}
+
+void CheckpointBuffer::openForReading(Parameters*parameters,const char*checkpointName){
+	m_name=checkpointName;
+	m_file=parameters->getCheckpointFile(checkpointName);
+	m_rank=parameters->getRank();
+	m_writing=false;
+	m_reachedEnd=false;
+	m_bytes=0;
+	m_storedBytes=0;
+
+	m_input.open(m_file.c_str(),ios_base::in|ios_base::binary);
+
+	CheckpointHeader header;
+	m_input.read((char*)&header,sizeof(CheckpointHeader));
+
+	if(!m_input.good() || header.m_magicNumber!=CHECKPOINT_MAGIC_NUMBER)
+		fail("is not a checkpoint file, it was maybe written by an older version of Ray");
+
+	if(header.m_version!=CHECKPOINT_FORMAT_VERSION)
+		fail("was written with another version of the checkpoint format");
+
+	if(header.m_kmerLength!=parameters->getWordSize())
+		fail("was written with another k-mer length");
+
+	if(header.m_maximumKmerLength!=MAXKMERLENGTH)
+		fail("was written by Ray compiled with another MAXKMERLENGTH");
+
+	if(header.m_ranks!=parameters->getSize() || header.m_rank!=parameters->getRank())
+		fail("was written with another number of ranks");
+
+	if(header.m_minimizerLength!=parameters->getMinimizerLength())
+		fail("was written with another partitioning of k-mers (-minimizer-partitioning)");
+
+	setg(NULL,NULL,NULL);
+}
+
+void CheckpointBuffer::fail(const char*reason){
+	cout<<"Error: checkpoint "<<m_name<<" ("<<m_file<<") "<<reason<<endl;
+	exit(1);
+}
+
+void CheckpointBuffer::writeChunk(bool last){
+	int bytes=pptr()-pbase();
+
+	if(bytes>0){
+		CheckpointChunkHeader header;
+		header.m_bytes=bytes;
+		header.m_checksum=computeCyclicRedundancyCheck(pbase(),bytes);
+		header.m_codec=CHECKPOINT_CODEC_STORED;
+		header.m_storedBytes=bytes;
+
+		const char*stored=pbase();
+
+		#ifdef HAVE_LIBZ
+		uLongf compressedBytes=compressBound(bytes);
+		m_storedChunk.resize(compressedBytes);
+
+		if(compress2((Bytef*)&(m_storedChunk[0]),&compressedBytes,(const Bytef*)pbase(),bytes,
+			Z_BEST_SPEED)==Z_OK && (int)compressedBytes<bytes){
+
+			header.m_codec=CHECKPOINT_CODEC_DEFLATE;
+			header.m_storedBytes=compressedBytes;
+			stored=&(m_storedChunk[0]);
+		}
+		#endif
+
+		m_output.write((char*)&header,sizeof(CheckpointChunkHeader));
+		m_output.write(stored,header.m_storedBytes);
+
+		m_bytes+=header.m_bytes;
+		m_storedBytes+=header.m_storedBytes;
+	}
+
+	if(last){
+		CheckpointChunkHeader header;
+		memset(&header,0,sizeof(CheckpointChunkHeader));
+		m_output.write((char*)&header,sizeof(CheckpointChunkHeader));
+	}
+
+	setp(&(m_chunk[0]),&(m_chunk[0])+m_chunk.size());
+}
+
+bool CheckpointBuffer::readChunk(){
+	if(m_reachedEnd)
+		return false;
+
+	CheckpointChunkHeader header;
+	m_input.read((char*)&header,sizeof(CheckpointChunkHeader));
+
+	if(!m_input.good())
+		fail("is truncated");
+
+	if(header.m_bytes==0){
+		m_reachedEnd=true;
+		return false;
+	}
+
+	if(header.m_bytes>CHECKPOINT_CHUNK_SIZE || header.m_storedBytes>header.m_bytes)
+		fail("has an invalid chunk");
+
+	m_chunk.resize(header.m_bytes);
+
+	if(header.m_codec==CHECKPOINT_CODEC_STORED){
+		m_input.read(&(m_chunk[0]),header.m_bytes);
+
+		if(!m_input.good())
+			fail("is truncated");
+
+	#ifdef HAVE_LIBZ
+	}else if(header.m_codec==CHECKPOINT_CODEC_DEFLATE){
+		m_storedChunk.resize(header.m_storedBytes);
+		m_input.read(&(m_storedChunk[0]),header.m_storedBytes);
+
+		if(!m_input.good())
+			fail("is truncated");
+
+		uLongf bytes=header.m_bytes;
+
+		if(uncompress((Bytef*)&(m_chunk[0]),&bytes,(const Bytef*)&(m_storedChunk[0]),header.m_storedBytes)!=Z_OK
+			|| bytes!=header.m_bytes)
+			fail("has a chunk that can not be decompressed");
+	#endif
+
+	}else{
+		fail("is compressed, but Ray was compiled without HAVE_LIBZ");
+	}
+
+	if(computeCyclicRedundancyCheck(&(m_chunk[0]),header.m_bytes)!=header.m_checksum)
+		fail("is corrupted (invalid CRC32)");
+
+	m_bytes+=header.m_bytes;
+	m_storedBytes+=header.m_storedBytes;
+
+	setg(&(m_chunk[0]),&(m_chunk[0]),&(m_chunk[0])+header.m_bytes);
+
+	return true;
+}
+
+int CheckpointBuffer::overflow(int character){
+	if(!m_writing)
+		return EOF;
+
+	writeChunk(false);
+
+	if(character!=EOF){
+		*pptr()=character;
+		pbump(1);
+	}
+
+	return 0;
+}
+
+int CheckpointBuffer::underflow(){
+	if(gptr()<egptr())
+		return (uint8_t)*gptr();
+
+	if(m_writing || !readChunk())
+		return EOF;
+
+	return (uint8_t)*gptr();
+}
+
+/** chunks are only written when they are full **/
+int CheckpointBuffer::sync(){
+	return 0;
+}
+
+void CheckpointBuffer::close(){
+	if(m_writing && m_output.is_open()){
+		writeChunk(true);
+		m_output.close();
+
+		cout<<"Rank "<<m_rank<<" wrote checkpoint "<<m_name<<", "<<m_bytes<<" bytes ("<<m_storedBytes<<" bytes in the file)"<<endl;
+
+	}else if(!m_writing && m_input.is_open()){
+		m_input.close();
+	}
+}
+
+LargeCount CheckpointBuffer::getBytes(){
+	return m_bytes;
+}
+
+LargeCount CheckpointBuffer::getStoredBytes(){
+	return m_storedBytes;
+}
+
+CheckpointWriter::CheckpointWriter(Parameters*parameters,const char*checkpointName)
+	: ostream(NULL){
+
+	m_buffer.openForWriting(parameters,checkpointName);
+	rdbuf(&m_buffer);
+}
+
+CheckpointWriter::~CheckpointWriter(){
+	close();
+}
+
+void CheckpointWriter::close(){
+	m_buffer.close();
+}
+
+CheckpointReader::CheckpointReader(Parameters*parameters,const char*checkpointName)
+	: istream(NULL){
+
+	m_buffer.openForReading(parameters,checkpointName);
+	rdbuf(&m_buffer);
+}
+
+CheckpointReader::~CheckpointReader(){
+	close();
+}
+
+void CheckpointReader::close(){
+	m_buffer.close();
+}
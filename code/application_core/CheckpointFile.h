@@ -0,0 +1,147 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _CheckpointFile_h
+#define _CheckpointFile_h
+
+#include <application_core/Parameters.h>
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+using namespace std;
+
+/** "RAYC" **/
+#define CHECKPOINT_MAGIC_NUMBER 0x52415943
+#define CHECKPOINT_FORMAT_VERSION 2
+
+/** records are grouped in chunks of this size before compression **/
+#define CHECKPOINT_CHUNK_SIZE 4194304
+
+#define CHECKPOINT_CODEC_STORED 0
+#define CHECKPOINT_CODEC_DEFLATE 1
+
+/**
+ * The header of a checkpoint file.
+ * A checkpoint can only be read with the same k-mer length,
+ * the same MAXKMERLENGTH, the same number of ranks and the same
+ * partitioning of k-mers.
+ */
+class CheckpointHeader{
+public:
+	uint32_t m_magicNumber;
+	uint32_t m_version;
+	int32_t m_kmerLength;
+	int32_t m_maximumKmerLength;
+	int32_t m_ranks;
+	int32_t m_rank;
+	int32_t m_minimizerLength;
+};
+
+/**
+ * Each chunk starts with this, followed by storedBytes bytes.
+ * A chunk with 0 bytes marks the end of the file.
+ */
+class CheckpointChunkHeader{
+public:
+	uint32_t m_storedBytes;
+	uint32_t m_bytes;
+	uint32_t m_codec;
+	uint32_t m_checksum;
+};
+
+/**
+ * A stream buffer for checkpoint files.
+ *
+ * Records are written in a memory chunk. Full chunks are compressed
+ * with zlib (when Ray is compiled with HAVE_LIBZ) and written with a CRC32 of their content.
+ * When reading, a whole chunk is read and verified at once, so reading
+ * a record is a copy in memory.
+ *
+ * \author Sébastien Boisvert
+ */
+class CheckpointBuffer : public streambuf{
+
+	string m_name;
+	string m_file;
+	Rank m_rank;
+	bool m_writing;
+	bool m_reachedEnd;
+
+	ofstream m_output;
+	ifstream m_input;
+
+	vector<char> m_chunk;
+	vector<char> m_storedChunk;
+
+	LargeCount m_bytes;
+	LargeCount m_storedBytes;
+
+	void writeChunk(bool last);
+	bool readChunk();
+	void fail(const char*reason);
+
+protected:
+	int overflow(int character);
+	int underflow();
+	int sync();
+
+public:
+	void openForWriting(Parameters*parameters,const char*checkpointName);
+	void openForReading(Parameters*parameters,const char*checkpointName);
+	void close();
+
+	LargeCount getBytes();
+	LargeCount getStoredBytes();
+};
+
+/**
+ * Writes a checkpoint, like an ofstream.
+ */
+class CheckpointWriter : public ostream{
+
+	CheckpointBuffer m_buffer;
+
+public:
+	CheckpointWriter(Parameters*parameters,const char*checkpointName);
+	~CheckpointWriter();
+	void close();
+};
+
+/**
+ * Reads a checkpoint, like an ifstream.
+ * The program stops if the checkpoint is not valid.
+ */
+class CheckpointReader : public istream{
+
+	CheckpointBuffer m_buffer;
+
+public:
+	CheckpointReader(Parameters*parameters,const char*checkpointName);
+	~CheckpointReader();
+	void close();
+};
+
+uint32_t computeCyclicRedundancyCheck(const char*data,int bytes);
+
+#endif
@@ -241,16 +241,16 @@ void Machine::start(){
 	m_fusionTaskCreator.constructor(m_virtualProcessor,m_outbox,
 		m_outboxAllocator,m_switchMan->getSlaveModePointer(),&m_parameters,&(m_ed->m_EXTENSION_contigs),
 		&(m_ed->m_EXTENSION_identifiers),&(m_fusionData->m_FUSION_eliminated),
-		m_virtualCommunicator);
+		&(m_fusionData->m_FUSION_isolated),m_virtualCommunicator);
 
 	m_joinerTaskCreator.constructor(m_virtualProcessor,m_outbox,
 		m_outboxAllocator,m_switchMan->getSlaveModePointer(),&m_parameters,&(m_ed->m_EXTENSION_contigs),
 		&(m_ed->m_EXTENSION_identifiers),&(m_fusionData->m_FUSION_eliminated),
-		m_virtualCommunicator,&(m_fusionData->m_FINISH_newFusions));
+		&(m_fusionData->m_FUSION_isolated),m_virtualCommunicator,&(m_fusionData->m_FINISH_newFusions));
 
 
 	m_amos.constructor(&m_parameters,m_outboxAllocator,m_outbox,m_fusionData,m_ed,m_switchMan->getMasterModePointer(),m_switchMan->getSlaveModePointer(),&m_scaffolder,
-		m_inbox,m_virtualCommunicator);
+		m_inbox,m_virtualCommunicator,m_virtualProcessor);
 
 	m_mp.setScaffolder(&m_scaffolder);
 	m_mp.setVirtualCommunicator(m_virtualCommunicator);
@@ -405,7 +405,7 @@ void Machine::start(){
 		&m_myReads,m_inbox,m_outbox,m_switchMan->getSlaveModePointer(),m_outboxAllocator);
 
 	m_si.constructor(&m_parameters,m_outboxAllocator,m_inbox,m_outbox,m_virtualCommunicator,
-		m_switchMan->getSlaveModePointer(),&m_myReads);
+		m_switchMan->getSlaveModePointer(),&m_myReads,&m_subgraph);
 
 
 
@@ -26,6 +26,7 @@
 #define __DEFAULT_BUCKETS 262144
 #define __DEFAULT_LOAD_FACTOR_THRESHOLD 0.75 /* Like Java HashMap */
 #define __DEFAULT_BUCKETS_PER_GROUP 64
+#define __MINIMIZERS_PER_RANK 4096 /* possible minimizers for each rank */
 
 #include <core/OperatingSystem.h>
 #include<application_core/common_functions.h>
@@ -100,6 +101,9 @@ Parameters::Parameters(){
 	m_hasCheckpointDirectory=false;
 
 	m_maximumSeedCoverage=getMaximumAllowedCoverage();
+
+	m_minimizerLength=0;
+	m_maximumKmersPerRank=0;
 }
 
 bool Parameters::showExtensionChoice(){
@@ -381,6 +385,12 @@ void Parameters::parseCommands(){
 	set<string> maximumSeedCoverage;
 	maximumSeedCoverage.insert("-use-maximum-seed-coverage");
 
+	set<string> minimizerPartitioning;
+	minimizerPartitioning.insert("-minimizer-partitioning");
+
+	set<string> maximumKmersPerRank;
+	maximumKmersPerRank.insert("-maximum-kmers-per-rank");
+
 	vector<set<string> > toAdd;
 	toAdd.push_back(checkpoints);
 	toAdd.push_back(coloringOneColor);
@@ -411,6 +421,8 @@ void Parameters::parseCommands(){
 	toAdd.push_back(writeKmers);
 	toAdd.push_back(colorSpaceMode);
 	toAdd.push_back(maximumSeedCoverage);
+	toAdd.push_back(minimizerPartitioning);
+	toAdd.push_back(maximumKmersPerRank);
 
 	for(int i=0;i<(int)toAdd.size();i++){
 		for(set<string>::iterator j=toAdd[i].begin();j!=toAdd[i].end();j++){
@@ -600,6 +612,46 @@ void Parameters::parseCommands(){
 			cout<<"[Parameters] changed the maximum seed coverage depth to ";
 			cout<<m_maximumSeedCoverage<<endl;
 
+		}else if(minimizerPartitioning.count(token)>0){
+			i++;
+			int items=m_commands.size()-i;
+
+			if(items<1){
+				if(m_rank==MASTER_RANK){
+					cout<<"Error: "<<token<<" needs 1 item, you provided "<<items<<endl;
+				}
+				m_error=true;
+				return;
+			}
+			token=m_commands[i];
+
+			m_minimizerLength=atoi(token.c_str());
+
+			if(m_rank==MASTER_RANK){
+				cout<<"[Parameters] k-mers are assigned to ranks with minimizers of length ";
+				cout<<m_minimizerLength<<endl;
+			}
+
+		}else if(maximumKmersPerRank.count(token)>0){
+			i++;
+			int items=m_commands.size()-i;
+
+			if(items<1){
+				if(m_rank==MASTER_RANK){
+					cout<<"Error: "<<token<<" needs 1 item, you provided "<<items<<endl;
+				}
+				m_error=true;
+				return;
+			}
+			token=m_commands[i];
+
+			m_maximumKmersPerRank=atol(token.c_str());
+
+			if(m_rank==MASTER_RANK){
+				cout<<"[Parameters] the k-mer academy of each rank is limited to ";
+				cout<<m_maximumKmersPerRank<<" k-mers"<<endl;
+			}
+
 		}else if(pairedReadsCommands.count(token)>0){
 			// make sure there is at least 4 elements left.
 			int items=0;
@@ -922,6 +974,31 @@ void Parameters::parseCommands(){
 	
 	assert((int)m_singleEndReadsFile.size()<=maximumNumberOfFiles);
 
+	// the k-mer length is only known now
+	if(m_minimizerLength!=0 && (m_minimizerLength<1 || m_minimizerLength>=32 || m_minimizerLength>m_wordSize)){
+		if(m_rank==MASTER_RANK){
+			cout<<"Error: the minimizer length must be between 1 and 31, and at most the k-mer length ("<<m_wordSize<<")"<<endl;
+		}
+		m_error=true;
+		return;
+	}
+
+	// with few possible minimizers, some ranks would get many more k-mers
+	if(m_minimizerLength!=0){
+		int shortestMinimizer=1;
+		while((((uint64_t)1)<<(2*shortestMinimizer))<(uint64_t)__MINIMIZERS_PER_RANK*m_size)
+			shortestMinimizer++;
+
+		if(m_minimizerLength<shortestMinimizer){
+			if(m_rank==MASTER_RANK){
+				cout<<"Error: the minimizer length must be at least "<<shortestMinimizer;
+				cout<<" with "<<m_size<<" ranks"<<endl;
+			}
+			m_error=true;
+			return;
+		}
+	}
+
 	LargeCount result=1;
 	for(int p=0;p<m_wordSize;p++){
 		result*=4;
@@ -1409,6 +1486,11 @@ void Parameters::showUsage(){
 	showOptionDescription("See Documentation/BiologicalAbundances.txt");
 	cout<<endl;
 
+	showOption("-write-abundance-tables","Also writes the sequence, contig and taxon abundances in a single columnar binary file.");
+	showOptionDescription("Output file: RayOutput/BiologicalAbundances/AbundanceTables.bin");
+	showOptionDescription("Use scripts/read-abundance-tables.py to convert a table to tsv.");
+	cout<<endl;
+
 	showOption("-one-color-per-file", "Sets one color per file instead of one per sequence.");
 	showOptionDescription("By default, each sequence in each file has a different color.");
 	showOptionDescription("For files with large numbers of sequences, using one single color per file may be more efficient.");
@@ -1505,6 +1587,25 @@ void Parameters::showUsage(){
 
 	cout<<endl;
 
+	showOption("-minimizer-partitioning minimizerLength","Assigns k-mers to ranks with their minimizer instead of their hash value.");
+	showOptionDescription("Consecutive k-mers often share their minimizer, so fewer queries go to other ranks.");
+	showOptionDescription("K-mers whose minimizer is a repeat of 1, 2 or 3 nucleotides are still assigned with their hash value.");
+	showOptionDescription("There is no other protection against minimizers shared by many k-mers: with such repeats,");
+	showOptionDescription("some ranks receive more k-mers than others.");
+	showOptionDescription("The length must give at least 4096 possible minimizers per rank (11 with 512 ranks).");
+	showOptionDescription("A value of 15 is a good start. The default is to not use minimizers.");
+	cout<<endl;
+
+	showOption("-maximum-kmers-per-rank maximumKmers","Limits the number of k-mers counted by each rank.");
+	showOptionDescription("When the limit is reached, k-mers seen only twice are evicted and will be counted again if they are seen.");
+	showOptionDescription("This reduces the memory used by sequencing errors with high-depth samples.");
+	showOptionDescription("The k-mers that remain are copied to a new table during an eviction, so the memory used");
+	showOptionDescription("briefly reaches 1.5 times the limit, and up to twice the limit when an eviction frees less than half of it.");
+	showOptionDescription("In that case, k-mers seen 3 times are also evicted afterwards. If this does not free half of the limit either,");
+	showOptionDescription("the limit is dropped with a warning and the remaining k-mers are all counted.");
+	showOptionDescription("The default is to not limit the number of k-mers.");
+	cout<<endl;
+
 
 /*
 	showOption("-minimumCoverage minimumCoverage","Sets manually the minimum coverage.");
@@ -1801,9 +1902,20 @@ bool Parameters::hasPairedReads(){
 }
 
 int Parameters::_vertexRank(Kmer*a){
+	if(m_minimizerLength>0)
+		return a->minimizerRank(m_size,m_wordSize,m_minimizerLength,m_colorSpaceMode);
+
 	return a->vertexRank(m_size,m_wordSize,m_colorSpaceMode);
 }
 
+int Parameters::getMinimizerLength(){
+	return m_minimizerLength;
+}
+
+LargeCount Parameters::getMaximumKmersPerRank(){
+	return m_maximumKmersPerRank;
+}
+
 string Parameters::getScaffoldFile(){
 	ostringstream a;
 	a<<getPrefix()<<"Scaffolds.fasta";
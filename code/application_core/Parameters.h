@@ -45,6 +45,12 @@ class Parameters{
 
 	CoverageDepth m_maximumSeedCoverage;
 
+	/** 0 if k-mers are assigned to ranks with their hash value **/
+	int m_minimizerLength;
+
+	/** 0 if the k-mer academy has no budget **/
+	LargeCount m_maximumKmersPerRank;
+
 	string m_genomeToTaxonFile;
 	string m_treeFile;
 	string m_taxonNameFile;
@@ -184,6 +190,8 @@ public:
 	Kmer _complementVertex(Kmer*a);
 	bool hasPairedReads();
 	int _vertexRank(Kmer*a);
+	int getMinimizerLength();
+	LargeCount getMaximumKmersPerRank();
 	string getMemoryPrefix();
 	/**
 	* run the profiler
@@ -77,6 +77,22 @@ string convertToString(vector<Kmer>*b,int m_wordSize,bool color){
 	return contig;
 }
 
+string convertToString(ContigPath*b,int m_wordSize,bool color){
+	ostringstream a;
+	#ifdef USE_DISTANT_SEGMENTS_GRAPH
+	for(int p=0;p<m_wordSize;p++){
+		a<<codeToChar(b->at(p).getFirstSegmentFirstCode(m_wordSize));
+	}
+	#else
+	a<<b->at(0).idToWord(m_wordSize,color);
+	#endif
+	for(int j=1;j<b->size();j++){
+		a<<codeToChar(b->getCode(j),color);
+	}
+	string contig=a.str();
+	return contig;
+}
+
 Kmer kmerAtPosition(const char*m_sequence,int pos,int w,char strand,bool color){
 	#ifdef ASSERT
 	assert(w<=MAXKMERLENGTH);
@@ -24,6 +24,7 @@ see <http://www.gnu.org/licenses/>
 
 #include <memory/allocator.h>
 #include <plugin_KmerAcademyBuilder/Kmer.h>
+#include <plugin_SeedExtender/ContigPath.h>
 #include <string>
 #include <application_core/constants.h>
 #include <core/slave_modes.h>
@@ -59,6 +60,11 @@ string addLineBreaks(string sequence,int a);
 
 string convertToString(vector<Kmer>*b,int m_wordSize,bool color);
 
+/*
+ * the sequence of a packed path, without decoding its k-mers
+ */
+string convertToString(ContigPath*b,int m_wordSize,bool color);
+
 Kmer kmerAtPosition(const char*string,int pos,int w,char strand,bool color);
 
 PathHandle getPathUniqueId(int rank,int id);
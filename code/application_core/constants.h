@@ -95,6 +95,14 @@ see <http://www.gnu.org/licenses/>
 #define MAX_VERTICES_TO_VISIT 500
 #define TIP_LIMIT 40
 
+/* fusion and joiner workers query the minimizers of a path before walking all of it,
+ * shorter paths are walked directly */
+#define PATH_SCREENING_WINDOW 16
+#define PATH_SCREENING_MINIMUM_LENGTH 256
+
+/* vertices with more paths than this are repeats and are not used for fusions */
+#define MAXIMUM_PATHS_PER_FUSION_VERTEX 32
+
 /*
  * this is the type used to store coverage values
  *
@@ -31,6 +31,10 @@
 #include <core/slave_modes.h>
 #include <application_core/Parameters.h>
 
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
 __CreatePlugin(Amos);
 
  /**/
@@ -38,12 +42,18 @@ __CreateMasterModeAdapter(Amos,RAY_MASTER_MODE_AMOS); /**/
  /**/
 __CreateSlaveModeAdapter(Amos,RAY_SLAVE_MODE_AMOS); /**/
  /**/
+__CreateMessageTagAdapter(Amos,RAY_MPI_TAG_COUNT_AMOS_CONTIGS); /**/
  /**/
 
+#define AMOS_STEP_COUNT_CONTIGS 0
+#define AMOS_STEP_WAIT_FOR_COUNTS 1
+#define AMOS_STEP_WAIT_FOR_SHARDS 2
+#define AMOS_STEP_WAIT_FOR_COPIES 3
+#define AMOS_STEP_DONE 4
 
 void Amos::constructor(Parameters*parameters,RingAllocator*outboxAllocator,StaticVector*outbox,
 	FusionData*fusionData,ExtensionData*extensionData,int*masterMode,int*slaveMode,Scaffolder*scaffolder,
-	StaticVector*inbox,VirtualCommunicator*virtualCommunicator){
+	StaticVector*inbox,VirtualCommunicator*virtualCommunicator,VirtualProcessor*virtualProcessor){
 	m_virtualCommunicator=virtualCommunicator;
 	m_inbox=inbox;
 	m_slave_mode=slaveMode;
@@ -54,176 +64,269 @@ void Amos::constructor(Parameters*parameters,RingAllocator*outboxAllocator,Stati
 	m_outboxAllocator=outboxAllocator;
 	m_fusionData=fusionData;
 	m_ed=extensionData;
-	m_workerId=0;
+
+	m_shardWritten=false;
+	m_shardBytes=0;
+	m_masterStep=AMOS_STEP_COUNT_CONTIGS;
+	m_ranksDone=0;
+
+	/* for TaskCreator */
+	m_initialized=false;
+	m_virtualProcessor=virtualProcessor;
 }
 
 void Amos::call_RAY_MASTER_MODE_AMOS(){
-	if(!m_ed->m_EXTENSION_currentRankIsStarted){
-		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
-		message[0]=m_ed->m_EXTENSION_currentPosition;
-		Message aMessage(message,1,m_ed->m_EXTENSION_rank,RAY_MPI_TAG_WRITE_AMOS,m_parameters->getRank());
-		m_outbox->push_back(aMessage);
-		m_ed->m_EXTENSION_rank++;
-		m_ed->m_EXTENSION_currentRankIsDone=false;
-		m_ed->m_EXTENSION_currentRankIsStarted=true;
-	}else if(m_ed->m_EXTENSION_currentRankIsDone){
-		if(m_ed->m_EXTENSION_rank<m_parameters->getSize()){
-			m_ed->m_EXTENSION_currentRankIsStarted=false;
-		}else{
-			*m_master_mode=RAY_MASTER_MODE_SCAFFOLDER;
-			m_scaffolder->m_numberOfRanksFinished=0;
+
+	/* ask every rank how many contigs it will write */
+	if(m_masterStep==AMOS_STEP_COUNT_CONTIGS){
+		m_numbersOfContigs.resize(m_parameters->getSize(),0);
+		m_shardSizes.resize(m_parameters->getSize(),0);
+		m_ranksDone=0;
+
+		for(int i=0;i<m_parameters->getSize();i++){
+			Message aMessage(NULL,0,i,RAY_MPI_TAG_COUNT_AMOS_CONTIGS,m_parameters->getRank());
+			m_outbox->push_back(aMessage);
+		}
+
+		m_masterStep=AMOS_STEP_WAIT_FOR_COUNTS;
+		return;
+	}
+
+	for(int i=0;i<(int)m_inbox->size();i++){
+		Message*message=m_inbox->at(i);
+		MessageTag tag=message->getTag();
+		Rank source=message->getSource();
+		MessageUnit*buffer=(MessageUnit*)message->getBuffer();
+
+		if(m_masterStep==AMOS_STEP_WAIT_FOR_COUNTS && tag==RAY_MPI_TAG_COUNT_AMOS_CONTIGS_REPLY){
+			m_numbersOfContigs[source]=buffer[0];
+			m_ranksDone++;
+		}else if(m_masterStep==AMOS_STEP_WAIT_FOR_SHARDS && tag==RAY_MPI_TAG_WRITE_AMOS_REPLY){
+			m_shardSizes[source]=buffer[0];
+			m_ranksDone++;
+		}else if(m_masterStep==AMOS_STEP_WAIT_FOR_COPIES && tag==RAY_MPI_TAG_AMOS_SHARD_OFFSET_REPLY){
+			m_ranksDone++;
 		}
 	}
+
+	if(m_ranksDone<m_parameters->getSize())
+		return;
+
+	m_ranksDone=0;
+
+	/* the identifiers of a rank follow those of the previous rank */
+	if(m_masterStep==AMOS_STEP_WAIT_FOR_COUNTS){
+		LargeCount position=0;
+
+		for(int i=0;i<m_parameters->getSize();i++){
+			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+			message[0]=position;
+			Message aMessage(message,1,i,RAY_MPI_TAG_WRITE_AMOS,m_parameters->getRank());
+			m_outbox->push_back(aMessage);
+
+			position+=m_numbersOfContigs[i];
+		}
+
+		cout<<"Rank "<<m_parameters->getRank()<<" asked "<<m_parameters->getSize()<<" ranks to export "<<position<<" contigs in AMOS format"<<endl;
+
+		m_masterStep=AMOS_STEP_WAIT_FOR_SHARDS;
+
+	/* give each rank its region of the file, ranks are in order in the file */
+	}else if(m_masterStep==AMOS_STEP_WAIT_FOR_SHARDS){
+
+		/* the reads are already in the file */
+		ofstream fp(m_parameters->getAmosFile().c_str(),ios_base::out|ios_base::app);
+		fp.seekp(0,ios_base::end);
+		LargeCount offset=fp.tellp();
+		fp.close();
+
+		for(int i=0;i<m_parameters->getSize();i++){
+			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+			message[0]=offset;
+			Message aMessage(message,1,i,RAY_MPI_TAG_AMOS_SHARD_OFFSET,m_parameters->getRank());
+			m_outbox->push_back(aMessage);
+
+			offset+=m_shardSizes[i];
+		}
+
+		m_masterStep=AMOS_STEP_WAIT_FOR_COPIES;
+
+	}else if(m_masterStep==AMOS_STEP_WAIT_FOR_COPIES){
+		m_masterStep=AMOS_STEP_DONE;
+
+		*m_master_mode=RAY_MASTER_MODE_SCAFFOLDER;
+		m_scaffolder->m_numberOfRanksFinished=0;
+	}
+}
+
+void Amos::call_RAY_MPI_TAG_COUNT_AMOS_CONTIGS(Message*message){
+	LargeCount count=0;
+
+	for(int i=0;i<(int)m_ed->m_EXTENSION_contigs.size();i++){
+		if(m_fusionData->m_FUSION_eliminated.count(m_ed->m_EXTENSION_identifiers[i])==0)
+			count++;
+	}
+
+	MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+	buffer[0]=count;
+	Message aMessage(buffer,1,message->getSource(),RAY_MPI_TAG_COUNT_AMOS_CONTIGS_REPLY,m_parameters->getRank());
+	m_outbox->push_back(aMessage);
 }
 
 void Amos::call_RAY_SLAVE_MODE_AMOS(){
-	if(!m_ed->m_EXTENSION_initiated){
-		cout<<"Rank "<<m_parameters->getRank()<<" is appending positions to "<<m_parameters->getAmosFile()<<endl;
-		m_amosFile=fopen(m_parameters->getAmosFile().c_str(),"a+");
-		m_contigId=0;
-		m_mode_send_vertices_sequence_id_position=0;
-		m_ed->m_EXTENSION_initiated=true;
-		m_ed->m_EXTENSION_reads_requested=false;
-		m_sequence_id=0;
+
+	/* the master replies with the offset of this rank in the AMOS file */
+	if(m_shardWritten){
+		if(m_inbox->size()>0 && m_inbox->at(0)->getTag()==RAY_MPI_TAG_AMOS_SHARD_OFFSET){
+			MessageUnit*buffer=(MessageUnit*)m_inbox->at(0)->getBuffer();
+
+			copyShard(buffer[0]);
+
+			m_shardWritten=false;
+
+			Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_AMOS_SHARD_OFFSET_REPLY,m_parameters->getRank());
+			m_outbox->push_back(aMessage);
+
+			*m_slave_mode=RAY_SLAVE_MODE_DO_NOTHING;
+		}
+
+		return;
 	}
 
-	m_virtualCommunicator->forceFlush();
-	m_virtualCommunicator->processInbox(&m_activeWorkers);
-	m_activeWorkers.clear();
-
-
-	/*
-	* use m_allPaths and m_identifiers
-	*
-	* iterators: m_SEEDING_i: for the current contig
-	*            m_mode_send_vertices_sequence_id_position: for the current position in the current contig.
-	*/
-
-	if(m_contigId==(int)m_ed->m_EXTENSION_contigs.size()){// all contigs are processed
-		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
-		message[0]=m_ed->m_EXTENSION_currentPosition;
-		Message aMessage(message,1,MASTER_RANK,RAY_MPI_TAG_WRITE_AMOS_REPLY,m_parameters->getRank());
-		m_outbox->push_back(aMessage);
-		fclose(m_amosFile);
-		*m_slave_mode=RAY_SLAVE_MODE_DO_NOTHING;
-	// iterate over the next one
-	}else if(m_fusionData->m_FUSION_eliminated.count(m_ed->m_EXTENSION_identifiers[m_contigId])>0){
-		m_contigId++;
-		m_mode_send_vertices_sequence_id_position=0;
-		m_ed->m_EXTENSION_reads_requested=false;
-	}else if(m_mode_send_vertices_sequence_id_position==(int)m_ed->m_EXTENSION_contigs[m_contigId].size()){
+	mainLoop();
+}
+
+string Amos::getShardFile(){
+	ostringstream file;
+	file<<m_parameters->getAmosFile()<<"."<<m_parameters->getRank();
+	return file.str();
+}
+
+void Amos::initializeMethod(){
+	cout<<"Rank "<<m_parameters->getRank()<<" is writing its contigs to "<<getShardFile()<<endl;
+
+	m_shardFile.open(getShardFile().c_str(),ios_base::out|ios_base::binary|ios_base::trunc);
+	m_shardBytes=0;
+
+	m_contigId=0;
+
+	/* set by the master with RAY_MPI_TAG_WRITE_AMOS */
+	m_firstIdentifier=m_ed->m_EXTENSION_currentPosition;
+
+	m_recordOffsets.clear();
+	m_recordLengths.clear();
+	m_writtenRecords=0;
+}
+
+bool Amos::hasUnassignedTask(){
+	while(m_contigId<(int)m_ed->m_EXTENSION_contigs.size()
+		&& m_fusionData->m_FUSION_eliminated.count(m_ed->m_EXTENSION_identifiers[m_contigId])>0){
 		m_contigId++;
-		m_mode_send_vertices_sequence_id_position=0;
-		m_ed->m_EXTENSION_reads_requested=false;
-		
-		fprintf(m_amosFile,"}\n");
-	}else{
-		if(!m_ed->m_EXTENSION_reads_requested){
-			if(m_mode_send_vertices_sequence_id_position==0){
-				string seq=convertToString(&(m_ed->m_EXTENSION_contigs[m_contigId]),m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
-				char*qlt=(char*)__Malloc(seq.length()+1,"RAY_MASTER_MODE_AMOS",m_parameters->showMemoryAllocations());
-				strcpy(qlt,seq.c_str());
-				for(int i=0;i<(int)strlen(qlt);i++){
-					qlt[i]='D';
-				}
-				m_sequence_id++;
-	
-				#if defined(RAY_64_BITS)
-					fprintf(m_amosFile,"{CTG\niid:%u\neid:contig-%lu\ncom:\nSoftware: Ray, MPI rank: %i\n.\nseq:\n%s\n.\nqlt:\n%s\n.\n",
-					m_ed->m_EXTENSION_currentPosition+1,
-					m_ed->m_EXTENSION_identifiers[m_contigId],
-					m_parameters->getRank(),
-					seq.c_str(),
-					qlt
-					);
-				#elif defined(RAY_32_BITS)
-					fprintf(m_amosFile,"{CTG\niid:%u\neid:contig-%llu\ncom:\nSoftware: Ray, MPI rank: %i\n.\nseq:\n%s\n.\nqlt:\n%s\n.\n",
-					m_ed->m_EXTENSION_currentPosition+1,
-					m_ed->m_EXTENSION_identifiers[m_contigId],
-					m_parameters->getRank(),
-					seq.c_str(),
-					qlt
-					);
-				#endif
-
-				m_ed->m_EXTENSION_currentPosition++;
-				__Free(qlt,"RAY_MALLOC_TYPE_AMOS",m_parameters->showMemoryAllocations());
-			}
-
-			if(m_mode_send_vertices_sequence_id_position%10000==0){
-				cout<<"Rank "<<m_parameters->getRank()<<" Exporting AMOS ["<<m_contigId<<"/"<<m_ed->m_EXTENSION_contigs.size()<<"] [";
-				cout<<m_mode_send_vertices_sequence_id_position<<"/"<<m_ed->m_EXTENSION_contigs[m_contigId].size()<<"]"<<endl;
-			}
-
-			m_ed->m_EXTENSION_reads_requested=true;
-			m_ed->m_EXTENSION_reads_received=false;
-			Kmer vertex=m_ed->m_EXTENSION_contigs[m_contigId][m_mode_send_vertices_sequence_id_position];
-
-			m_readFetcher.constructor(&vertex,m_outboxAllocator,m_inbox,m_outbox,m_parameters,m_virtualCommunicator,m_workerId,
- RAY_MPI_TAG_REQUEST_VERTEX_READS);
-
-			// iterator on reads
-			m_fusionData->m_FUSION_path_id=0;
-			m_ed->m_EXTENSION_readLength_requested=false;
-		}else if(m_ed->m_EXTENSION_reads_requested && !m_ed->m_EXTENSION_reads_received){
-			if(!m_readFetcher.isDone()){
-				m_readFetcher.work();
-			}else{
-				m_ed->m_EXTENSION_reads_received=true;
-				m_ed->m_EXTENSION_receivedReads=*(m_readFetcher.getResult());
-			}
-		}else if(m_ed->m_EXTENSION_reads_received){
-			if(m_fusionData->m_FUSION_path_id<(int)m_ed->m_EXTENSION_receivedReads.size()){
-				Rank readRank=m_ed->m_EXTENSION_receivedReads[m_fusionData->m_FUSION_path_id].getRank();
-				Strand strand=m_ed->m_EXTENSION_receivedReads[m_fusionData->m_FUSION_path_id].getStrand();
-				int idOnRank=m_ed->m_EXTENSION_receivedReads[m_fusionData->m_FUSION_path_id].getReadIndex();
-				if(!m_ed->m_EXTENSION_readLength_requested){
-					m_ed->m_EXTENSION_readLength_requested=true;
-					m_ed->m_EXTENSION_readLength_received=false;
-					MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
-					message[0]=idOnRank;
-					Message aMessage(message,1,readRank,RAY_MPI_TAG_ASK_READ_LENGTH,m_parameters->getRank());
-					m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
-				}else if(m_virtualCommunicator->isMessageProcessed(m_workerId)){
-					vector<MessageUnit> result;
-					m_virtualCommunicator->getMessageResponseElements(m_workerId,&result);
-					int readLength=result[0];
-					int forwardOffset=result[1];
-					int reverseOffset=result[2];
-					ReadHandle globalIdentifier=m_parameters->getGlobalIdFromRankAndLocalId(readRank,idOnRank)+1;
-					int start=forwardOffset;
-					int theEnd=readLength-1;
-					int offset=m_mode_send_vertices_sequence_id_position;
-					if(strand=='R'){
-						start=0;
-						theEnd=theEnd-reverseOffset;
-						int t=start;
-						start=theEnd;
-						theEnd=t;
-						offset++;
-					}
-	
-					#if defined(RAY_64_BITS)
-						fprintf(m_amosFile,"{TLE\nsrc:%li\noff:%i\nclr:%i,%i\n}\n",globalIdentifier,offset,
-						start,theEnd);
-					#elif defined(RAY_32_BITS)
-						fprintf(m_amosFile,"{TLE\nsrc:%lli\noff:%i\nclr:%i,%i\n}\n",globalIdentifier,offset,
-						start,theEnd);
-					#endif
-
-					// increment to get the next read.
-					m_fusionData->m_FUSION_path_id++;
-					m_ed->m_EXTENSION_readLength_requested=false;
-				}
-			}else{
-				// continue.
-				m_mode_send_vertices_sequence_id_position++;
-				m_ed->m_EXTENSION_reads_requested=false;
-			}
-		}
+	}
 
+	return m_contigId<(int)m_ed->m_EXTENSION_contigs.size();
+}
+
+Worker*Amos::assignNextTask(){
+	AmosWorker*worker=new AmosWorker;
+
+	worker->constructor(m_contigId,&(m_ed->m_EXTENSION_contigs[m_contigId]),m_ed->m_EXTENSION_identifiers[m_contigId],
+		m_ed->m_EXTENSION_currentPosition+1,m_virtualCommunicator,m_outboxAllocator,m_parameters,m_inbox,m_outbox,
+		RAY_MPI_TAG_REQUEST_VERTEX_READS,RAY_MPI_TAG_ASK_READ_LENGTH);
+
+	m_ed->m_EXTENSION_currentPosition++;
+	m_contigId++;
+
+	return worker;
+}
+
+void Amos::processWorkerResult(Worker*worker){
+	AmosWorker*amosWorker=(AmosWorker*)worker;
+
+	/* records are written when they are done, copyShard puts them in order */
+	int record=amosWorker->getInternalIdentifier()-m_firstIdentifier-1;
+
+	#ifdef ASSERT
+	assert(record>=0);
+	#endif
+
+	if(record>=(int)m_recordOffsets.size()){
+		m_recordOffsets.resize(record+1,0);
+		m_recordLengths.resize(record+1,0);
 	}
 
+	string text=amosWorker->getRecord();
+
+	m_recordOffsets[record]=m_shardBytes;
+	m_recordLengths[record]=text.length();
+
+	m_shardFile.write(text.c_str(),text.length());
+	m_shardBytes+=text.length();
+	m_writtenRecords++;
+
+	if(m_completedJobs%1000==0){
+		cout<<"Rank "<<m_parameters->getRank()<<" Exporting AMOS ["<<m_writtenRecords;
+		cout<<"/"<<m_ed->m_EXTENSION_contigs.size()<<"]"<<endl;
+	}
+}
+
+void Amos::destroyWorker(Worker*worker){
+	delete worker;
+}
+
+void Amos::finalizeMethod(){
+	#ifdef ASSERT
+	assert(m_writtenRecords==(int)m_recordOffsets.size());
+	#endif
+
+	m_shardFile.close();
+
+	cout<<"Rank "<<m_parameters->getRank()<<" wrote "<<m_writtenRecords<<" contigs, "<<m_shardBytes<<" bytes"<<endl;
+
+	m_shardWritten=true;
+
+	MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+	message[0]=m_shardBytes;
+	Message aMessage(message,1,MASTER_RANK,RAY_MPI_TAG_WRITE_AMOS_REPLY,m_parameters->getRank());
+	m_outbox->push_back(aMessage);
+}
+
+/** the master created the file, every rank writes in its own region */
+void Amos::copyShard(LargeCount offset){
+	cout<<"Rank "<<m_parameters->getRank()<<" is appending positions to "<<m_parameters->getAmosFile()<<" at offset "<<offset<<endl;
+
+	ifstream input(getShardFile().c_str(),ios_base::in|ios_base::binary);
+
+	fstream output;
+	output.open(m_parameters->getAmosFile().c_str(),ios_base::in|ios_base::out|ios_base::binary);
+	output.seekp(offset);
+
+	vector<char> buffer(CONFIG_FILE_IO_BUFFER_SIZE);
+
+	/* records are copied in the order of the contigs */
+	for(int record=0;record<(int)m_recordOffsets.size();record++){
+		LargeCount left=m_recordLengths[record];
+		input.seekg(m_recordOffsets[record]);
+
+		while(left>0 && input.good()){
+			LargeCount bytes=buffer.size();
+			if(left<bytes)
+				bytes=left;
+
+			input.read(&(buffer[0]),bytes);
+			output.write(&(buffer[0]),input.gcount());
+			left-=input.gcount();
+		}
+	}
+
+	#ifdef ASSERT
+	assert((LargeCount)output.tellp()==offset+m_shardBytes);
+	#endif
+
+	output.close();
+	input.close();
+
+	remove(getShardFile().c_str());
 }
 
 void Amos::registerPlugin(ComputeCore*core){
@@ -242,6 +345,19 @@ void Amos::registerPlugin(ComputeCore*core){
 	RAY_MASTER_MODE_AMOS=core->allocateMasterModeHandle(plugin);
 	core->setMasterModeObjectHandler(plugin,RAY_MASTER_MODE_AMOS, __GetAdapter(Amos,RAY_MASTER_MODE_AMOS));
 	core->setMasterModeSymbol(plugin,RAY_MASTER_MODE_AMOS,"RAY_MASTER_MODE_AMOS");
+
+	RAY_MPI_TAG_COUNT_AMOS_CONTIGS=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_COUNT_AMOS_CONTIGS, __GetAdapter(Amos,RAY_MPI_TAG_COUNT_AMOS_CONTIGS));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_COUNT_AMOS_CONTIGS,"RAY_MPI_TAG_COUNT_AMOS_CONTIGS");
+
+	RAY_MPI_TAG_COUNT_AMOS_CONTIGS_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_COUNT_AMOS_CONTIGS_REPLY,"RAY_MPI_TAG_COUNT_AMOS_CONTIGS_REPLY");
+
+	RAY_MPI_TAG_AMOS_SHARD_OFFSET=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_AMOS_SHARD_OFFSET,"RAY_MPI_TAG_AMOS_SHARD_OFFSET");
+
+	RAY_MPI_TAG_AMOS_SHARD_OFFSET_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_AMOS_SHARD_OFFSET_REPLY,"RAY_MPI_TAG_AMOS_SHARD_OFFSET_REPLY");
 }
 
 void Amos::resolveSymbols(ComputeCore*core){
@@ -255,6 +371,10 @@ void Amos::resolveSymbols(ComputeCore*core){
 	RAY_MPI_TAG_WRITE_AMOS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_WRITE_AMOS");
 	RAY_MPI_TAG_WRITE_AMOS_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_WRITE_AMOS_REPLY");
 	RAY_MPI_TAG_REQUEST_VERTEX_READS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_READS");
+	RAY_MPI_TAG_COUNT_AMOS_CONTIGS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_COUNT_AMOS_CONTIGS");
+	RAY_MPI_TAG_COUNT_AMOS_CONTIGS_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_COUNT_AMOS_CONTIGS_REPLY");
+	RAY_MPI_TAG_AMOS_SHARD_OFFSET=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_AMOS_SHARD_OFFSET");
+	RAY_MPI_TAG_AMOS_SHARD_OFFSET_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_AMOS_SHARD_OFFSET_REPLY");
 
 	__BindPlugin(Amos);
 }
@@ -27,28 +27,43 @@
 #include <plugin_FusionData/FusionData.h>
 #include <plugin_SeedExtender/ExtensionData.h>
 #include <plugin_Scaffolder/Scaffolder.h>
-#include <plugin_SeedExtender/ReadFetcher.h>
+#include <plugin_Amos/AmosWorker.h>
 #include <communication/VirtualCommunicator.h>
+#include <scheduling/TaskCreator.h>
 #include <core/ComputeCore.h>
 
 #include <stdio.h>
 #include <stdint.h>
 #include <vector>
+#include <map>
+#include <string>
+#include <fstream>
 using namespace std;
 
 
-
 /**
  * AMOS specification is available : http://sourceforge.net/apps/mediawiki/amos/index.php?title=AMOS
  * \see http://sourceforge.net/apps/mediawiki/amos/index.php?title=Message_Types
+ *
+ * All the ranks write their contigs at the same time.
+ * The master first collects the number of contigs of each rank
+ * to give internal identifiers, then each rank writes its records in a file of its own
+ * with one AmosWorker per contig. Records are written as soon as they are done, so
+ * they are not in order in this file. Finally, each rank copies its records in AMOS.afg,
+ * in the order of the contigs, at the offset given by the master.
+ *
  * \author Sébastien Boisvert
  */
-class Amos :  public CorePlugin{
+class Amos : public TaskCreator, public CorePlugin{
 
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS;
 	MessageTag RAY_MPI_TAG_ASK_READ_LENGTH;
 	MessageTag RAY_MPI_TAG_WRITE_AMOS;
 	MessageTag RAY_MPI_TAG_WRITE_AMOS_REPLY;
+	MessageTag RAY_MPI_TAG_COUNT_AMOS_CONTIGS;
+	MessageTag RAY_MPI_TAG_COUNT_AMOS_CONTIGS_REPLY;
+	MessageTag RAY_MPI_TAG_AMOS_SHARD_OFFSET;
+	MessageTag RAY_MPI_TAG_AMOS_SHARD_OFFSET_REPLY;
 
 	MasterMode RAY_MASTER_MODE_AMOS;
 	MasterMode RAY_MASTER_MODE_SCAFFOLDER;
@@ -59,27 +74,52 @@ class Amos :  public CorePlugin{
 
 	VirtualCommunicator*m_virtualCommunicator;
 	StaticVector*m_inbox;
-	WorkerHandle m_workerId;
-	ReadFetcher m_readFetcher;
 	int*m_master_mode;
 	int*m_slave_mode;
 	Scaffolder*m_scaffolder;
 	FusionData*m_fusionData;
-	FILE*m_amosFile;
 	Parameters*m_parameters;
 	RingAllocator*m_outboxAllocator;
 	StaticVector*m_outbox;
-	int m_contigId;
-	int m_sequence_id;
 	ExtensionData*m_ed;
-	int m_mode_send_vertices_sequence_id_position;
-	vector<WorkerHandle> m_activeWorkers;
+
+/** the file of this rank, copied in AMOS.afg at the end **/
+	ofstream m_shardFile;
+	LargeCount m_shardBytes;
+	bool m_shardWritten;
+
+	int m_contigId;
+	int m_firstIdentifier;
+
+/** where each record is in the file of this rank, by internal identifier **/
+	vector<LargeCount> m_recordOffsets;
+	vector<LargeCount> m_recordLengths;
+	int m_writtenRecords;
+
+/** master state **/
+	int m_masterStep;
+	int m_ranksDone;
+	vector<LargeCount> m_numbersOfContigs;
+	vector<LargeCount> m_shardSizes;
+
+	string getShardFile();
+	void copyShard(LargeCount offset);
+
 public:
 	void call_RAY_MASTER_MODE_AMOS();
 	void call_RAY_SLAVE_MODE_AMOS();
+	void call_RAY_MPI_TAG_COUNT_AMOS_CONTIGS(Message*message);
+
 	void constructor(Parameters*parameters,RingAllocator*outboxAllocator,StaticVector*outbox,
 		FusionData*fusionData,ExtensionData*extensionData,int*masterMode,int*slaveMode,Scaffolder*scaffolder,
-StaticVector*inbox,VirtualCommunicator*virtualCommunicator);
+StaticVector*inbox,VirtualCommunicator*virtualCommunicator,VirtualProcessor*virtualProcessor);
+
+	virtual void initializeMethod();
+	virtual void finalizeMethod();
+	virtual bool hasUnassignedTask();
+	virtual Worker* assignNextTask();
+	virtual void processWorkerResult(Worker*);
+	virtual void destroyWorker(Worker*);
 
 	void registerPlugin(ComputeCore*core);
 	void resolveSymbols(ComputeCore*core);
@@ -0,0 +1,175 @@
+/*
+ 	Ray
+    Copyright (C) 2011  Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#include <plugin_Amos/AmosWorker.h>
+#include <application_core/common_functions.h>
+
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
+void AmosWorker::constructor(WorkerHandle workerId,ContigPath*contig,PathHandle identifier,int internalIdentifier,
+		VirtualCommunicator*virtualCommunicator,RingAllocator*outboxAllocator,Parameters*parameters,
+		StaticVector*inbox,StaticVector*outbox,
+		MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS,MessageTag RAY_MPI_TAG_ASK_READ_LENGTH){
+
+	this->RAY_MPI_TAG_REQUEST_VERTEX_READS=RAY_MPI_TAG_REQUEST_VERTEX_READS;
+	this->RAY_MPI_TAG_ASK_READ_LENGTH=RAY_MPI_TAG_ASK_READ_LENGTH;
+
+	m_workerId=workerId;
+	m_contig=contig;
+	m_identifier=identifier;
+	m_internalIdentifier=internalIdentifier;
+
+	m_virtualCommunicator=virtualCommunicator;
+	m_outboxAllocator=outboxAllocator;
+	m_parameters=parameters;
+	m_inbox=inbox;
+	m_outbox=outbox;
+
+	m_isDone=false;
+	m_position=0;
+	m_readsRequested=false;
+	m_readsReceived=false;
+	m_readLengthRequested=false;
+	m_readIndex=0;
+
+	writeContig();
+}
+
+void AmosWorker::writeContig(){
+	string sequence=convertToString(m_contig,m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+	string quality(sequence.length(),'D');
+
+	m_record<<"{CTG"<<endl;
+	m_record<<"iid:"<<m_internalIdentifier<<endl;
+	m_record<<"eid:contig-"<<m_identifier<<endl;
+	m_record<<"com:"<<endl;
+	m_record<<"Software: Ray, MPI rank: "<<m_parameters->getRank()<<endl;
+	m_record<<"."<<endl;
+	m_record<<"seq:"<<endl<<sequence<<endl<<"."<<endl;
+	m_record<<"qlt:"<<endl<<quality<<endl<<"."<<endl;
+}
+
+/** the read is placed on the contig with its clear range **/
+void AmosWorker::writeRead(int readLength,int forwardOffset,int reverseOffset){
+	ReadAnnotation*read=&(m_reads[m_readIndex]);
+
+	Rank readRank=read->getRank();
+	Strand strand=read->getStrand();
+	int idOnRank=read->getReadIndex();
+
+	ReadHandle globalIdentifier=m_parameters->getGlobalIdFromRankAndLocalId(readRank,idOnRank)+1;
+
+	int start=forwardOffset;
+	int theEnd=readLength-1;
+	int offset=m_position;
+
+	if(strand=='R'){
+		start=0;
+		theEnd=theEnd-reverseOffset;
+		int t=start;
+		start=theEnd;
+		theEnd=t;
+		offset++;
+	}
+
+	m_record<<"{TLE"<<endl;
+	m_record<<"src:"<<globalIdentifier<<endl;
+	m_record<<"off:"<<offset<<endl;
+	m_record<<"clr:"<<start<<","<<theEnd<<endl;
+	m_record<<"}"<<endl;
+}
+
+void AmosWorker::work(){
+
+	if(m_isDone)
+		return;
+
+	if(m_position==(int)m_contig->size()){
+		m_record<<"}"<<endl;
+		m_isDone=true;
+
+	}else if(!m_readsRequested){
+		Kmer vertex=m_contig->at(m_position);
+
+		m_readFetcher.constructor(&vertex,m_outboxAllocator,m_inbox,m_outbox,m_parameters,m_virtualCommunicator,m_workerId,
+			RAY_MPI_TAG_REQUEST_VERTEX_READS);
+
+		m_readsRequested=true;
+		m_readsReceived=false;
+
+	}else if(!m_readsReceived){
+		if(!m_readFetcher.isDone()){
+			m_readFetcher.work();
+		}else{
+			m_reads=*(m_readFetcher.getResult());
+			m_readsReceived=true;
+			m_readIndex=0;
+			m_readLengthRequested=false;
+		}
+
+	}else if(m_readIndex<(int)m_reads.size()){
+		if(!m_readLengthRequested){
+			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+			message[0]=m_reads[m_readIndex].getReadIndex();
+
+			Message aMessage(message,1,m_reads[m_readIndex].getRank(),RAY_MPI_TAG_ASK_READ_LENGTH,m_parameters->getRank());
+			m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
+
+			m_readLengthRequested=true;
+
+		}else if(m_virtualCommunicator->isMessageProcessed(m_workerId)){
+			vector<MessageUnit> result;
+			m_virtualCommunicator->getMessageResponseElements(m_workerId,&result);
+
+			#ifdef ASSERT
+			assert(result.size()>=3);
+			#endif
+
+			writeRead(result[0],result[1],result[2]);
+
+			// increment to get the next read.
+			m_readIndex++;
+			m_readLengthRequested=false;
+		}
+	}else{
+		// continue.
+		m_position++;
+		m_readsRequested=false;
+	}
+}
+
+bool AmosWorker::isDone(){
+	return m_isDone;
+}
+
+WorkerHandle AmosWorker::getWorkerIdentifier(){
+	return m_workerId;
+}
+
+int AmosWorker::getInternalIdentifier(){
+	return m_internalIdentifier;
+}
+
+string AmosWorker::getRecord(){
+	return m_record.str();
+}
@@ -0,0 +1,101 @@
+/*
+ 	Ray
+    Copyright (C) 2011, 2012  Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+
+#ifndef _AmosWorker_H
+#define _AmosWorker_H
+
+#include <application_core/Parameters.h>
+#include <structures/StaticVector.h>
+#include <memory/RingAllocator.h>
+#include <plugin_SeedExtender/ReadFetcher.h>
+#include <plugin_SequencesIndexer/ReadAnnotation.h>
+#include <communication/VirtualCommunicator.h>
+#include <scheduling/Worker.h>
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+#include <sstream>
+using namespace std;
+
+/**
+ * An AmosWorker writes the AMOS record of a contig:
+ * the sequence and the layout of its reads.
+ *
+ * The record is kept in memory until the worker is done.
+ *
+ * \author Sébastien Boisvert
+ */
+class AmosWorker : public Worker {
+
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS;
+	MessageTag RAY_MPI_TAG_ASK_READ_LENGTH;
+
+	WorkerHandle m_workerId;
+	bool m_isDone;
+
+	ContigPath*m_contig;
+	PathHandle m_identifier;
+	int m_internalIdentifier;
+
+	int m_position;
+	bool m_readsRequested;
+	bool m_readsReceived;
+	ReadFetcher m_readFetcher;
+	vector<ReadAnnotation> m_reads;
+	int m_readIndex;
+	bool m_readLengthRequested;
+
+	ostringstream m_record;
+
+	Parameters*m_parameters;
+	StaticVector*m_inbox;
+	StaticVector*m_outbox;
+	RingAllocator*m_outboxAllocator;
+	VirtualCommunicator*m_virtualCommunicator;
+
+	void writeContig();
+	void writeRead(int readLength,int forwardOffset,int reverseOffset);
+
+public:
+	void constructor(WorkerHandle workerId,ContigPath*contig,PathHandle identifier,int internalIdentifier,
+		VirtualCommunicator*virtualCommunicator,RingAllocator*outboxAllocator,Parameters*parameters,
+		StaticVector*inbox,StaticVector*outbox,
+		MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS,MessageTag RAY_MPI_TAG_ASK_READ_LENGTH);
+
+	/** work a little bit 
+	 * the class Worker provides no implementation for that 
+	*/
+	void work();
+
+	/** is the worker done doing its things */
+	bool isDone();
+
+	/** get the worker number */
+	WorkerHandle getWorkerIdentifier();
+
+	int getInternalIdentifier();
+
+	/** the complete CTG record */
+	string getRecord();
+};
+
+#endif
@@ -23,8 +23,10 @@
 #include <iostream>
 #include <fstream>
 #include <map>
+#include <algorithm>
 #ifdef ASSERT
 #include <assert.h>
+#include <math.h>
 #endif
 using namespace std;
 
@@ -39,70 +41,161 @@ CoverageDistribution::CoverageDistribution(map<CoverageDepth,LargeCount>*distrib
 		f.close();
 	}
 	
-	vector<CoverageDepth> x;
-	vector<LargeCount> y;
+	// coverage values above CONFIG_MAXIMUM_COVERAGE share the last bin
+	int bins=1;
+	if(distributionOfCoverage->size()>0)
+		bins=min((int)distributionOfCoverage->rbegin()->first,CONFIG_MAXIMUM_COVERAGE)+1;
+
+	vector<LargeCount> counts(bins,0);
 	for(map<CoverageDepth,LargeCount>::iterator i=distributionOfCoverage->begin();i!=distributionOfCoverage->end();i++){
-		x.push_back(i->first);
-		y.push_back(i->second);
+		counts[min((int)i->first,bins-1)]+=i->second;
 	}
 
-	int windowSize=10;
-	CoverageDepth minimumX=1;
-	LargeCount minimumY=2*4096;
-	LargeCount minimumY2=55000;
-	CoverageDepth maximumX=65535-1;
-	CoverageDepth safeThreshold=256;
-
-	/** get the votes to find the peak */
-	map<int,int> votes;
-	for(int i=0;i<(int)x.size();i++){
-		int largestPosition=i;
-		for(int j=0;j<windowSize;j++){
-			int position=i+j;
-			if(position >= (int)x.size())
-				break;
-			if(y.at(position) > y.at(largestPosition))
-				largestPosition=position;
+	m_minimumCoverage=1;
+	m_peakCoverage=1;
+
+	/** an empty distribution has no error component and no peak */
+	if(bins>=3)
+		findPeak(&counts);
+
+	m_repeatCoverage=2*m_peakCoverage;
+	int diff=m_peakCoverage-m_minimumCoverage;
+	int candidate=m_peakCoverage+diff;
+
+	if(candidate<m_repeatCoverage)
+		m_repeatCoverage=candidate;
+
+	fitModel(&counts);
+}
+
+/**
+ * The peak is the point that rises the most above the lowest point
+ * before it, so it always follows a real local minimum and a bin of the
+ * error component can not be taken for the peak.
+ */
+void CoverageDistribution::findPeak(vector<LargeCount>*counts){
+	int bins=counts->size();
+
+	vector<double> smoothed;
+	smoothData(counts,&smoothed);
+
+	/** k-mers are counted from 2 because of the Bloom filter,
+	 * so the error component starts at the first observed value */
+	int first=1;
+	while(first<bins && (*counts)[first]==0)
+		first++;
+
+	if(first==bins)
+		return;
+
+	int valley=first;
+	int trough=first;
+	int peak=first;
+	double largestRise=0;
+
+	for(int i=first+1;i<bins;i++){
+		if(smoothed[i]<smoothed[valley])
+			valley=i;
+
+		double rise=smoothed[i]-smoothed[valley];
+
+		if(rise>largestRise){
+			largestRise=rise;
+			peak=i;
+			trough=valley;
 		}
-	
-		if(x[largestPosition]>maximumX)
-			continue;
+	}
 
-		if(x[largestPosition]<minimumX)
-			continue;
-	
-		if(x[largestPosition] >= safeThreshold && y[largestPosition] < minimumY2)
-			continue;
-		
-		if(y.at(largestPosition)>minimumY)
-			votes[largestPosition]++;
+	/** small rises are noise on the tail of the error component,
+	 * the distribution only decreases: the peak is hidden in the
+	 * errors and shows up where the descent first flattens */
+	if(largestRise*COVERAGE_DISTRIBUTION_MINIMUM_RISE<=smoothed[trough]){
+		peak=first;
+
+		int shoulder=first+1;
+		while(shoulder+1<bins && smoothed[shoulder+1]>=COVERAGE_DISTRIBUTION_SHOULDER_KMERS
+			&& smoothed[shoulder+1]<COVERAGE_DISTRIBUTION_SHOULDER_RATIO*smoothed[shoulder])
+			shoulder++;
+
+		if(shoulder+1<bins && smoothed[shoulder+1]>=COVERAGE_DISTRIBUTION_SHOULDER_KMERS){
+			/** climb to the flattest point of the shoulder */
+			while(shoulder+2<bins && smoothed[shoulder+2]*smoothed[shoulder]>=smoothed[shoulder+1]*smoothed[shoulder+1])
+				shoulder++;
+
+			peak=shoulder;
+		}
 	}
 
-	/** check votes */
-	int largestPosition=votes.begin()->first;
-	for(map<int,int>::iterator i=votes.begin();i!=votes.end();i++){
-		if((i->second > votes[largestPosition] || y[i->first] > y[largestPosition]))
-			largestPosition=i->first;
-		//cout<<"x: "<<x[i->first]<<" votes: "<<i->second<<" y: "<<y[i->first]<<endl;
+	/** the minimum is the lowest observed value before the peak */
+	int minimum=peak;
+	for(int i=peak;i>=first;i--){
+		if((*counts)[i]>0 && (*counts)[i]<=(*counts)[minimum])
+			minimum=i;
 	}
-	
-	int minimumPosition=largestPosition;
-	int i=largestPosition;
-	while(i >= 0){
-		if(y[i] <= y[minimumPosition])
-			minimumPosition=i;
-		i--;
+
+	m_minimumCoverage=minimum;
+	m_peakCoverage=peak;
+}
+
+/**
+ * The half width of the window is coverage/8, the error component
+ * at low coverage is not smoothed and sparse bins at high coverage are.
+ */
+void CoverageDistribution::smoothData(vector<LargeCount>*counts,vector<double>*smoothed){
+	int bins=counts->size();
+
+	vector<LargeCount> sums(bins+1,0);
+	for(int i=0;i<bins;i++)
+		sums[i+1]=sums[i]+(*counts)[i];
+
+	smoothed->resize(bins);
+
+	for(int i=0;i<bins;i++){
+		int halfWidth=i/8;
+		int first=max(0,i-halfWidth);
+		int last=min(bins-1,i+halfWidth);
+
+		(*smoothed)[i]=(0.0+sums[last+1]-sums[first])/(last-first+1);
 	}
+}
 
-	m_minimumCoverage=x[minimumPosition];
-	m_peakCoverage=x[largestPosition];
+void CoverageDistribution::fitModel(vector<LargeCount>*counts){
+	m_errorKmers=0;
+	m_peakKmers=0;
+	m_repeatKmers=0;
 
-	m_repeatCoverage=2*m_peakCoverage;
-	int diff=m_peakCoverage-m_minimumCoverage;
-	int candidate=m_peakCoverage+diff;
+	double weightedSum=0;
 
-	if(candidate<m_repeatCoverage)
-		m_repeatCoverage=candidate;
+	for(int i=1;i<(int)counts->size();i++){
+		LargeCount count=(*counts)[i];
+
+		if(i<m_minimumCoverage){
+			m_errorKmers+=count;
+		}else if(i<m_repeatCoverage){
+			m_peakKmers+=count;
+			weightedSum+=(0.0+i)*count;
+		}else{
+			m_repeatKmers+=count;
+		}
+	}
+
+	m_peakMean=m_peakCoverage;
+	if(m_peakKmers>0)
+		m_peakMean=weightedSum/m_peakKmers;
+}
+
+void CoverageDistribution::printModel(ostream*stream){
+	LargeCount total=m_errorKmers+m_peakKmers+m_repeatKmers;
+	if(total==0)
+		total=1;
+
+	(*stream)<<"Coverage model, error component: "<<m_errorKmers<<" k-mers ("<<(100.0*m_errorKmers)/total;
+	(*stream)<<" %), coverage below "<<m_minimumCoverage<<endl;
+	(*stream)<<"Coverage model, peak component: "<<m_peakKmers<<" k-mers ("<<(100.0*m_peakKmers)/total;
+	(*stream)<<" %), coverage from "<<m_minimumCoverage<<" to "<<m_repeatCoverage-1;
+	(*stream)<<", mean "<<m_peakMean<<endl;
+	(*stream)<<"Coverage model, repeat component: "<<m_repeatKmers<<" k-mers ("<<(100.0*m_repeatKmers)/total;
+	(*stream)<<" %), coverage from "<<m_repeatCoverage<<endl;
 }
 
 int CoverageDistribution::getPeakCoverage(){
@@ -116,3 +209,48 @@ int CoverageDistribution::getMinimumCoverage(){
 int CoverageDistribution::getRepeatCoverage(){
 	return m_repeatCoverage;
 }
+
+#ifdef ASSERT
+/**
+ * Build a synthetic distribution: bin 1 is empty (k-mers are counted
+ * from 2), bin 2 is large and the errors decay into a peak at peak
+ * with a repeat bump at 2*peak. A small ripple stands for the noise.
+ */
+void CoverageDistribution::makeDistribution(map<CoverageDepth,LargeCount>*distribution,double errors,int peak){
+	double peakKmers=3000000;
+	double deviation=1.3*sqrt((double)peak);
+
+	for(int i=2;i<=400;i++){
+		double value=errors*pow(0.45,i-2);
+		value+=peakKmers/(deviation*2.5066)*exp(-0.5*(i-peak)*(i-peak)/(deviation*deviation));
+		value+=0.1*peakKmers/(2*deviation*2.5066)*exp(-0.5*(i-2*peak)*(i-2*peak)/(4*deviation*deviation));
+		value*=1.0+0.03*(i%3-1);
+
+		if((LargeCount)value>0)
+			(*distribution)[i]=(LargeCount)value;
+	}
+}
+
+/**
+ * Check the peak finder on synthetic distributions. The expected values
+ * are those given by the former voting algorithm on the same data.
+ */
+void CoverageDistribution::test(){
+	map<CoverageDepth,LargeCount> withTrough;
+	makeDistribution(&withTrough,50000000,30);
+	CoverageDistribution a(&withTrough,NULL);
+	assert(a.getPeakCoverage()>=28 && a.getPeakCoverage()<=32);
+	assert(a.getMinimumCoverage()>=10 && a.getMinimumCoverage()<=18);
+	assert(a.getRepeatCoverage()>a.getPeakCoverage());
+
+	/** the errors hide the trough, only a shoulder is left */
+	map<CoverageDepth,LargeCount> withShoulder;
+	makeDistribution(&withShoulder,50000000,12);
+	CoverageDistribution b(&withShoulder,NULL);
+	assert(b.getPeakCoverage()>=10 && b.getPeakCoverage()<=14);
+
+	map<CoverageDepth,LargeCount> empty;
+	CoverageDistribution c(&empty,NULL);
+	assert(c.getMinimumCoverage()==1 && c.getPeakCoverage()==1);
+}
+#endif
@@ -27,13 +27,28 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <ostream>
 #include <stdint.h>
 using namespace std;
 
+/** a peak must rise above the trough before it by at least 1/8 of the trough **/
+#define COVERAGE_DISTRIBUTION_MINIMUM_RISE 8
+
+/** without a trough, a peak is a shoulder where the descent flattens
+ * to at least this ratio between consecutive bins, on bins that have
+ * enough k-mers for the ratio to mean something **/
+#define COVERAGE_DISTRIBUTION_SHOULDER_RATIO 0.8
+#define COVERAGE_DISTRIBUTION_SHOULDER_KMERS 1000
+
 /*
  *
  * Given a distribution of coverage, CoverageDistribution computes 
  * the minimum coverage, and the peak coverage.
+ *
+ * The distribution is made dense (one bin per coverage value) and
+ * smoothed with a window that gets wider with the coverage.
+ * The model has 3 components: errors (below the minimum coverage),
+ * the peak (from the minimum coverage to the repeat coverage) and repeats.
  * \author Sébastien Boisvert
  */
 class CoverageDistribution{
@@ -41,14 +56,30 @@ class CoverageDistribution{
 	int m_peakCoverage;
 	int m_repeatCoverage;
 
-	void findPeak(vector<int>*x,vector<LargeCount>*y,vector<LargeCount>*rawValues);
+	LargeCount m_errorKmers;
+	LargeCount m_peakKmers;
+	LargeCount m_repeatKmers;
+	double m_peakMean;
+
+	void smoothData(vector<LargeCount>*counts,vector<double>*smoothed);
+	void findPeak(vector<LargeCount>*counts);
+	void fitModel(vector<LargeCount>*counts);
 
-	vector<uint64_t> smoothData(vector<uint64_t>*a);
+#ifdef ASSERT
+	static void makeDistribution(map<CoverageDepth,LargeCount>*distribution,double errors,int peak);
+#endif
 public:
 	CoverageDistribution(map<CoverageDepth,LargeCount>*distributionOfCoverage,string*file);
 	int getMinimumCoverage();
 	int getPeakCoverage();
 	int getRepeatCoverage();
+
+/** write the components of the model **/
+	void printModel(ostream*stream);
+
+#ifdef ASSERT
+	static void test();
+#endif
 };
 
 #endif
@@ -32,7 +32,7 @@
 #include <application_core/constants.h>
 #include <plugin_KmerAcademyBuilder/Kmer.h>
 #include <plugin_VerticesExtractor/GridTableIterator.h>
-#include <plugin_KmerAcademyBuilder/KmerAcademyIterator.h>
+#include <plugin_CoverageGatherer/CoverageHistogram.h>
 #include <sstream>
 
 __CreatePlugin(CoverageGatherer);
@@ -42,6 +42,8 @@ __CreatePlugin(CoverageGatherer);
 __CreateSlaveModeAdapter(CoverageGatherer,RAY_SLAVE_MODE_SEND_DISTRIBUTION); /**/
  /**/
  /**/
+__CreateMessageTagAdapter(CoverageGatherer,RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM); /**/
+__CreateMessageTagAdapter(CoverageGatherer,RAY_MPI_TAG_COVERAGE_HISTOGRAM_MERGED); /**/
 
 using namespace std;
 
@@ -95,7 +97,6 @@ void CoverageGatherer::writeKmers(){
 		Vertex*node=iterator.next();
 		Kmer key=*(iterator.getKey());
 		int coverage=node->getCoverage(&key);
-		m_distributionOfCoverage[coverage]++;
 		#ifdef ASSERT
 		n++;
 		#endif
@@ -128,77 +129,99 @@ void CoverageGatherer::writeKmers(){
 	}
 	assert(n==m_subgraph->size());
 	#endif
-	m_waiting=false;
-	m_coverageIterator=m_distributionOfCoverage.begin();
 }
 
 void CoverageGatherer::call_RAY_SLAVE_MODE_SEND_DISTRIBUTION(){
 
-	if(m_distributionOfCoverage.size()==0){
-		#ifdef ASSERT
-		LargeCount n=0;
-		#endif
-
-		if(m_subgraph->getKmerAcademy()->size()==0){
-			(*m_slaveMode)=RAY_SLAVE_MODE_DO_NOTHING;
-			Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_COVERAGE_END,
-				m_parameters->getRank());
-			(*m_outbox).push_back(aMessage);
-			return;
-		}
-		KmerAcademyIterator iterator;
-		iterator.constructor(m_subgraph->getKmerAcademy(),m_parameters->getWordSize(),m_parameters);
-		while(iterator.hasNext()){
-			KmerCandidate*node=iterator.next();
-			Kmer key=*(iterator.getKey());
-			int coverage=node->m_count;
-			m_distributionOfCoverage[coverage]++;
-			#ifdef ASSERT
-			n++;
-			#endif
-		}
-			
-		#ifdef ASSERT
-		if(n!=m_subgraph->getKmerAcademy()->size()){
-			cout<<"Expected (from iterator)="<<n<<" Actual (->size())="<<m_subgraph->getKmerAcademy()->size()<<endl;
-		}
-		assert(n==m_subgraph->getKmerAcademy()->size());
-		#endif
+	if(!m_initialised){
+		m_initialised=true;
 		m_waiting=false;
-		m_coverageIterator=m_distributionOfCoverage.begin();
+		m_bin=0;
+
+		Rank rank=m_parameters->getRank();
+		m_children=0;
+		if(2*rank+1<m_parameters->getSize())
+			m_children++;
+		if(2*rank+2<m_parameters->getSize())
+			m_children++;
+
+	// the histogram is complete once the subtree has added its own
+	}else if(m_mergedChildren<m_children){
+		return;
+
 	}else if(m_waiting){
-		if((*m_inbox).size()>0&&(*m_inbox)[0]->getTag()==RAY_MPI_TAG_COVERAGE_DATA_REPLY){
+		if((*m_inbox).size()>0&&((*m_inbox)[0]->getTag()==RAY_MPI_TAG_COVERAGE_DATA_REPLY
+			|| (*m_inbox)[0]->getTag()==RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM_REPLY)){
 			m_waiting=false;
 		}
 	}else{
+		CoverageHistogram*histogram=m_subgraph->getKmerAcademy()->getCoverageHistogram();
+		Rank rank=m_parameters->getRank();
+
 		MessageUnit*messageContent=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
 		int count=0;
 		int maximumElements=MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit);
-		while(count<maximumElements && m_coverageIterator!=m_distributionOfCoverage.end()){
-			CoverageDepth coverage=m_coverageIterator->first;
-			LargeCount numberOfVertices=m_coverageIterator->second;
-			messageContent[count]=coverage;
-			messageContent[count+1]=numberOfVertices;
-			count+=2;
-			m_coverageIterator++;
+
+		// empty bins are not sent
+		while(count+2<=maximumElements && m_bin<histogram->getNumberOfBins()){
+			LargeCount numberOfVertices=histogram->getCount(m_bin);
+			if(numberOfVertices>0){
+				messageContent[count]=m_bin;
+				messageContent[count+1]=numberOfVertices;
+				count+=2;
+			}
+			m_bin++;
 		}
 
 		if(count!=0){
-			Message aMessage(messageContent,count,MASTER_RANK,RAY_MPI_TAG_COVERAGE_DATA,
-				m_parameters->getRank());
+			// the root of the tree sends the sum to the master
+			Rank destination=MASTER_RANK;
+			MessageTag tag=RAY_MPI_TAG_COVERAGE_DATA;
+
+			if(rank!=0){
+				destination=(rank-1)/2;
+				tag=RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM;
+			}
+
+			Message aMessage(messageContent,count,destination,tag,rank);
 			
 			(*m_outbox).push_back(aMessage);
 			m_waiting=true;
 		}else{
-			m_distributionOfCoverage.clear();
+			if(rank!=0){
+				Message aMessage(NULL,0,(rank-1)/2,RAY_MPI_TAG_COVERAGE_HISTOGRAM_MERGED,rank);
+				(*m_outbox).push_back(aMessage);
+			}
+
+			m_initialised=false;
+			m_mergedChildren=0;
+
 			(*m_slaveMode)=RAY_SLAVE_MODE_DO_NOTHING;
-			Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_COVERAGE_END,
-				m_parameters->getRank());
+			Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_COVERAGE_END,rank);
 			(*m_outbox).push_back(aMessage);
 		}
 	}
 }
 
+void CoverageGatherer::call_RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM(Message*message){
+	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
+	int count=message->getCount();
+
+	CoverageHistogram*histogram=m_subgraph->getKmerAcademy()->getCoverageHistogram();
+
+	for(int i=0;i<count;i+=2){
+		histogram->add(incoming[i],incoming[i+1]);
+	}
+
+	Message aMessage(NULL,0,message->getSource(),RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM_REPLY,
+		m_parameters->getRank());
+	(*m_outbox).push_back(aMessage);
+}
+
+void CoverageGatherer::call_RAY_MPI_TAG_COVERAGE_HISTOGRAM_MERGED(Message*message){
+	m_mergedChildren++;
+}
+
 void CoverageGatherer::constructor(Parameters*parameters,StaticVector*inbox,StaticVector*outbox,int*slaveMode,
 	GridTable*subgraph,RingAllocator*outboxAllocator){
 	m_parameters=parameters;
@@ -207,6 +230,11 @@ void CoverageGatherer::constructor(Parameters*parameters,StaticVector*inbox,Stat
 	m_inbox=inbox;
 	m_outbox=outbox;
 	m_subgraph=subgraph;
+
+	m_initialised=false;
+	m_waiting=false;
+	m_mergedChildren=0;
+	m_children=0;
 }
 
 void CoverageGatherer::registerPlugin(ComputeCore*core){
@@ -234,6 +262,16 @@ void CoverageGatherer::registerPlugin(ComputeCore*core){
 	RAY_MPI_TAG_GET_COVERAGE_AND_PATHS_REPLY=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_GET_COVERAGE_AND_PATHS_REPLY,"RAY_MPI_TAG_GET_COVERAGE_AND_PATHS_REPLY");
 
+	RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM,__GetAdapter(CoverageGatherer,RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM,"RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM");
+
+	RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM_REPLY,"RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM_REPLY");
+
+	RAY_MPI_TAG_COVERAGE_HISTOGRAM_MERGED=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_COVERAGE_HISTOGRAM_MERGED,__GetAdapter(CoverageGatherer,RAY_MPI_TAG_COVERAGE_HISTOGRAM_MERGED));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_COVERAGE_HISTOGRAM_MERGED,"RAY_MPI_TAG_COVERAGE_HISTOGRAM_MERGED");
 }
 
 void CoverageGatherer::resolveSymbols(ComputeCore*core){
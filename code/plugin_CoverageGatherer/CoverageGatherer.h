@@ -27,14 +27,19 @@
 #include <plugin_VerticesExtractor/GridTable.h>
 #include <memory/RingAllocator.h>
 #include <core/ComputeCore.h>
+#include <communication/Message.h>
 
 #include <stdint.h>
-#include <map>
 using namespace std;
 
-
-
 /**
+ * Sends the coverage distribution to the master.
+ *
+ * Each rank has a dense histogram built while k-mers are counted.
+ * Histograms are summed along a binary tree of ranks (rank r receives
+ * those of ranks 2r+1 and 2r+2) so that only rank 0 sends its bins to
+ * the master.
+ *
  * \author Sébastien Boisvert
  */
 class CoverageGatherer : public CorePlugin{
@@ -46,14 +51,24 @@ class CoverageGatherer : public CorePlugin{
 
 	MessageTag RAY_MPI_TAG_COVERAGE_DATA;
 	MessageTag RAY_MPI_TAG_COVERAGE_END;
+	MessageTag RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM;
+	MessageTag RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM_REPLY;
+	MessageTag RAY_MPI_TAG_COVERAGE_HISTOGRAM_MERGED;
 
 	SlaveMode RAY_SLAVE_MODE_DO_NOTHING;
 	SlaveMode RAY_SLAVE_MODE_SEND_DISTRIBUTION;
 
 
-	map<CoverageDepth,LargeCount> m_distributionOfCoverage;
-	map<CoverageDepth,LargeCount>::iterator m_coverageIterator;
+	bool m_initialised;
 	bool m_waiting;
+
+/** next bin of the histogram to send **/
+	int m_bin;
+
+/** ranks of the subtree that added their histogram to this one **/
+	int m_mergedChildren;
+	int m_children;
+
 	Parameters*m_parameters;
 	StaticVector*m_inbox;
 	StaticVector*m_outbox;
@@ -64,6 +79,8 @@ public:
 	void constructor(Parameters*parameters,StaticVector*inbox,StaticVector*outbox,int*slaveMode,
 		GridTable*subgraph,RingAllocator*outboxAllocator);
 	void call_RAY_SLAVE_MODE_SEND_DISTRIBUTION();
+	void call_RAY_MPI_TAG_MERGE_COVERAGE_HISTOGRAM(Message*message);
+	void call_RAY_MPI_TAG_COVERAGE_HISTOGRAM_MERGED(Message*message);
 	void writeKmers();
 
 	void registerPlugin(ComputeCore*core);
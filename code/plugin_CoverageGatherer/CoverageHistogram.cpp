@@ -0,0 +1,81 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#include <plugin_CoverageGatherer/CoverageHistogram.h>
+
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
+void CoverageHistogram::constructor(){
+	m_counts.assign(CONFIG_MAXIMUM_COVERAGE+1,0);
+}
+
+void CoverageHistogram::destructor(){
+	vector<LargeCount> empty;
+	m_counts.swap(empty);
+}
+
+int CoverageHistogram::getBin(CoverageDepth coverage){
+	if(coverage>CONFIG_MAXIMUM_COVERAGE)
+		return CONFIG_MAXIMUM_COVERAGE;
+
+	return coverage;
+}
+
+void CoverageHistogram::add(CoverageDepth coverage,LargeCount count){
+	m_counts[getBin(coverage)]+=count;
+}
+
+void CoverageHistogram::remove(CoverageDepth coverage,LargeCount count){
+	#ifdef ASSERT
+	assert(m_counts[getBin(coverage)]>=count);
+	#endif
+
+	m_counts[getBin(coverage)]-=count;
+}
+
+void CoverageHistogram::move(CoverageDepth oldCoverage,CoverageDepth newCoverage){
+	int oldBin=getBin(oldCoverage);
+	int newBin=getBin(newCoverage);
+
+	if(oldBin==newBin)
+		return;
+
+	#ifdef ASSERT
+	assert(m_counts[oldBin]>0);
+	#endif
+
+	m_counts[oldBin]--;
+	m_counts[newBin]++;
+}
+
+LargeCount CoverageHistogram::getCount(int bin){
+	#ifdef ASSERT
+	assert(bin>=0 && bin<getNumberOfBins());
+	#endif
+
+	return m_counts[bin];
+}
+
+int CoverageHistogram::getNumberOfBins(){
+	return m_counts.size();
+}
@@ -0,0 +1,61 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#ifndef _CoverageHistogram_h
+#define _CoverageHistogram_h
+
+#include <application_core/constants.h>
+
+#include <vector>
+using namespace std;
+
+/**
+ * A dense histogram of coverage depths.
+ *
+ * There is one bin per coverage value, coverage values above
+ * CONFIG_MAXIMUM_COVERAGE go in the last bin.
+ * It is updated while k-mers are counted so that no pass
+ * over the hash table is needed to get the distribution.
+ *
+ * \author Sébastien Boisvert
+ */
+class CoverageHistogram{
+
+	vector<LargeCount> m_counts;
+
+	int getBin(CoverageDepth coverage);
+
+public:
+
+	void constructor();
+	void destructor();
+
+	void add(CoverageDepth coverage,LargeCount count);
+	void remove(CoverageDepth coverage,LargeCount count);
+
+/** a k-mer had its coverage changed **/
+	void move(CoverageDepth oldCoverage,CoverageDepth newCoverage);
+
+	LargeCount getCount(int bin);
+	int getNumberOfBins();
+};
+
+#endif
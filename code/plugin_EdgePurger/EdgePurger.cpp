@@ -91,6 +91,11 @@ void EdgePurger::call_RAY_SLAVE_MODE_PURGE_NULL_EDGES(){
 
 void EdgePurger::finalizeMethod(){
 	printf("Rank %i is purging edges [%i/%i] (completed)\n",m_parameters->getRank(),(int)m_subgraph->size(),(int)m_subgraph->size());
+	#if defined(RAY_64_BITS)
+	printf("Rank %i purged %lu edges to k-mers that were not stored\n",m_parameters->getRank(),m_purgedEdges);
+	#elif defined(RAY_32_BITS)
+	printf("Rank %i purged %llu edges to k-mers that were not stored\n",m_parameters->getRank(),m_purgedEdges);
+	#endif
 	fflush(stdout);
 	
 	m_done=true;
@@ -100,6 +105,8 @@ void EdgePurger::finalizeMethod(){
 
 	m_derivative.writeFile(&cout);
 
+	m_subgraph->printLocalQueries("purging edges");
+
 	if(m_parameters->showMemoryUsage()){
 		showMemoryUsage(m_parameters->getRank());
 	}
@@ -138,8 +145,9 @@ Worker* EdgePurger::assignNextTask(){
 	return worker;
 }
 
-void EdgePurger::processWorkerResult(Worker*){
-	/* nothing to do */
+void EdgePurger::processWorkerResult(Worker*worker){
+	m_purgedEdges+=((EdgePurgerWorker*)worker)->getNumberOfPurgedEdges();
+
 	if(m_completedJobs%50000==0){
 		cout<<"Rank "<<m_parameters->getRank()<<" is purging edges ["<<m_completedJobs+1;
 		cout<<"/"<<m_subgraph->size()<<"]"<<endl;
@@ -161,6 +169,7 @@ void EdgePurger::initializeMethod(){
 	#endif
 
 	m_SEEDING_i=0;
+	m_purgedEdges=0;
 	m_graphIterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
 
 	#ifdef DEBUG_EdgePurger
@@ -82,6 +82,9 @@ class EdgePurger : public TaskCreator, public CorePlugin {
 	int*m_masterMode;
 	bool m_done;
 
+/** edges to k-mers that were not stored **/
+	LargeCount m_purgedEdges;
+
 public:
 	void constructor(StaticVector*outbox,StaticVector*inbox,RingAllocator*outboxAllocator,Parameters*parameters,
 		int*slaveMode,int*masterMode,VirtualCommunicator*vc,GridTable*graph,VirtualProcessor*virtualProcessor);
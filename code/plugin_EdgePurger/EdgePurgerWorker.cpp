@@ -36,6 +36,17 @@ void EdgePurgerWorker::work(){
 			Kmer vertex=m_edges[m_iterator];
 			if(!m_coverageRequested){
 				Rank sendTo=m_parameters->_vertexRank(&vertex);
+
+				// the vertex is on this rank, no message is needed
+				if(m_subgraph->isLocalQuery(sendTo)){
+					if(m_subgraph->getLocalCoverage(&vertex)<m_parameters->getMinimumCoverageToStore()){
+						m_vertex->deleteIngoingEdge(&m_currentKmer,&vertex,m_parameters->getWordSize());
+						m_purgedEdges++;
+					}
+					m_iterator++;
+					return;
+				}
+
 				MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
 				int bufferPosition=0;
 				vertex.pack(message,&bufferPosition);
@@ -50,6 +61,7 @@ void EdgePurgerWorker::work(){
 
 				if(coverage<m_parameters->getMinimumCoverageToStore()){
 					m_vertex->deleteIngoingEdge(&m_currentKmer,&vertex,m_parameters->getWordSize());
+					m_purgedEdges++;
 				}
 				m_iterator++;
 				m_coverageRequested=false;
@@ -69,6 +81,17 @@ void EdgePurgerWorker::work(){
 			Kmer vertex=m_edges[m_iterator];
 			if(!m_coverageRequested){
 				Rank sendTo=m_parameters->_vertexRank(&vertex);
+
+				// the vertex is on this rank, no message is needed
+				if(m_subgraph->isLocalQuery(sendTo)){
+					if(m_subgraph->getLocalCoverage(&vertex)<m_parameters->getMinimumCoverageToStore()){
+						m_vertex->deleteOutgoingEdge(&m_currentKmer,&vertex,m_parameters->getWordSize());
+						m_purgedEdges++;
+					}
+					m_iterator++;
+					return;
+				}
+
 				MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
 				int bufferPosition=0;
 				vertex.pack(message,&bufferPosition);
@@ -83,6 +106,7 @@ void EdgePurgerWorker::work(){
 
 				if(coverage<m_parameters->getMinimumCoverageToStore()){
 					m_vertex->deleteOutgoingEdge(&m_currentKmer,&vertex,m_parameters->getWordSize());
+					m_purgedEdges++;
 				}
 				m_iterator++;
 				m_coverageRequested=false;
@@ -110,6 +134,7 @@ void EdgePurgerWorker::constructor(WorkerHandle workerId,Vertex*vertex,Kmer*curr
 	m_inbox=inbox;
 	m_outbox=outbox;
 	m_isDone=false;
+	m_purgedEdges=0;
 	m_doneIngoingEdges=false;
 	m_ingoingInitialised=false;
 }
@@ -117,3 +142,7 @@ void EdgePurgerWorker::constructor(WorkerHandle workerId,Vertex*vertex,Kmer*curr
 WorkerHandle EdgePurgerWorker::getWorkerIdentifier(){
 	return m_workerId;
 }
+
+LargeCount EdgePurgerWorker::getNumberOfPurgedEdges(){
+	return m_purgedEdges;
+}
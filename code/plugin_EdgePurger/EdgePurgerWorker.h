@@ -58,6 +58,8 @@ class EdgePurgerWorker : public Worker {
 	StaticVector*m_outbox;
 	RingAllocator*m_outboxAllocator;
 	VirtualCommunicator*m_virtualCommunicator;
+
+	LargeCount m_purgedEdges;
 public:
 	void constructor(WorkerHandle workerId,Vertex*vertex,Kmer*currentKmer,GridTable*subgraph,VirtualCommunicator*virtualCommunicator,RingAllocator*outboxAllocator,Parameters*parameters,
 		StaticVector*inbox,StaticVector*outbox,MessageTag tag);
@@ -73,6 +75,8 @@ public:
 	/** get the worker number */
 	WorkerHandle getWorkerIdentifier();
 
+	LargeCount getNumberOfPurgedEdges();
+
 };
 
 #endif
@@ -21,6 +21,7 @@
 
 #include <assert.h>
 #include <plugin_FusionData/FusionData.h>
+#include <application_core/CheckpointFile.h>
 #include <core/OperatingSystem.h>
 #include <sstream>
 #include <communication/Message.h>
@@ -45,31 +46,25 @@ void FusionData::call_RAY_SLAVE_MODE_DISTRIBUTE_FUSIONS(){
 
 		if(m_parameters->hasCheckpoint("ContigPaths")){
 			cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint ContigPaths"<<endl;
-			ifstream f(m_parameters->getCheckpointFile("ContigPaths").c_str());
+			CheckpointReader f(m_parameters,"ContigPaths");
 	
 			/* delete old stuff */
 			m_ed->m_EXTENSION_identifiers.clear();
 			m_ed->m_EXTENSION_contigs.clear();
+			m_FUSION_isolated.clear();
 	
 			int theSize=0;
 			f.read((char*)&theSize,sizeof(int));
 	
-			/* write each path with its name and vertices */
+			/* read each path with its name and packed vertices */
 			for(int i=0;i<theSize;i++){
 				PathHandle name=0;
-				int vertices=0;
 				f.read((char*)&name,sizeof(PathHandle));
-				f.read((char*)&vertices,sizeof(int));
-				vector<Kmer> path;
-				for(int j=0;j<vertices;j++){
-					Kmer kmer;
-					kmer.read(&f);
-					path.push_back(kmer);
-				}
+				ContigPath path;
+				path.read(&f);
 	
 				#ifdef ASSERT
-				assert(vertices!=0);
-				assert(vertices == (int)path.size());
+				assert(path.size()!=0);
 				#endif
 	
 				m_ed->m_EXTENSION_identifiers.push_back(name);
@@ -125,7 +120,7 @@ void FusionData::call_RAY_SLAVE_MODE_DISTRIBUTE_FUSIONS(){
 	assert(m_ed->m_EXTENSION_contigs[m_seedingData->m_SEEDING_i].size() > 0);
 	#endif
 
-	Kmer vertex=m_ed->m_EXTENSION_contigs[m_seedingData->m_SEEDING_i][m_ed->m_EXTENSION_currentPosition];
+	Kmer vertex=m_ed->m_EXTENSION_contigs[m_seedingData->m_SEEDING_i].at(m_ed->m_EXTENSION_currentPosition);
 	int destination=m_parameters->_vertexRank(&vertex);
 
 	for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
@@ -158,6 +153,12 @@ void FusionData::constructor(int size,int max,int rank,StaticVector*outbox,
 		ExtensionData*ed,SeedingData*seedingData,int*mode,Parameters*parameters){
 	m_parameters=parameters;
 	m_processedCheckpoint=false;
+	m_FINISH_examinedPaths=0;
+	m_FINISH_skippedPaths=0;
+	m_FINISH_removedPaths=0;
+	m_FUSION_examinedPaths=0;
+	m_FUSION_skippedPaths=0;
+	m_FUSION_removedPaths=0;
 	m_debugFusionCode=m_parameters->hasOption("-debug-fusions");
 	m_seedingData=seedingData;
 	m_cacheAllocator.constructor(4194304,"RAY_MALLOC_TYPE_FUSION_CACHING",m_parameters->showMemoryAllocations());
@@ -297,7 +298,7 @@ void FusionData::finishFusions(){
 				m_Machine_getPaths_DONE=true;
 				m_Machine_getPaths_result.clear();// avoids major leak... LOL
 			}else{
-				getPaths(m_ed->m_EXTENSION_contigs[m_seedingData->m_SEEDING_i][m_ed->m_EXTENSION_currentPosition]);
+				getPaths(m_ed->m_EXTENSION_contigs[m_seedingData->m_SEEDING_i].at(m_ed->m_EXTENSION_currentPosition));
 			}
 		}else{
 			// at this point, we have the paths that has the said vertex in them.
@@ -326,7 +327,8 @@ void FusionData::finishFusions(){
 						showDate();
 					}
 				}
-				vector<Kmer> a;
+				ContigPath a;
+				a.setKmerLength(m_parameters->getWordSize());
 				m_FINISH_newFusions.push_back(a);
 				vector<int> b;
 				m_FINISH_coverages.clear();
@@ -335,8 +337,8 @@ void FusionData::finishFusions(){
 				m_FUSION_pathLengthRequested=false;
 				m_checkedValidity=false;
 			}
-			Kmer vertex=m_ed->m_EXTENSION_contigs[m_seedingData->m_SEEDING_i][m_ed->m_EXTENSION_currentPosition];
-			m_FINISH_newFusions[m_FINISH_newFusions.size()-1].push_back(vertex);
+			Kmer vertex=m_ed->m_EXTENSION_contigs[m_seedingData->m_SEEDING_i].at(m_ed->m_EXTENSION_currentPosition);
+			m_FINISH_newFusions[m_FINISH_newFusions.size()-1].push_back(&vertex);
 			m_Machine_getPaths_DONE=false;
 			m_Machine_getPaths_INITIALIZED=false;
 			m_Machine_getPaths_result.clear();
@@ -441,7 +443,7 @@ void FusionData::finishFusions(){
 				assert(m_seedingData->m_SEEDING_i<m_ed->m_EXTENSION_contigs.size());
 				assert(m_ed->m_EXTENSION_currentPosition<(int)m_ed->m_EXTENSION_contigs[m_seedingData->m_SEEDING_i].size());
 				#endif
-				getPaths(m_ed->m_EXTENSION_contigs[m_seedingData->m_SEEDING_i][m_ed->m_EXTENSION_currentPosition]);
+				getPaths(m_ed->m_EXTENSION_contigs[m_seedingData->m_SEEDING_i].at(m_ed->m_EXTENSION_currentPosition));
 			}else{
 
 				bool found=false;
@@ -521,7 +523,7 @@ void FusionData::finishFusions(){
 					m_FINISH_vertex_received=false;
 
 				}else if(m_FINISH_vertex_received){
-					m_FINISH_newFusions[m_FINISH_newFusions.size()-1].push_back(m_FINISH_received_vertex);
+					m_FINISH_newFusions[m_FINISH_newFusions.size()-1].push_back(&m_FINISH_received_vertex);
 					m_FINISH_vertex_requested=false;
 					m_selectedPosition++;
 					m_FINISH_fusionOccured=true;
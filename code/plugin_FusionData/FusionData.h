@@ -98,7 +98,7 @@ public:
 
 	bool m_FINISH_vertex_received;
 	bool m_FINISH_fusionOccured;
-	vector<vector<Kmer > > m_FINISH_newFusions;
+	vector<ContigPath> m_FINISH_newFusions;
 	vector<int> m_FINISH_coverages;
 	map<PathHandle,int> m_FINISH_pathLengths;
 	Kmer  m_FINISH_received_vertex;
@@ -136,6 +136,18 @@ public:
 
 	set<PathHandle> m_FUSION_eliminated;
 
+	/** paths that shared no vertex with another path in a round.
+ * New paths are made of vertices of other paths, so they are not examined again **/
+	set<PathHandle> m_FUSION_isolated;
+
+	/** statistics of the current joining and fusion rounds, summed on the master */
+	LargeCount m_FINISH_examinedPaths;
+	LargeCount m_FINISH_skippedPaths;
+	LargeCount m_FINISH_removedPaths;
+	LargeCount m_FUSION_examinedPaths;
+	LargeCount m_FUSION_skippedPaths;
+	LargeCount m_FUSION_removedPaths;
+
 	void call_RAY_SLAVE_MODE_DISTRIBUTE_FUSIONS();
 
 	void constructor(int size,int maxSize,int rank,StaticVector*m_outbox,
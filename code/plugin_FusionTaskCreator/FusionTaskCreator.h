@@ -35,6 +35,7 @@
 #include <core/ComputeCore.h>
 
 #include <vector>
+#include <map>
 #include <set>
 using namespace std;
 
@@ -61,11 +62,18 @@ class FusionTaskCreator: public TaskCreator, public CorePlugin {
 	Parameters*m_parameters;
 	StaticVector*m_outbox;
 	int*m_slaveMode;
-	vector<vector<Kmer> >*m_paths;
+	vector<ContigPath>*m_paths;
 	vector<PathHandle>*m_pathIdentifiers;
 
 	set<PathHandle>*m_eliminated;
 
+	/** paths that are not examined again */
+	set<PathHandle>*m_isolated;
+
+	/** number of strands of each path that shared no vertex */
+	map<PathHandle,int> m_isolatedStrands;
+	LargeCount m_skippedPaths;
+
 	uint64_t m_iterator;
 	WorkerHandle m_currentWorkerIdentifier;
 	bool m_reverseStrand;
@@ -78,8 +86,8 @@ class FusionTaskCreator: public TaskCreator, public CorePlugin {
 
 public:
 	void constructor( VirtualProcessor*virtualProcessor,StaticVector*outbox,
-		RingAllocator*outboxAllocator,int*mode,Parameters*parameters,vector<vector<Kmer> >*paths,vector<PathHandle >*pathIdentifiers,
-		set<PathHandle>*eliminated,VirtualCommunicator*virtualCommunicator);
+		RingAllocator*outboxAllocator,int*mode,Parameters*parameters,vector<ContigPath>*paths,vector<PathHandle >*pathIdentifiers,
+		set<PathHandle>*eliminated,set<PathHandle>*isolated,VirtualCommunicator*virtualCommunicator);
 
 	void call_RAY_SLAVE_MODE_FUSION();
 
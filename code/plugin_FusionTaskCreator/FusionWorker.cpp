@@ -52,7 +52,17 @@ TODO: does the code pay attention when the coverage indicates a repeated k-mer ?
 	if(m_isDone)
 		return;
 
-	if(m_position < (int) m_path->size()){
+	if(!m_screener.isDone()){
+		m_screener.work();
+
+		if(m_screener.sharesNoVertex()){
+			m_position=m_path->size();
+
+			if(m_parameters->hasOption("-debug-fusions"))
+				cout<<"worker "<<m_workerIdentifier<<" path "<<m_identifier<<" shares no sampled vertex"<<endl;
+		}
+
+	}else if(m_position < (int) m_path->size()){
 
 		/* get the number of paths */
 		if(!m_requestedNumberOfPaths){
@@ -66,8 +76,7 @@ TODO: does the code pay attention when the coverage indicates a repeated k-mer ?
 			if(m_reverseStrand)
 				kmer=kmer.complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
 
-			Rank destination=kmer.vertexRank(m_parameters->getSize(),
-				m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+			Rank destination=m_parameters->_vertexRank(&kmer);
 			int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
 			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery);
 			int outputPosition=0;
@@ -88,6 +97,13 @@ TODO: does the code pay attention when the coverage indicates a repeated k-mer ?
 			vector<MessageUnit> response;
 			m_virtualCommunicator->getMessageResponseElements(m_workerIdentifier,&response);
 			m_numberOfPaths=response[0];
+
+			int otherPaths=m_numberOfPaths;
+			if(!m_reverseStrand)
+				otherPaths--;
+
+			if(otherPaths>0)
+				m_sawOtherPaths=true;
 		
 			if(m_parameters->hasOption("-debug-fusions2"))
 				cout<<"worker "<<m_workerIdentifier<<" Got "<<m_numberOfPaths<<endl;
@@ -98,7 +114,7 @@ TODO: does the code pay attention when the coverage indicates a repeated k-mer ?
 			m_requestedPath=false;
 
 			/* 2^5 */
-			int maximumNumberOfPathsToProcess=32;
+			int maximumNumberOfPathsToProcess=MAXIMUM_PATHS_PER_FUSION_VERTEX;
 
 			/* don't process repeated stuff */
 			if(m_numberOfPaths> maximumNumberOfPathsToProcess)
@@ -111,8 +127,7 @@ TODO: does the code pay attention when the coverage indicates a repeated k-mer ?
 				if(m_reverseStrand)
 					kmer=kmer.complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
 	
-				Rank destination=kmer.vertexRank(m_parameters->getSize(),
-					m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+				Rank destination=m_parameters->_vertexRank(&kmer);
 				int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATH);
 				MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery);
 				int outputPosition=0;
@@ -256,7 +271,7 @@ WorkerHandle FusionWorker::getWorkerIdentifier(){
 	return m_workerIdentifier;
 }
 
-void FusionWorker::constructor(WorkerHandle number,vector<Kmer>*path,PathHandle identifier,bool reverseStrand,
+void FusionWorker::constructor(WorkerHandle number,ContigPath*path,PathHandle identifier,bool reverseStrand,
 	VirtualCommunicator*virtualCommunicator,Parameters*parameters,RingAllocator*outboxAllocator,
 
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH,
@@ -282,6 +297,10 @@ void FusionWorker::constructor(WorkerHandle number,vector<Kmer>*path,PathHandle
 	m_position=0;
 	m_requestedNumberOfPaths=false;
 
+	m_sawOtherPaths=false;
+	m_screener.constructor(m_path,m_reverseStrand,m_workerIdentifier,m_virtualCommunicator,
+		m_parameters,m_outboxAllocator,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
+
 	if(m_parameters->hasOption("-debug-fusions")){
 		cout<<"Spawned worker number "<<number<<endl;
 		cout<<" path "<<m_identifier<<" reverse "<<m_reverseStrand<<" length "<<m_path->size()<<endl;
@@ -292,6 +311,10 @@ bool FusionWorker::isPathEliminated(){
 	return m_eliminated;
 }
 
+bool FusionWorker::isPathIsolated(){
+	return !m_sawOtherPaths && !m_screener.sawOtherPaths();
+}
+
 PathHandle FusionWorker::getPathIdentifier(){
 	return m_identifier;
 }
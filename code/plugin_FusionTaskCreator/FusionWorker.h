@@ -26,6 +26,7 @@
 #include <scheduling/Worker.h>
 #include <plugin_KmerAcademyBuilder/Kmer.h>
 #include <application_core/Parameters.h>
+#include <plugin_SeedExtender/PathScreener.h>
 
 #include <stdint.h>
 #include <map>
@@ -42,9 +43,16 @@ class FusionWorker: public Worker{
 	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH;
 
 	bool m_requestedNumberOfPaths;
+
+	/* sampled positions queried before the walk */
+	PathScreener m_screener;
+
+	/* another path was seen at a queried vertex */
+	bool m_sawOtherPaths;
+
 	WorkerHandle m_workerIdentifier;
 	bool m_isDone;
-	vector<Kmer>*m_path;
+	ContigPath*m_path;
 	PathHandle m_identifier;
 	bool m_reverseStrand;
 	bool m_eliminated;
@@ -65,7 +73,7 @@ class FusionWorker: public Worker{
 	bool m_receivedPath;
 	bool m_requestedPath;
 public:
-	void constructor(WorkerHandle i,vector<Kmer>*path,PathHandle identifier,bool reverseStrand,
+	void constructor(WorkerHandle i,ContigPath*path,PathHandle identifier,bool reverseStrand,
 VirtualCommunicator*virtualCommunicator,Parameters*parameters,RingAllocator*outboxAllocator,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
@@ -82,6 +90,9 @@ VirtualCommunicator*virtualCommunicator,Parameters*parameters,RingAllocator*outb
 	WorkerHandle getWorkerIdentifier();
 
 	bool isPathEliminated();
+
+	/** no other path goes through the queried vertices of this strand */
+	bool isPathIsolated();
 	PathHandle getPathIdentifier();
 };
 
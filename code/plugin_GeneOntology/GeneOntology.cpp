@@ -27,6 +27,9 @@
 #include <core/OperatingSystem.h>
 #include <plugin_GeneOntology/KeyEncoder.h>
 
+#include <algorithm>
+using namespace std;
+
 __CreatePlugin(GeneOntology);
 
  /**/
@@ -302,6 +305,36 @@ void GeneOntology::loadAnnotations(){
 	m_colorsForOntology.clear();
 }
 
+void GeneOntology::indexAnnotations(){
+
+	m_annotatedColors.clear();
+	m_annotationStarts.clear();
+	m_annotationTerms.clear();
+	m_annotationRealTerms.clear();
+
+	// the map is sorted by color
+	for(map<PhysicalKmerColor,vector<GeneOntologyIdentifier> >::iterator i=m_annotations.begin();
+		i!=m_annotations.end();i++){
+
+		m_annotatedColors.push_back(i->first);
+		m_annotationStarts.push_back(m_annotationTerms.size());
+
+		for(int j=0;j<(int)i->second.size();j++){
+			GeneOntologyIdentifier term=i->second[j];
+
+			m_annotationTerms.push_back(term);
+			m_annotationRealTerms.push_back(dereferenceTerm(term));
+		}
+	}
+
+	m_annotationStarts.push_back(m_annotationTerms.size());
+
+	cout<<"Rank "<<m_rank<<" indexed "<<m_annotationTerms.size()<<" annotations for ";
+	cout<<m_annotatedColors.size()<<" objects"<<endl;
+
+	m_annotations.clear();
+}
+
 void GeneOntology::call_RAY_SLAVE_MODE_ONTOLOGY_MAIN(){
 
 	if(!m_slaveStarted){
@@ -324,6 +357,8 @@ void GeneOntology::call_RAY_SLAVE_MODE_ONTOLOGY_MAIN(){
 
 		loadOntology(&m_identifiers,&m_descriptions);
 
+		indexAnnotations();
+
 	}else if(!m_countOntologyTermsInGraph){
 
 		countOntologyTermsInGraph();
@@ -1323,7 +1358,7 @@ void GeneOntology::countOntologyTermsInGraph(){
 
 		// this is the set of gene ontology terms that 
 		// the current k-mer contributes to
-		set<GeneOntologyIdentifier> ontologyTerms;
+		m_kmerTerms.clear();
 
 		for(set<PhysicalKmerColor>::iterator j=physicalColors->begin();
 			j!=physicalColors->end();j++){
@@ -1336,35 +1371,37 @@ void GeneOntology::countOntologyTermsInGraph(){
 
 				PhysicalKmerColor colorForPhylogeny=physicalColor % COLOR_NAMESPACE_MULTIPLIER;
 	
+				vector<PhysicalKmerColor>::iterator entry=lower_bound(m_annotatedColors.begin(),
+					m_annotatedColors.end(),colorForPhylogeny);
+
 				/* the color is in the graph, but no annotations exist... */
-				if(m_annotations.count(colorForPhylogeny)==0){
+				if(entry==m_annotatedColors.end() || *entry!=colorForPhylogeny){
 					continue;
 				}
 
-				vector<GeneOntologyIdentifier>*terms=NULL;
-				terms=&(m_annotations[colorForPhylogeny]);
-
-				int numberOfTerms=terms->size();
+				int index=entry-m_annotatedColors.begin();
 
-				for(int i=0;i<numberOfTerms;i++){
+				for(int i=m_annotationStarts[index];i<m_annotationStarts[index+1];i++){
 
-					GeneOntologyIdentifier term=terms->at(i);
-
-					ontologyTerms.insert(term);
+					m_kmerTerms.push_back(make_pair(m_annotationTerms[i],m_annotationRealTerms[i]));
 				}
 			}
 		}
 
+		// each term is counted once
+		sort(m_kmerTerms.begin(),m_kmerTerms.end());
+		m_kmerTerms.erase(unique(m_kmerTerms.begin(),m_kmerTerms.end()),m_kmerTerms.end());
+
 		// here, we have a list of gene ontology terms
 		// update each of them. 
 
 		int quantity=1;
 
-		for(set<GeneOntologyIdentifier>::iterator i=ontologyTerms.begin();i!=ontologyTerms.end();i++){
+		for(int i=0;i<(int)m_kmerTerms.size();i++){
 			
-			GeneOntologyIdentifier term=*i;
+			GeneOntologyIdentifier term=m_kmerTerms[i].first;
 
-			GeneOntologyIdentifier realTerm=dereferenceTerm(term);
+			GeneOntologyIdentifier realTerm=m_kmerTerms[i].second;
 
 			#ifdef BUG_DETERMINISM
 			if(term==49){
@@ -1376,7 +1413,7 @@ void GeneOntology::countOntologyTermsInGraph(){
 		}
 
 		// update the total
-		if(!ontologyTerms.empty()){
+		if(!m_kmerTerms.empty()){
 			m_kmerObservationsWithGeneOntologies+=kmerCoverage;
 		}
 	}
@@ -52,6 +52,18 @@ class GeneOntology: public CorePlugin{
 	char*m_annotationFileName;
 
 	map<PhysicalKmerColor,vector<GeneOntologyIdentifier> > m_annotations;
+
+/** m_annotations in sorted vectors, once the alternate identifiers are known:
+ * the terms of m_annotatedColors[i] are at m_annotationStarts[i] ... m_annotationStarts[i+1]-1
+ */
+	vector<PhysicalKmerColor> m_annotatedColors;
+	vector<int> m_annotationStarts;
+	vector<GeneOntologyIdentifier> m_annotationTerms;
+	vector<GeneOntologyIdentifier> m_annotationRealTerms;
+	void indexAnnotations();
+
+/** (term, dereferenced term) for the current k-mer */
+	vector<pair<GeneOntologyIdentifier,GeneOntologyIdentifier> > m_kmerTerms;
 	bool m_slaveStarted;
 
 	bool m_loadedAnnotations;
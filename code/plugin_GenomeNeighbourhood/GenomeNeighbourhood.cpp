@@ -46,10 +46,18 @@ __CreateMessageTagAdapter(GenomeNeighbourhood,RAY_MPI_TAG_NEIGHBOURHOOD_DATA); /
 #define FETCH_PARENTS 	0x00345678
 #define FETCH_CHILDREN 	0x01810230
 
+/* steps of a level */
+#define NEIGHBOURHOOD_STEP_VERTICES 0
+#define NEIGHBOURHOOD_STEP_PATHS 1
+#define NEIGHBOURHOOD_STEP_ENTRIES 2
+#define NEIGHBOURHOOD_STEP_DONE 3
+
 void GenomeNeighbourhood::call_RAY_MPI_TAG_NEIGHBOURHOOD_DATA(Message*message){
 	
 	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
-	int position=0;
+	int count=message->getCount();
+
+	int period=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_NEIGHBOURHOOD_DATA);
 
 	/* progressions are on the 'F' strand.
  * if a contig is on the 'R' strand, then the actual position is
@@ -57,491 +65,416 @@ void GenomeNeighbourhood::call_RAY_MPI_TAG_NEIGHBOURHOOD_DATA(Message*message){
  *
  * it is sent this way because only master has the length on contigs
  *
+ * the virtual communicator groups the entries of a rank in a message
  */
-	PathHandle leftContig=incoming[position++];
-	Strand leftVertexStrand=incoming[position++];
-	int leftProgressionInContig=incoming[position++];
+	for(int entry=0;entry+period<=count;entry+=period){
+		int position=entry;
 
-	PathHandle rightContig=incoming[position++];
-	char rightVertexStrand=incoming[position++];
-	int rightProgressionInContig=incoming[position++];
+		PathHandle leftContig=incoming[position++];
+		Strand leftVertexStrand=incoming[position++];
+		int leftProgressionInContig=incoming[position++];
 
-	int gapSizeInKmers=incoming[position++];
+		PathHandle rightContig=incoming[position++];
+		char rightVertexStrand=incoming[position++];
+		int rightProgressionInContig=incoming[position++];
 
-	#ifdef ASSERT
-	assert(gapSizeInKmers >= 1);
-	assert(m_rank==0x00);
-	assert(m_contigLengths->count(leftContig)>0);
-	assert(m_contigLengths->count(rightContig)>0);
-	assert(leftProgressionInContig < m_contigLengths->operator[](leftContig));
-	assert(rightProgressionInContig< m_contigLengths->operator[](rightContig));
-	assert(leftProgressionInContig>=0);
-	assert(rightProgressionInContig>=0);
-	assert(leftVertexStrand=='F' || leftVertexStrand=='R');
-	assert(rightVertexStrand=='F' || rightVertexStrand == 'R');
-	#endif
-
-/*
-	if(rightVertexStrand=='R'){
-		rightProgressionInContig=m_contigLengths->operator[](rightContig)-rightProgressionInContig;
-	}
+		int gapSizeInKmers=incoming[position++];
 
-	// get the position on the actual strand
-	if(leftVertexStrand=='R'){
-		leftProgressionInContig=m_contigLengths->operator[](leftContig)-leftProgressionInContig;
-	}
-*/
-
-	NeighbourPair pair(leftContig,leftVertexStrand,leftProgressionInContig,
-				rightContig,rightVertexStrand,rightProgressionInContig,
-				gapSizeInKmers);
+		#ifdef ASSERT
+		assert(gapSizeInKmers >= 1);
+		assert(m_rank==0x00);
+		assert(m_contigLengths->count(leftContig)>0);
+		assert(m_contigLengths->count(rightContig)>0);
+		assert(leftProgressionInContig < m_contigLengths->operator[](leftContig));
+		assert(rightProgressionInContig< m_contigLengths->operator[](rightContig));
+		assert(leftProgressionInContig>=0);
+		assert(rightProgressionInContig>=0);
+		assert(leftVertexStrand=='F' || leftVertexStrand=='R');
+		assert(rightVertexStrand=='F' || rightVertexStrand == 'R');
+		#endif
 
-	m_finalList.push_back(pair);
+		NeighbourPair pair(leftContig,leftVertexStrand,leftProgressionInContig,
+					rightContig,rightVertexStrand,rightProgressionInContig,
+					gapSizeInKmers);
 
-	int period=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_NEIGHBOURHOOD_DATA);
+		m_finalList.push_back(pair);
+	}
 
-	MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(period*sizeof(MessageUnit));
-	Message aMessage(buffer,period,message->getSource(),RAY_MPI_TAG_NEIGHBOURHOOD_DATA_REPLY,
+	MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(count*sizeof(MessageUnit));
+	Message aMessage(buffer,count,message->getSource(),RAY_MPI_TAG_NEIGHBOURHOOD_DATA_REPLY,
 		m_parameters->getRank());
 
 	m_core->getOutbox()->push_back(aMessage);
 }
 
-void GenomeNeighbourhood::fetchPaths(int mode){
+void GenomeNeighbourhood::clearQueries(){
+	m_queryTags.clear();
+	m_queryDestinations.clear();
+	m_queryContents.clear();
+	m_queryResponses.clear();
+	m_pushedQueries=0;
+	m_receivedQueries=0;
+}
 
-/** stop the search when something is found **/
-/** this will speed things up, but will report less hits because of repeated k-mers **/
+void GenomeNeighbourhood::addQuery(MessageTag tag,Rank destination,MessageUnit*content,int count){
 
-	bool stopWhenSomethingIsFound=true;
+	#ifdef ASSERT
+	assert(count<=NEIGHBOURHOOD_QUERY_STRIDE);
+	#endif
 
-	Kmer currentKmer=m_stackOfVertices.top();
-	int depth=m_stackOfDepths.top();
+	m_queryTags.push_back(tag);
+	m_queryDestinations.push_back(destination);
 
-	Kmer kmer=currentKmer;
+	for(int i=0;i<NEIGHBOURHOOD_QUERY_STRIDE;i++){
+		MessageUnit value=0;
+		if(i<count)
+			value=content[i];
 
-	if(m_reverseStrand){
-		kmer=kmer.complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+		m_queryContents.push_back(value);
 	}
 
-	if(!m_numberOfPathsRequested){
-
-		#ifdef DEBUG_SIDE
-		if(mode==FETCH_PARENTS){
-			cout<<"[DEBUG_SIDE] FETCH_PARENTS RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE"<<endl;
-		}else if(mode==FETCH_CHILDREN){
-			cout<<"[DEBUG_SIDE] FETCH_CHILDREN RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE"<<endl;
-		}
-		#endif
-
-
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Sending RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE"<<endl;
-		#endif
-
-		// send a message to request the links of the current vertex
-		MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(Kmer));
-		int bufferPosition=0;
-		kmer.pack(buffer,&bufferPosition);
-	
-		Rank destination=m_parameters->_vertexRank(&kmer);
-
-		Message aMessage(buffer,m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE),
-			destination,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,m_rank);
-
-		m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
-
-		m_numberOfPathsReceived=false;
+	m_queryResponses.push_back(vector<MessageUnit>());
+}
 
-		// keep up the good work for now
-		m_linksRequested=false;
-		m_linksReceived=false;
+void GenomeNeighbourhood::addVertexQuery(MessageTag tag,Kmer*kmer,int extra){
+	MessageUnit content[NEIGHBOURHOOD_QUERY_STRIDE];
+	int position=0;
+	kmer->pack(content,&position);
 
-		m_numberOfPathsRequested=true;
+	if(extra>=0)
+		content[position++]=extra;
 
-	}else if(!m_numberOfPathsReceived && m_virtualCommunicator->isMessageProcessed(m_workerId)){
+	Rank destination=m_parameters->_vertexRank(kmer);
 
-		vector<MessageUnit> elements;
-		m_virtualCommunicator->getMessageResponseElements(m_workerId,&elements);
+	addQuery(tag,destination,content,position);
+}
 
-		m_paths=elements[0];
+/**
+ * Give the queries to the virtual communicator.
+ * The worker handle of a query is its index.
+ */
+void GenomeNeighbourhood::pushQueries(){
+	int pushed=0;
 
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Received reply for RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE"<<endl;
-		#endif
+	while(m_pushedQueries<(int)m_queryTags.size() && pushed<NEIGHBOURHOOD_QUERIES_PER_CALL){
+		MessageTag tag=m_queryTags[m_pushedQueries];
+		int period=m_virtualCommunicator->getElementsPerQuery(tag);
 
-		#ifdef DEBUG_NEIGHBOURHOOD_PATHS
-		cout<<"Number of paths: "<<m_paths<<" depth: "<<depth<<" useReverse= "<<m_reverseStrand<<endl;
+		#ifdef ASSERT
+		assert(period<=NEIGHBOURHOOD_QUERY_STRIDE);
 		#endif
 
-		m_numberOfPathsReceived=true;
-		m_pathIndex=0;
+		MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(period*sizeof(MessageUnit));
 
-		m_requestedPath=false;
-		m_receivedPath=false;
+		for(int i=0;i<period;i++)
+			buffer[i]=m_queryContents[m_pushedQueries*NEIGHBOURHOOD_QUERY_STRIDE+i];
 
-	}else if(m_numberOfPathsReceived && m_pathIndex == m_paths){
+		Message aMessage(buffer,period,m_queryDestinations[m_pushedQueries],tag,m_rank);
+		m_virtualCommunicator->pushMessage(m_pushedQueries,&aMessage);
 
-		#ifdef DEBUG_NEIGHBOURHOOD_PATHS
-		cout<<"Index completed."<<endl;
-		#endif
+		m_pushedQueries++;
+		pushed++;
+	}
+}
 
-		m_fetchedPaths=true;
+void GenomeNeighbourhood::receiveReplies(){
+	for(int i=0;i<(int)m_activeWorkers.size();i++){
+		WorkerHandle query=m_activeWorkers[i];
 
-	
-		#ifdef DEBUG_SIDE
-		if(mode==FETCH_PARENTS){
-			cout<<"[DEBUG_SIDE] FETCH_PARENTS finished fetching n="<<m_paths<<endl;
-		}else if(mode==FETCH_CHILDREN){
-			cout<<"[DEBUG_SIDE] FETCH_CHILDREN finished fetching n="<<m_paths<<endl;
-		}
-		#endif
+		if(query>=(WorkerHandle)m_queryResponses.size() || !m_queryResponses[query].empty())
+			continue;
 
+		if(!m_virtualCommunicator->isMessageProcessed(query))
+			continue;
 
-	}else if(m_numberOfPathsReceived && !m_requestedPath){
+		m_virtualCommunicator->getMessageResponseElements(query,&(m_queryResponses[query]));
+		m_receivedQueries++;
+	}
+}
 
-		Rank destination=kmer.vertexRank(m_parameters->getSize(),
-			m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+bool GenomeNeighbourhood::hasPendingQueries(){
+	return m_pushedQueries<(int)m_queryTags.size() || m_receivedQueries<(int)m_queryTags.size();
+}
 
-		int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATH);
+/**
+ * Start searches on contig ends until all the slots are used.
+ */
+void GenomeNeighbourhood::startSearches(){
 
-		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery);
+	while((int)m_searches.size()<NEIGHBOURHOOD_MAXIMUM_SEARCHES && m_nextSide<2*(int)m_contigs->size()){
 
-		int outputPosition=0;
-		kmer.pack(message,&outputPosition);
-		message[outputPosition++]=m_pathIndex;
+		int contigIndex=m_nextSide/2;
+		int contigLength=m_contigs->at(contigIndex).size();
 
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Sending RAY_MPI_TAG_ASK_VERTEX_PATH"<<endl;
+		#ifdef ASSERT
+		assert(contigLength>=1);
 		#endif
 
-		Message aMessage(message,elementsPerQuery,destination,
-			RAY_MPI_TAG_ASK_VERTEX_PATH,m_parameters->getRank());
-
-		m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
-
-		m_requestedPath=true;
-		m_receivedPath=false;
+		int mode=FETCH_PARENTS;
+		Kmer kmer=m_contigs->at(contigIndex).at(0);
 
-	}else if(m_numberOfPathsReceived && !m_receivedPath && m_virtualCommunicator->isMessageProcessed(m_workerId)){
-		vector<MessageUnit> response;
-		m_virtualCommunicator->getMessageResponseElements(m_workerId,&response);
+		if(m_nextSide%2==1){
+			mode=FETCH_CHILDREN;
+			kmer=m_contigs->at(contigIndex).at(contigLength-1);
 
-		int bufferPosition=0;
-
-		/* skip the k-mer because we don't need it */
-		bufferPosition+=KMER_U64_ARRAY_SIZE;
-		PathHandle pathIdentifier=response[bufferPosition++];
-		int progression=response[bufferPosition++];
+		}else if(contigIndex%1000==0){
+			cout<<"Rank "<<m_rank<<" is fetching contig path neighbours ["<<contigIndex<<"/"<<m_contigs->size()<<"]"<<endl;
+		}
 
-		
-		int minimumDepth=1;
+		m_searches.push_back(NeighbourhoodSearch());
+		m_searches.back().constructor(contigIndex,mode,&kmer);
 
-		#ifdef DEBUG_NEIGHBOURHOOD_PATHS
-		cout<<"Received path mode=";
+		#ifdef DEBUG_SIDE
 		if(mode==FETCH_PARENTS){
-			cout<<"FETCH_PARENTS";
-		}else{
-			cout<<"FETCH_CHILDREN";
+			cout<<"Starting mode FETCH_PARENTS"<<endl;
+		}else if(mode==FETCH_CHILDREN){
+			cout<<"Starting mode FETCH_CHILDREN"<<endl;
 		}
-		cout<<" path is "<<pathIdentifier<<endl;
 		#endif
 
-		/** add the path **/
-
-		if(pathIdentifier != (*m_contigNames)[m_contigIndex]
-			//&& m_foundContigs.count(pathIdentifier)==0
-			&& depth >= minimumDepth){
+		m_nextSide++;
+	}
+}
 
-			char strand='F';
-			if(m_reverseStrand){
-				strand='R';
-			}
+/**
+ * Request the edges and the number of paths of every vertex in the
+ * frontiers.
+ */
+void GenomeNeighbourhood::startLevel(){
 
-			Neighbour friendlyNeighbour(strand,depth,pathIdentifier,progression);
-		
-			if(stopWhenSomethingIsFound){
-				m_foundPathsForThisVertex=true;
-			}
+	startSearches();
 
-			if(mode==FETCH_PARENTS){
-				m_leftNeighbours.push_back(friendlyNeighbour);
+	clearQueries();
 
-			}else if(mode == FETCH_CHILDREN){
+	m_levelSearches.clear();
+	m_levelVertices.clear();
+	m_levelEdgeQueries.clear();
+	m_levelPathCountQueries.clear();
 
-				m_rightNeighbours.push_back(friendlyNeighbour);
-			}
+	/* all the contig ends were searched, send the entries to master */
+	if(m_searches.empty()){
 
-			m_foundContigs.insert(pathIdentifier);
+		for(int i=0;i<(int)m_entries.size();i+=NEIGHBOURHOOD_ENTRY_SIZE){
+			addQuery(RAY_MPI_TAG_NEIGHBOURHOOD_DATA,MASTER_RANK,&(m_entries[i]),NEIGHBOURHOOD_ENTRY_SIZE);
 		}
 
-		m_pathIndex++;
-
-		m_receivedPath=true;
+		m_step=NEIGHBOURHOOD_STEP_ENTRIES;
 
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Received reply for RAY_MPI_TAG_ASK_VERTEX_PATH"<<endl;
-		#endif
-
-		m_requestedPath=false;
-		m_receivedPath=false;
+		pushQueries();
+		return;
 	}
-}
 
-void GenomeNeighbourhood::processLinks(int mode){
+	for(int i=0;i<(int)m_searches.size();i++){
+		NeighbourhoodSearch*search=&(m_searches[i]);
 
-	#ifdef ASSERT
-	assert(!m_stackOfVertices.empty());
-	assert(m_stackOfVertices.size() == m_stackOfDepths.size());
-	#endif
+		for(int j=0;j<(int)search->m_frontier.size();j++){
+			Kmer kmer=search->m_frontier[j];
 
-	Kmer currentKmer=m_stackOfVertices.top();
-	int depth=m_stackOfDepths.top();
+			m_levelSearches.push_back(i);
+			m_levelVertices.push_back(kmer);
 
-	if(!m_directDone){
-		if(!m_fetchedPaths){
+			int edgeQuery=-1;
 
-			fetchPaths(mode);
-		}else{
-		
-			#ifdef DEBUG_SIDE
-			if(mode==FETCH_PARENTS){
-				cout<<"[DEBUG_SIDE] Fetched direct paths for mode FETCH_PARENTS, n="<<m_paths<<endl;
-			}else if(mode==FETCH_CHILDREN){
-				cout<<"[DEBUG_SIDE] Fetched direct paths for mode FETCH_CHILDREN, n="<<m_paths<<endl;
+			if(search->m_depth<m_maximumDepth){
+				edgeQuery=m_queryTags.size();
+				addVertexQuery(RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,&kmer,-1);
 			}
-			#endif
-
 
-			#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-			cout<<"m_directDone= True"<<endl;
-			#endif
-
-			m_directDone=true;
-			m_fetchedPaths=false;
-			m_numberOfPathsRequested=false;
-			m_numberOfPathsReceived=false;
+			m_levelEdgeQueries.push_back(edgeQuery);
 
-			m_reverseDone=false;
+			int pathCountQuery=-1;
 
-			m_reverseStrand=true;
+			/* the first vertex is on the contig */
+			if(search->m_depth>=1){
+				pathCountQuery=m_queryTags.size();
 
-		}
-/**/
-	}else if(!m_reverseDone){
-		if(!m_fetchedPaths){
+				addVertexQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,&kmer,-1);
 
-			fetchPaths(mode);
-
-		}else{
-			
-			#ifdef DEBUG_SIDE
-			if(mode==FETCH_PARENTS){
-				cout<<"[DEBUG_SIDE] Fetched reverse paths for mode FETCH_PARENTS, n="<<m_paths<<endl;
-			}else if(mode==FETCH_CHILDREN){
-				cout<<"[DEBUG_SIDE] Fetched reverse paths for mode FETCH_CHILDREN, n="<<m_paths<<endl;
+				Kmer reverseComplement=kmer.complementVertex(m_parameters->getWordSize(),
+					m_parameters->getColorSpaceMode());
+				addVertexQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,&reverseComplement,-1);
 			}
-			#endif
 
-		
-			#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-			cout<<"m_reverseDone= True"<<endl;
-			#endif
-	
-			m_reverseDone=true;
+			m_levelPathCountQueries.push_back(pathCountQuery);
 		}
-/**/
-
-	}else if(m_fetchedPaths && !m_linksRequested){
-
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Sending message RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT to "<<endl;
-		#endif
-
-		// send a message to request the links of the current vertex
-		MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(Kmer));
-		int bufferPosition=0;
-		currentKmer.pack(buffer,&bufferPosition);
-	
-		Rank destination=m_parameters->_vertexRank(&currentKmer);
-
-		Message aMessage(buffer,m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT),
-			destination,RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,m_rank);
-
-		m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
+	}
 
-		m_linksRequested=true;
-		m_linksReceived=false;
+	m_step=NEIGHBOURHOOD_STEP_VERTICES;
 
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Message sent, RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT, will wait for a reply "<<endl;
-		#endif
+	pushQueries();
+}
 
-	}else if(m_fetchedPaths &&
-		!m_linksReceived && m_virtualCommunicator->isMessageProcessed(m_workerId)){
+/**
+ * Request the paths of the vertices of the level, on both strands.
+ */
+void GenomeNeighbourhood::requestPaths(){
 
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"Message received, RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT"<<endl;
-		#endif
+	int vertices=m_levelVertices.size();
 
-		vector<MessageUnit> elements;
-		m_virtualCommunicator->getMessageResponseElements(m_workerId,&elements);
+	m_levelEdges.assign(vertices,0);
+	m_levelHits.assign(vertices,false);
 
-		#ifdef ASSERT
-		assert((int)elements.size()>=2);
-		#endif
+	vector<int> pathCounts(2*vertices,0);
 
-		uint8_t edges=elements[0];
+	for(int i=0;i<vertices;i++){
+		int edgeQuery=m_levelEdgeQueries[i];
 
-		#ifdef ASSERT
-		int coverage=elements[1];
-		assert(coverage>0);
-		#endif
+		if(edgeQuery!=-1){
+			#ifdef ASSERT
+			assert((int)m_queryResponses[edgeQuery].size()>=2);
+			assert(m_queryResponses[edgeQuery][1]>0);
+			#endif
 
-		vector<Kmer> parents=currentKmer._getIngoingEdges(edges,m_parameters->getWordSize());
-		vector<Kmer> children=currentKmer._getOutgoingEdges(edges,m_parameters->getWordSize());
+			m_levelEdges[i]=m_queryResponses[edgeQuery][0];
+		}
 
-		#ifdef DEBUG_NEIGHBOURHOOD_COMMUNICATION
-		cout<<"information: "<<parents.size()<<" parents, "<<children.size()<<" children"<<endl;
-		#endif
+		int pathCountQuery=m_levelPathCountQueries[i];
 
-		int nextDepth=depth+1;
+		if(pathCountQuery!=-1){
+			pathCounts[2*i]=m_queryResponses[pathCountQuery][0];
+			pathCounts[2*i+1]=m_queryResponses[pathCountQuery+1][0];
+		}
+	}
 
-		// remove the current vertex from the stack
-		m_stackOfVertices.pop();
-		m_stackOfDepths.pop();
+	clearQueries();
 
-		m_visited.insert(currentKmer);
+	m_pathQueryVertices.clear();
+	m_pathQueryStrands.clear();
 
-		// add new links
-		
-		vector<Kmer>*links=&parents;
+	for(int i=0;i<vertices;i++){
+		for(int strand=0;strand<2;strand++){
+			Kmer kmer=m_levelVertices[i];
+			Strand dnaStrand='F';
 
-		#ifdef ASSERT
-		assert(mode==FETCH_CHILDREN || mode==FETCH_PARENTS);
-		#endif
+			if(strand==1){
+				kmer=kmer.complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+				dnaStrand='R';
+			}
 
-		if(mode==FETCH_CHILDREN){
-			links=&children;
+			for(int pathIndex=0;pathIndex<pathCounts[2*i+strand];pathIndex++){
+				m_pathQueryVertices.push_back(i);
+				m_pathQueryStrands.push_back(dnaStrand);
 
-		}else if(mode==FETCH_PARENTS){
-			links=&parents;
+				addVertexQuery(RAY_MPI_TAG_ASK_VERTEX_PATH,&kmer,pathIndex);
+			}
 		}
+	}
 
-		#ifdef ASSERT
-		assert(m_stackOfDepths.size()==m_stackOfVertices.size());
-		#endif
-
-		/** we don't continue if we found something interesting... **/
-
-		for(int i=0;i<(int)links->size();i++){
+	m_step=NEIGHBOURHOOD_STEP_PATHS;
 
-			#ifdef ASSERT
-			assert(i<(int) links->size());
-			#endif
+	pushQueries();
+}
 
-			Kmer newKmer=links->at(i);
+/**
+ * Record the neighbours and build the next frontiers.
+ *
+ * The links of a vertex where another contig was found are not
+ * followed.
+ */
+void GenomeNeighbourhood::expandFrontiers(){
 
-			if(nextDepth<= m_maximumDepth && m_visited.count(newKmer)==0
+	for(int i=0;i<(int)m_pathQueryVertices.size();i++){
+		vector<MessageUnit>*response=&(m_queryResponses[i]);
 
-				&& !m_foundPathsForThisVertex){ /* avoid exploring too much when something is already on the table **/
-		
-				m_stackOfVertices.push(newKmer);
-				m_stackOfDepths.push(nextDepth);
-			}
-		}
+		/* skip the k-mer because we don't need it */
+		int bufferPosition=KMER_U64_ARRAY_SIZE;
+		PathHandle pathIdentifier=response->at(bufferPosition++);
+		int progression=response->at(bufferPosition++);
 
-		m_linksReceived=true;
+		int vertex=m_pathQueryVertices[i];
+		NeighbourhoodSearch*search=&(m_searches[m_levelSearches[vertex]]);
 
-	}else if(m_fetchedPaths && m_linksRequested && m_linksReceived){
-		
-		// restart the adventure
+		if(pathIdentifier==(*m_contigNames)[search->m_contigIndex])
+			continue;
 
-		resetKmerStates();
+		Neighbour friendlyNeighbour(m_pathQueryStrands[i],search->m_depth,pathIdentifier,progression);
+		search->m_neighbours.push_back(friendlyNeighbour);
 
+		m_levelHits[vertex]=true;
 	}
-}
 
-void GenomeNeighbourhood::processSide(int mode){
-
-	#ifdef ASSERT
-	assert(mode==FETCH_CHILDREN || mode==FETCH_PARENTS);
-	#endif
-
-	if(!m_startedSide){
-
-		#ifdef ASSERT
-		assert(m_contigIndex < (int)m_contigs->size());
-		#endif
+	for(int i=0;i<(int)m_levelVertices.size();i++){
+		if(m_levelHits[i] || m_levelEdgeQueries[i]==-1)
+			continue;
 
-		int contigLength=m_contigs->at(m_contigIndex).size();
+		NeighbourhoodSearch*search=&(m_searches[m_levelSearches[i]]);
+		Kmer*kmer=&(m_levelVertices[i]);
 
 		#ifdef ASSERT
-		assert(contigLength>=1);
+		assert(search->m_mode==FETCH_CHILDREN || search->m_mode==FETCH_PARENTS);
 		#endif
 
-		Kmer kmer;
+		vector<Kmer> links;
 
-		if(mode==FETCH_CHILDREN){
-			kmer=m_contigs->at(m_contigIndex).at(contigLength-1);
-
-		}else if(mode==FETCH_PARENTS){
+		if(search->m_mode==FETCH_CHILDREN){
+			links=kmer->_getOutgoingEdges(m_levelEdges[i],m_parameters->getWordSize());
+		}else{
+			links=kmer->_getIngoingEdges(m_levelEdges[i],m_parameters->getWordSize());
+		}
 
-			kmer=m_contigs->at(m_contigIndex).at(0);
+		for(int j=0;j<(int)links.size();j++){
+			if(search->visit(&(links[j])))
+				search->m_nextFrontier.push_back(links[j]);
 		}
+	}
 
-		createStacks(kmer);
+	/* the last searches are moved in the slots of the finished ones */
+	for(int i=(int)m_searches.size()-1;i>=0;i--){
+		NeighbourhoodSearch*search=&(m_searches[i]);
 
-		resetKmerStates();
+		search->m_frontier.swap(search->m_nextFrontier);
+		search->m_nextFrontier.clear();
+		search->m_depth++;
 
-		m_visited.clear();
-		m_foundContigs.clear();
+		if(!search->m_frontier.empty())
+			continue;
 
-/* the maximum depth
- * values are 1024, 2048 or 4096 */
-		m_maximumDepth=1024;
+		finishSearch(search);
 
-		m_startedSide=true;
+		if(i!=(int)m_searches.size()-1)
+			m_searches[i]=m_searches.back();
 
-		#ifdef DEBUG_SIDE
-		if(mode==FETCH_PARENTS){
-			cout<<"Starting mode FETCH_PARENTS"<<endl;
-		}else if(mode==FETCH_CHILDREN){
-			cout<<"Starting mode FETCH_CHILDREN"<<endl;
-		}
-		#endif
+		m_searches.pop_back();
+	}
+}
 
-	}else if(!m_stackOfVertices.empty()){
-		
-		processLinks(mode);
+/**
+ * Keep the selected neighbours of a contig end as entries for master.
+ */
+void GenomeNeighbourhood::finishSearch(NeighbourhoodSearch*search){
 
-	}else{
-		m_doneSide=true;
-	}
+	selectHits(&(search->m_neighbours));
 
-}
+	PathHandle contigName=m_contigNames->at(search->m_contigIndex);
+	int contigLength=m_contigs->at(search->m_contigIndex).size();
 
-void GenomeNeighbourhood::resetKmerStates(){
-	m_numberOfPathsRequested=false;
-	m_numberOfPathsReceived=false;
-	m_fetchedPaths=false;
-	m_directDone=false;
-	m_reverseDone=false;
+	for(int i=0;i<(int)search->m_neighbours.size();i++){
+		Neighbour*neighbour=&(search->m_neighbours[i]);
 
-	m_reverseStrand=false;
+		if(search->m_mode==FETCH_PARENTS){
+			m_entries.push_back(neighbour->getContig());
+			m_entries.push_back(neighbour->getStrand());
+			m_entries.push_back(neighbour->getProgression());
 
-	m_foundPathsForThisVertex=false;
-}
+			m_entries.push_back(contigName);
+			m_entries.push_back('F');
+			m_entries.push_back(0);
+		}else{
+			m_entries.push_back(contigName);
+			m_entries.push_back('F');
+			m_entries.push_back(contigLength-1);
 
-void GenomeNeighbourhood::createStacks(Kmer a){
-	while(!m_stackOfVertices.empty()){
-		m_stackOfVertices.pop();
-	}
-	while(!m_stackOfDepths.empty()){
-		m_stackOfDepths.pop();
+			m_entries.push_back(neighbour->getContig());
+			m_entries.push_back(neighbour->getStrand());
+			m_entries.push_back(neighbour->getProgression());
+		}
+
+		m_entries.push_back(neighbour->getDepth());
 	}
 
-	m_stackOfVertices.push(a);
-	m_stackOfDepths.push(0);
+	#ifdef DEBUG_LEFT_PATHS
+	cout<<"[DEBUG_LEFT_PATHS] processed paths: "<<search->m_neighbours.size()<<endl;
+	#endif
 }
 
 void GenomeNeighbourhood::processFinalList(){
@@ -701,96 +634,49 @@ void GenomeNeighbourhood::call_RAY_MASTER_MODE_NEIGHBOURHOOD(){
 	}
 }
 
-void GenomeNeighbourhood::selectHits(){
+void GenomeNeighbourhood::selectHits(vector<Neighbour>*neighbours){
 	/** we have all the neighbours, unfiltered... **/
-	/* process neighbours */
-
-	map<PathHandle,int> leftMinimums;
-	map<PathHandle,int> leftMaximums;
-	map<PathHandle,int> rightMinimums;
-	map<PathHandle,int> rightMaximums;
+	/* keep the first and the last positions on each contig */
 
-	for(int i=0;i<(int)m_leftNeighbours.size();i++){
-		PathHandle contig=m_leftNeighbours[i].getContig();
-		int progression=m_leftNeighbours[i].getProgression();
+	map<PathHandle,int> minimums;
+	map<PathHandle,int> maximums;
 
-		if(leftMinimums.count(contig)==0 || progression < leftMinimums[contig]){
-			leftMinimums[contig]=progression;
-		}
+	for(int i=0;i<(int)neighbours->size();i++){
+		PathHandle contig=neighbours->at(i).getContig();
+		int progression=neighbours->at(i).getProgression();
 
-		if(leftMaximums.count(contig)==0 || progression > leftMaximums[contig]){
-			leftMaximums[contig]=progression;
+		if(minimums.count(contig)==0 || progression < minimums[contig]){
+			minimums[contig]=progression;
 		}
 
-	}
-
-	for(int i=0;i<(int)m_rightNeighbours.size();i++){
-		PathHandle contig=m_rightNeighbours[i].getContig();
-		int progression=m_rightNeighbours[i].getProgression();
-
-		if(rightMinimums.count(contig)==0 || progression < rightMinimums[contig]){
-			rightMinimums[contig]=progression;
+		if(maximums.count(contig)==0 || progression > maximums[contig]){
+			maximums[contig]=progression;
 		}
-
-		if(rightMaximums.count(contig)==0 || progression > rightMaximums[contig]){
-			rightMaximums[contig]=progression;
-		}
-	}
-
-	vector<Neighbour> leftNeighbours;
-
-	for(int i=0;i<(int)m_leftNeighbours.size();i++){
-		PathHandle contig=m_leftNeighbours[i].getContig();
-		int progression=m_leftNeighbours[i].getProgression();
-
-		if(progression!=leftMinimums[contig] && progression != leftMaximums[contig]){
-			continue;
-		}
-
-		leftNeighbours.push_back(m_leftNeighbours[i]);
-
-		#ifdef DEBUG_NEIGHBOUR_LISTING
-		cout<<"[GenomeNeighbourhood] ITEM LEFT ";
-
-		cout<<"contig-"<<m_leftNeighbours[i].getContig()<<" "<<m_leftNeighbours[i].getStrand();
-		cout<<" "<<m_leftNeighbours[i].getProgression()<<"(TODO) ";
-
-		cout<<" contig-"<<contigName<<" "<<contigStrand<<" 0 ";
-
-		cout<<m_leftNeighbours[i].getDepth()<<endl;
-		
-		#endif
 	}
 
-	m_leftNeighbours=leftNeighbours;
-
-	vector<Neighbour> rightNeighbours;
+	vector<Neighbour> selectedNeighbours;
 
-	for(int i=0;i<(int)m_rightNeighbours.size();i++){
+	for(int i=0;i<(int)neighbours->size();i++){
+		PathHandle contig=neighbours->at(i).getContig();
+		int progression=neighbours->at(i).getProgression();
 
-		PathHandle contig=m_rightNeighbours[i].getContig();
-		int progression=m_rightNeighbours[i].getProgression();
-
-		if(progression!=rightMinimums[contig] && progression != rightMaximums[contig]){
+		if(progression!=minimums[contig] && progression != maximums[contig]){
 			continue;
 		}
 
-		rightNeighbours.push_back(m_rightNeighbours[i]);
+		selectedNeighbours.push_back(neighbours->at(i));
 
 		#ifdef DEBUG_NEIGHBOUR_LISTING
-		cout<<"[GenomeNeighbourhood] ITEM RIGHT ";
-
-		cout<<"contig-"<<contigName<<" "<<contigStrand<<" "<<contigLength-1;
+		cout<<"[GenomeNeighbourhood] ITEM ";
 
-		cout<<" contig-"<<m_rightNeighbours[i].getContig()<<" "<<m_rightNeighbours[i].getStrand();
-		cout<<" "<<m_rightNeighbours[i].getProgression()<<"(TODO) ";
+		cout<<"contig-"<<neighbours->at(i).getContig()<<" "<<neighbours->at(i).getStrand();
+		cout<<" "<<neighbours->at(i).getProgression()<<" ";
 
-		cout<<m_rightNeighbours[i].getDepth()<<endl;
+		cout<<neighbours->at(i).getDepth()<<endl;
 		#endif
 	}
 
-	m_rightNeighbours=rightNeighbours;
-
+	*neighbours=selectedNeighbours;
 }
 
 /**
@@ -802,7 +688,8 @@ void GenomeNeighbourhood::selectHits(){
  *
  * each item is (leftContig	strand	rightContig	strand	verticesInGap)
  *
- * to do so, do a depth first search with a maximum depth
+ * to do so, do a breadth-first search with a maximum depth from
+ * each contig end, NEIGHBOURHOOD_MAXIMUM_SEARCHES at a time
  *
  *
  * message used and what is needed:
@@ -828,8 +715,8 @@ void GenomeNeighbourhood::selectHits(){
  *      output: the length of the path, measured in k-mers
  *
  *
- * prototype 1: don't use Message Multiplexing, because the thing may be fast without it
- *              like scaffolding.
+ * all the queries of a level are pushed at once in the virtual
+ * communicator, which groups them by destination.
  */
 void GenomeNeighbourhood::call_RAY_SLAVE_MODE_NEIGHBOURHOOD(){
 
@@ -845,232 +732,57 @@ void GenomeNeighbourhood::call_RAY_SLAVE_MODE_NEIGHBOURHOOD(){
 	/* force flush everything ! */
 	m_virtualCommunicator->forceFlush();
 	m_virtualCommunicator->processInbox(&m_activeWorkers);
+	receiveReplies();
 	m_activeWorkers.clear();
 
 
 	if(!m_slaveStarted){
 
-		m_contigIndex=0;
+		m_nextSide=0;
+		m_searches.clear();
+		m_entries.clear();
+
+		m_maximumDepth=NEIGHBOURHOOD_MAXIMUM_DEPTH;
 
-		m_doneLeftSide=false;
-		m_startedLeft=false;
-		m_doneRightSide=false;
-		m_startedRight=false;
-	
 		m_slaveStarted=true;
 
 		m_virtualCommunicator->resetCounters();
 
-	}else if(m_contigIndex<(int)m_contigs->size()){ /* there is still work to do */
+		startLevel();
 
-/*
-		PathHandle contigName=m_contigNames->at(m_contigIndex);
-		Strand contigStrand='F';
-		int contigLength=m_contigs->at(m_contigIndex).size();
-*/
-
-		// left side
-		if(!m_doneLeftSide){
-	
-			if(!m_startedLeft){
-
-				cout<<"Rank "<<m_rank<<" is fetching contig path neighbours ["<<m_contigIndex<<"/"<<m_contigs->size()<<"]"<<endl;
+	}else if(hasPendingQueries()){
 
-				m_startedLeft=true;
-				m_startedSide=false;
-				m_doneSide=false;
+		pushQueries();
 
+	}else if(m_step==NEIGHBOURHOOD_STEP_VERTICES){
 
-				m_leftNeighbours.clear();
-				m_rightNeighbours.clear();
-
-			}else if(!m_doneSide){
-				processSide(FETCH_PARENTS);
-			}else{
-				m_doneLeftSide=true;
-			}
-
-		// right side
-		}else if(!m_doneRightSide){
-		
-			if(!m_startedRight){
-				m_startedRight=true;
-				m_startedSide=false;
-				m_doneSide=false;
-			}else if(!m_doneSide){
-
-				processSide(FETCH_CHILDREN);
-			}else{
-				m_doneRightSide=true;
-				m_selectedHits=false;
-			}
+		requestPaths();
 
+	}else if(m_step==NEIGHBOURHOOD_STEP_PATHS){
 
-		}else if(!m_selectedHits){
+		expandFrontiers();
 
-			selectHits();
+		/* continue the work */
+		startLevel();
 
-			m_selectedHits=true;
-			m_sentLeftNeighbours=false;
-			m_neighbourIndex=0;
-			m_sentEntry=false;
-			m_receivedReply=false;
+	}else if(m_step==NEIGHBOURHOOD_STEP_ENTRIES){
 
-		}else if(!m_sentLeftNeighbours){
-
-			sendLeftNeighbours();
-
-		}else if(!m_sentRightNeighbours){
-
-			sendRightNeighbours();
-
-		}else{
-
-			/* continue the work */
-			m_contigIndex++;
-
-			m_doneLeftSide=false;
-			m_startedLeft=false;
-			m_doneRightSide=false;
-			m_startedRight=false;
-		}
-	}else{
-
-		cout<<"Rank "<<m_rank<<" is fetching contig path neighbours ["<<m_contigIndex<<"/"<<m_contigs->size()<<"]"<<endl;
+		cout<<"Rank "<<m_rank<<" is fetching contig path neighbours ["<<m_contigs->size()<<"/"<<m_contigs->size()<<"]"<<endl;
 
 		#ifdef ASSERT
-		assert(m_contigIndex == (int)m_contigs->size());
+		assert(m_nextSide == 2*(int)m_contigs->size());
+		assert(m_searches.empty());
 		#endif
 
+		m_entries.clear();
+		m_step=NEIGHBOURHOOD_STEP_DONE;
+
 		m_virtualCommunicator->printStatistics();
 
 		m_core->getSwitchMan()->closeSlaveModeLocally(m_core->getOutbox(),m_core->getMessagesHandler()->getRank());
 	}
 }
 
-void GenomeNeighbourhood::sendRightNeighbours(){
-
-	if(m_neighbourIndex < (int)m_rightNeighbours.size()){
-
-		if(!m_sentEntry){
-			m_sentEntry=true;
-
-			// send a message to request the links of the current vertex
-			MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(Kmer));
-
-			Rank destination=0x0;
-			int period=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_NEIGHBOURHOOD_DATA);
-
-			#ifdef ASSERT
-			assert(period > 0);
-			#endif
-
-			int outputPosition=0;
-
-			buffer[outputPosition++]=m_contigNames->at(m_contigIndex);
-			buffer[outputPosition++]='F';
-			buffer[outputPosition++]=m_contigs->at(m_contigIndex).size()-1;
-
-			buffer[outputPosition++]=m_rightNeighbours[m_neighbourIndex].getContig();
-			buffer[outputPosition++]=m_rightNeighbours[m_neighbourIndex].getStrand();
-			buffer[outputPosition++]=m_rightNeighbours[m_neighbourIndex].getProgression();
-
-			buffer[outputPosition++]=m_rightNeighbours[m_neighbourIndex].getDepth();
-
-			Message aMessage(buffer,period,
-				destination,RAY_MPI_TAG_NEIGHBOURHOOD_DATA,m_rank);
-
-			m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
-
-			m_receivedReply=false;
-
-		}else if(!m_receivedReply && m_virtualCommunicator->isMessageProcessed(m_workerId)){
-
-			vector<MessageUnit> elements;
-			m_virtualCommunicator->getMessageResponseElements(m_workerId,&elements);
-
-
-			m_receivedReply=true;
-			m_sentEntry=false;
-
-			m_neighbourIndex++;
-		}
-
-
-	}else{
-
-		#ifdef DEBUG_LEFT_PATHS
-		cout<<"[DEBUG_LEFT_PATHS] processed left paths: "<<m_leftNeighbours.size()<<endl;
-		#endif
-
-
-		m_sentRightNeighbours=true;
-
-	}
-}
-
-void GenomeNeighbourhood::sendLeftNeighbours(){
-
-	if(m_neighbourIndex< (int)m_leftNeighbours.size()){
-		if(!m_sentEntry){
-			m_sentEntry=true;
-
-			// send a message to request the links of the current vertex
-			MessageUnit*buffer=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(Kmer));
-
-			Rank destination=0x0;
-			int period=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_NEIGHBOURHOOD_DATA);
-
-			#ifdef ASSERT
-			assert(period > 0);
-			#endif
-
-			int outputPosition=0;
-
-			buffer[outputPosition++]=m_leftNeighbours[m_neighbourIndex].getContig();
-			buffer[outputPosition++]=m_leftNeighbours[m_neighbourIndex].getStrand();
-			buffer[outputPosition++]=m_leftNeighbours[m_neighbourIndex].getProgression();
-
-			buffer[outputPosition++]=m_contigNames->at(m_contigIndex);
-			buffer[outputPosition++]='F';
-			buffer[outputPosition++]=0;
-
-			buffer[outputPosition++]=m_leftNeighbours[m_neighbourIndex].getDepth();
-
-			Message aMessage(buffer,period,
-				destination,RAY_MPI_TAG_NEIGHBOURHOOD_DATA,m_rank);
-
-			m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
-
-			m_receivedReply=false;
-
-		}else if(!m_receivedReply && m_virtualCommunicator->isMessageProcessed(m_workerId)){
-
-			vector<MessageUnit> elements;
-			m_virtualCommunicator->getMessageResponseElements(m_workerId,&elements);
-
-
-			m_receivedReply=true;
-			m_sentEntry=false;
-
-			m_neighbourIndex++;
-		}
-	}else{
-
-		#ifdef DEBUG_LEFT_PATHS
-		cout<<"[DEBUG_LEFT_PATHS] processed left paths: "<<m_leftNeighbours.size()<<endl;
-		#endif
-
-		m_sentLeftNeighbours=true;
-		m_sentRightNeighbours=false;
-		m_sentEntry=false;
-		m_receivedReply=false;
-
-		m_neighbourIndex=0;
-	}
-
-}
-
 /**
  * register the plugin
  * */
@@ -1138,7 +850,7 @@ void GenomeNeighbourhood::resolveSymbols(ComputeCore*core){
 
 	// fetch parallel shared objects
 	m_timePrinter=(TimePrinter*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Timer.ray");
-	m_contigs=(vector<vector<Kmer> >*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/ContigPaths.ray");
+	m_contigs=(vector<ContigPath>*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/ContigPaths.ray");
 	m_contigNames=(vector<PathHandle>*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/ContigNames.ray");
 	m_parameters=(Parameters*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/Parameters.ray");
 	m_contigLengths=(map<PathHandle,int>*)core->getObjectFromSymbol(m_plugin,"/RayAssembler/ObjectStore/ContigLengths.ray");
@@ -1151,7 +863,6 @@ void GenomeNeighbourhood::resolveSymbols(ComputeCore*core){
 
 	m_rank=core->getMessagesHandler()->getRank();
 	m_outboxAllocator=core->getOutboxAllocator();
-	m_workerId=0;
 
 	m_slaveStarted=false;
 
@@ -30,6 +30,7 @@
 #include <plugins/CorePlugin.h>
 #include <plugin_GenomeNeighbourhood/Neighbour.h>
 #include <plugin_GenomeNeighbourhood/NeighbourPair.h>
+#include <plugin_GenomeNeighbourhood/NeighbourhoodSearch.h>
 #include <plugin_KmerAcademyBuilder/Kmer.h>
 #include <communication/VirtualCommunicator.h>
 #include <application_core/Parameters.h>
@@ -37,9 +38,22 @@
 #include <vector>
 #include <string>
 #include <stdint.h> /* for uint64_t */
-#include <stack>
 using namespace std;
 
+/* values are 1024, 2048 or 4096 */
+#define NEIGHBOURHOOD_MAXIMUM_DEPTH 1024
+
+/** contig ends that are searched at the same time on a rank **/
+#define NEIGHBOURHOOD_MAXIMUM_SEARCHES 512
+
+/** queries given to the virtual communicator in one call **/
+#define NEIGHBOURHOOD_QUERIES_PER_CALL 4096
+
+#define NEIGHBOURHOOD_QUERY_STRIDE (KMER_U64_ARRAY_SIZE+7)
+
+/* contig1, strand1, position1, contig2, strand2, position2, gap size */
+#define NEIGHBOURHOOD_ENTRY_SIZE 7
+
 
 /**
  * The plugin GenomeNeighbourhood outputs a file file
@@ -48,6 +62,11 @@ using namespace std;
  * This is useful to know where is located a drug-resistance gene,
  * amongst other things.
  *
+ * Each contig end is the start of a breadth-first search in the
+ * distributed de Bruijn graph. All the searches of a rank advance one
+ * level at a time, and the queries for a whole level are given to the
+ * virtual communicator together so that they are grouped by destination.
+ *
  * \author Sébastien Boisvert
  * \
  * */
@@ -56,45 +75,47 @@ class GenomeNeighbourhood: public CorePlugin{
 	bool m_pluginIsEnabled;
 	Parameters*m_parameters;
 
-	stack<Kmer> m_stackOfVertices;
-	stack<int> m_stackOfDepths;
-
 /** states of the state machine */
-	int m_contigIndex;
 	bool m_started;
 	bool m_slaveStarted;
-	bool m_doneLeftSide;
-	bool m_doneRightSide;
-	bool m_startedLeft;
-	bool m_startedRight;
-
-	bool m_doneSide;
-	bool m_startedSide;
+	int m_step;
 
 	/* graph surfing */
-	set<Kmer> m_visited;
-	set<PathHandle > m_foundContigs;
 	int m_maximumDepth;
-	bool m_linksRequested;
-	bool m_linksReceived;
-	int m_paths;
-	bool m_foundPathsForThisVertex;
-	int m_pathIndex;
-	bool m_numberOfPathsRequested;
-	bool m_numberOfPathsReceived;
-	bool m_fetchedPaths;
-	bool m_receivedPath;
-	bool m_requestedPath;
-	bool m_reverseStrand;
-	
-	bool m_directDone;
-	bool m_reverseDone;
+
+/** the next contig end to search, 2 per contig **/
+	int m_nextSide;
+
+	vector<NeighbourhoodSearch> m_searches;
+
+/** vertices of the current level of all the searches **/
+	vector<int> m_levelSearches;
+	vector<Kmer> m_levelVertices;
+	vector<int> m_levelEdgeQueries;
+	vector<int> m_levelPathCountQueries;
+	vector<uint8_t> m_levelEdges;
+	vector<bool> m_levelHits;
+
+/** path queries of the current level **/
+	vector<int> m_pathQueryVertices;
+	vector<Strand> m_pathQueryStrands;
+
+/** queries of the current step, the index is the worker handle
+ * given to the virtual communicator **/
+	vector<MessageTag> m_queryTags;
+	vector<Rank> m_queryDestinations;
+	vector<MessageUnit> m_queryContents;
+	vector<vector<MessageUnit> > m_queryResponses;
+	int m_pushedQueries;
+	int m_receivedQueries;
+
+/** entries for master, NEIGHBOURHOOD_ENTRY_SIZE elements each **/
+	vector<MessageUnit> m_entries;
 
 	/* virtual communication */
 	VirtualCommunicator*m_virtualCommunicator;
 	vector<WorkerHandle> m_activeWorkers;
 	Rank m_rank;
-	WorkerHandle m_workerId;
 	RingAllocator*m_outboxAllocator;
 
 	ComputeCore*m_core;
@@ -115,36 +136,29 @@ class GenomeNeighbourhood: public CorePlugin{
 
 
 	/** contig paths */
-	vector<vector<Kmer> >*m_contigs;
+	vector<ContigPath>*m_contigs;
 	vector<PathHandle>*m_contigNames;
 
-/** genome folks in the neighbourhood **/
-	vector<Neighbour> m_leftNeighbours;
-	vector<Neighbour> m_rightNeighbours;
-
 	vector<NeighbourPair> m_finalList;
 
-/** sending neighbours **/
-
-	bool m_sentRightNeighbours;
-	bool m_sentLeftNeighbours;
-	int m_neighbourIndex;
-	bool m_selectedHits;
-	bool m_receivedReply;
-	bool m_sentEntry;
-
 	map<PathHandle,int>*m_contigLengths;
 
 /** private parts **/
 
-	void createStacks(Kmer a);
-	void processSide(int mode);
-	void processLinks(int mode);
-	void resetKmerStates();
-	void fetchPaths(int mode);
-	void selectHits();
-	void sendLeftNeighbours();
-	void sendRightNeighbours();
+	void startLevel();
+	void startSearches();
+	void requestPaths();
+	void expandFrontiers();
+	void finishSearch(NeighbourhoodSearch*search);
+	void selectHits(vector<Neighbour>*neighbours);
+
+	void addQuery(MessageTag tag,Rank destination,MessageUnit*content,int count);
+	void addVertexQuery(MessageTag tag,Kmer*kmer,int extra);
+	void clearQueries();
+	void pushQueries();
+	void receiveReplies();
+	bool hasPendingQueries();
+
 	void processFinalList();
 
 public:
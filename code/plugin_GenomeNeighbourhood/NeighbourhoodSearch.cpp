@@ -0,0 +1,93 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#include <plugin_GenomeNeighbourhood/NeighbourhoodSearch.h>
+
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
+void NeighbourhoodSearch::constructor(int contigIndex,int mode,Kmer*start){
+	m_contigIndex=contigIndex;
+	m_mode=mode;
+	m_depth=0;
+
+	m_visited.clear();
+	m_visited.resize(NEIGHBOURHOOD_SEARCH_INITIAL_BUCKETS,NEIGHBOURHOOD_SEARCH_EMPTY_BUCKET);
+	m_visitedVertices=0;
+
+	m_frontier.clear();
+	m_nextFrontier.clear();
+	m_neighbours.clear();
+
+	visit(start);
+	m_frontier.push_back(*start);
+}
+
+bool NeighbourhoodSearch::visit(Kmer*vertex){
+
+	/* keep the load below 1/2 */
+	if(2*(m_visitedVertices+1)>(int)m_visited.size())
+		growVisited();
+
+	uint64_t key=vertex->hash_function_1();
+
+	if(key==NEIGHBOURHOOD_SEARCH_EMPTY_BUCKET)
+		key++;
+
+	return insertKey(key);
+}
+
+bool NeighbourhoodSearch::insertKey(uint64_t key){
+
+	/* the size is a power of 2 */
+	uint64_t mask=m_visited.size()-1;
+	uint64_t bucket=key&mask;
+
+	while(m_visited[bucket]!=NEIGHBOURHOOD_SEARCH_EMPTY_BUCKET){
+		if(m_visited[bucket]==key)
+			return false;
+
+		bucket=(bucket+1)&mask;
+	}
+
+	m_visited[bucket]=key;
+	m_visitedVertices++;
+
+	return true;
+}
+
+void NeighbourhoodSearch::growVisited(){
+	vector<uint64_t> oldBuckets;
+	oldBuckets.swap(m_visited);
+
+	m_visited.resize(2*oldBuckets.size(),NEIGHBOURHOOD_SEARCH_EMPTY_BUCKET);
+	m_visitedVertices=0;
+
+	for(int i=0;i<(int)oldBuckets.size();i++){
+		if(oldBuckets[i]!=NEIGHBOURHOOD_SEARCH_EMPTY_BUCKET)
+			insertKey(oldBuckets[i]);
+	}
+
+	#ifdef ASSERT
+	assert(2*m_visitedVertices<=(int)m_visited.size());
+	#endif
+}
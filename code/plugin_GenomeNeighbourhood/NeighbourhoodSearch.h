@@ -0,0 +1,69 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#ifndef _NeighbourhoodSearch_h
+#define _NeighbourhoodSearch_h
+
+#include <plugin_KmerAcademyBuilder/Kmer.h>
+#include <plugin_GenomeNeighbourhood/Neighbour.h>
+
+#include <vector>
+#include <stdint.h> /** for uint64_t **/
+using namespace std;
+
+/** buckets of the visited table when a search starts **/
+#define NEIGHBOURHOOD_SEARCH_INITIAL_BUCKETS 64
+
+#define NEIGHBOURHOOD_SEARCH_EMPTY_BUCKET 0
+
+/**
+ * A breadth-first search from one end of a contig.
+ *
+ * The frontier contains all the vertices at the current depth.
+ * Visited vertices are stored in an open-addressing table of their
+ * 64-bit hash values.
+ */
+class NeighbourhoodSearch{
+
+	vector<uint64_t> m_visited;
+	int m_visitedVertices;
+
+	void growVisited();
+	bool insertKey(uint64_t key);
+
+public:
+
+	int m_contigIndex;
+	int m_mode;
+	int m_depth;
+
+	vector<Kmer> m_frontier;
+	vector<Kmer> m_nextFrontier;
+
+	vector<Neighbour> m_neighbours;
+
+	void constructor(int contigIndex,int mode,Kmer*start);
+
+/** returns true if the vertex was not visited before **/
+	bool visit(Kmer*vertex);
+};
+
+#endif
@@ -38,14 +38,15 @@ void JoinerTaskCreator::call_RAY_SLAVE_MODE_FINISH_FUSIONS(){
 
 void JoinerTaskCreator::constructor(VirtualProcessor*virtualProcessor,StaticVector*outbox,
 		RingAllocator*outboxAllocator,int*mode,Parameters*parameters,
-		vector<vector<Kmer> >*paths,vector<PathHandle>*pathIdentifiers,
-		set<PathHandle>*eliminated,VirtualCommunicator*virtualCommunicator,
-		vector<vector<Kmer> >*newPaths){
+		vector<ContigPath>*paths,vector<PathHandle>*pathIdentifiers,
+		set<PathHandle>*eliminated,set<PathHandle>*isolated,VirtualCommunicator*virtualCommunicator,
+		vector<ContigPath>*newPaths){
 	m_newPaths=newPaths;
 
 	m_virtualCommunicator=virtualCommunicator;
 
 	m_eliminated=eliminated;
+	m_isolated=isolated;
 	m_paths=paths;
 	m_pathIdentifiers=pathIdentifiers;
 
@@ -65,6 +66,8 @@ void JoinerTaskCreator::initializeMethod(){
 	m_iterator=0;
 	m_currentWorkerIdentifier=0;
 	m_reverseStrand=false;
+	m_skippedPaths=0;
+	m_isolatedStrands.clear();
 }
 
 /** finalize the whole thing */
@@ -95,12 +98,15 @@ void JoinerTaskCreator::finalizeMethod(){
 	}
 
 	cout<<"Rank "<<m_parameters->getRank()<<" JoinerTaskCreator ["<<m_completedJobs<<"/"<<2*m_paths->size()<<"]"<<endl;
-	cout<<"Statistics: all paths: "<<numberOfPaths<<" eliminated during joining: "<<eliminatedPaths<<endl;
+	cout<<"Statistics: all paths: "<<numberOfPaths<<" skipped: "<<m_skippedPaths<<" eliminated during joining: "<<eliminatedPaths<<endl;
 
 	/* send a message */
-	MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(sizeof(MessageUnit));
+	MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(4*sizeof(MessageUnit));
 	message[0]=removedPaths;
-	Message aMessage(message,1,MASTER_RANK,RAY_MPI_TAG_FINISH_FUSIONS_FINISHED,m_parameters->getRank());
+	message[1]=numberOfPaths-m_skippedPaths;
+	message[2]=m_skippedPaths;
+	message[3]=eliminatedPaths;
+	Message aMessage(message,4,MASTER_RANK,RAY_MPI_TAG_FINISH_FUSIONS_FINISHED,m_parameters->getRank());
 	m_outbox->push_back(aMessage);
 
 	/* set the mode */
@@ -121,6 +127,14 @@ bool JoinerTaskCreator::hasUnassignedTask(){
 		return false;
 	}
 
+	/* skip the paths that shared no vertex with other paths in a previous round */
+	while(!m_reverseStrand && m_iterator < (LargeCount)m_paths->size()
+		&& m_isolated->count(m_pathIdentifiers->at(m_iterator))>0){
+
+		m_iterator++;
+		m_skippedPaths++;
+	}
+
 	return m_iterator < (LargeCount)m_paths->size();
 }
 
@@ -186,6 +200,17 @@ void JoinerTaskCreator::processWorkerResult(Worker*worker){
 		if(m_parameters->hasOption("-debug-fusions"))
 			cout<<"kept !"<<endl;
 	}
+
+	/* both strands must be isolated */
+	if(worker2->isPathIsolated()){
+		PathHandle identifier=worker2->getPathIdentifier();
+		m_isolatedStrands[identifier]++;
+
+		if(m_isolatedStrands[identifier]==2){
+			m_isolated->insert(identifier);
+			m_isolatedStrands.erase(identifier);
+		}
+	}
 }
 
 /** destroy a worker */
@@ -33,6 +33,7 @@
 #include <core/ComputeCore.h>
 
 #include <vector>
+#include <map>
 #include <set>
 using namespace std;
 
@@ -58,16 +59,23 @@ class JoinerTaskCreator: public TaskCreator,  public CorePlugin{
 	Parameters*m_parameters;
 	StaticVector*m_outbox;
 	int*m_slaveMode;
-	vector<vector<Kmer> >*m_paths;
+	vector<ContigPath>*m_paths;
 	vector<PathHandle>*m_pathIdentifiers;
 
 	set<PathHandle>*m_eliminated;
 
+	/** paths that are not examined again */
+	set<PathHandle>*m_isolated;
+
+	/** number of strands of each path that shared no vertex */
+	map<PathHandle,int> m_isolatedStrands;
+	LargeCount m_skippedPaths;
+
 	uint64_t m_iterator;
 	WorkerHandle m_currentWorkerIdentifier;
 	bool m_reverseStrand;
 
-	vector<vector<Kmer> >*m_newPaths;
+	vector<ContigPath>*m_newPaths;
 
 	// fast run parameters
 	bool m_previouslyDone;
@@ -75,9 +83,9 @@ class JoinerTaskCreator: public TaskCreator,  public CorePlugin{
 
 public:
 	void constructor( VirtualProcessor*virtualProcessor,StaticVector*outbox,
-		RingAllocator*outboxAllocator,int*mode,Parameters*parameters,vector<vector<Kmer> >*paths,vector<PathHandle>*pathIdentifiers,
-		set<PathHandle>*eliminated,VirtualCommunicator*virtualCommunicator,
-		vector<vector<Kmer> >*newPaths
+		RingAllocator*outboxAllocator,int*mode,Parameters*parameters,vector<ContigPath>*paths,vector<PathHandle>*pathIdentifiers,
+		set<PathHandle>*eliminated,set<PathHandle>*isolated,VirtualCommunicator*virtualCommunicator,
+		vector<ContigPath>*newPaths
 );
 
 	void call_RAY_SLAVE_MODE_FINISH_FUSIONS();
@@ -50,7 +50,17 @@ void JoinerWorker::work(){
 	if(m_isDone)
 		return;
 
-	if(m_position < (int) m_path->size()){
+	if(!m_screener.isDone()){
+		m_screener.work();
+
+		if(m_screener.sharesNoVertex()){
+			m_position=m_path->size();
+
+			if(m_parameters->hasOption("-debug-fusions"))
+				cout<<"worker "<<m_workerIdentifier<<" path "<<m_identifier<<" shares no sampled vertex"<<endl;
+		}
+
+	}else if(m_position < (int) m_path->size()){
 
 		/* get the number of paths */
 		if(!m_requestedNumberOfPaths){
@@ -69,8 +79,7 @@ void JoinerWorker::work(){
 			if(m_reverseStrand)
 				kmer=kmer.complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
 
-			int destination=kmer.vertexRank(m_parameters->getSize(),
-				m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+			int destination=m_parameters->_vertexRank(&kmer);
 
 			#ifdef ASSERT
 			assert(destination < m_parameters->getSize() && destination >= 0);
@@ -98,6 +107,13 @@ void JoinerWorker::work(){
 			vector<MessageUnit> response;
 			m_virtualCommunicator->getMessageResponseElements(m_workerIdentifier,&response);
 			m_numberOfPaths=response[0];
+
+			int otherPaths=m_numberOfPaths;
+			if(!m_reverseStrand)
+				otherPaths--;
+
+			if(otherPaths>0)
+				m_sawOtherPaths=true;
 		
 			if(m_parameters->hasOption("-debug-fusions2"))
 				cout<<"worker "<<m_workerIdentifier<<" Got "<<m_numberOfPaths<<endl;
@@ -108,7 +124,7 @@ void JoinerWorker::work(){
 			m_requestedPath=false;
 
 			/* 2^5 */
-			int maximumNumberOfPathsToProcess=32;
+			int maximumNumberOfPathsToProcess=MAXIMUM_PATHS_PER_FUSION_VERTEX;
 
 			/* don't process repeated stuff */
 			if(m_numberOfPaths> maximumNumberOfPathsToProcess)
@@ -122,8 +138,7 @@ void JoinerWorker::work(){
 					kmer=kmer.complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
 				}
 	
-				int destination=kmer.vertexRank(m_parameters->getSize(),
-					m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+				int destination=m_parameters->_vertexRank(&kmer);
 				int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATH);
 				MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery);
 				int outputPosition=0;
@@ -553,7 +568,7 @@ Also, don't do it if the matching ratios are below 10%.
 				int position=0;
 				Kmer kmer;
 				kmer.unpack(&response,&position);
-				m_hitVertices.push_back(kmer);
+				m_hitVertices.push_back(&kmer);
 				
 				m_hitPosition++;
 				m_requestedHitVertex=false;
@@ -612,24 +627,20 @@ Also, don't do it if the matching ratios are below 10%.
 			if(selfSide==RIGHT_SIDE && otherSide == LEFT_SIDE){
 				cout<<"VALID"<<endl;
 				
-				vector<Kmer> newPath;
+				ContigPath newPath;
 
 				/* we take directly the path */
 				if(!m_reverseStrand){
 					newPath=(*m_path);
 				}else{
 					/* we need the reverse complement path */
-					vector<Kmer> rc;
-					for(int j=(*m_path).size()-1;j>=0;j--){
-						rc.push_back((*m_path)[j].complementVertex(m_parameters->getWordSize(),
-							m_parameters->getColorSpaceMode()));
-					}
-					newPath=rc;
+					m_path->getReverseComplement(m_parameters->getColorSpaceMode(),&newPath);
 				}
 
 				/* other path is always forward strand */
 				for(int i=m_maxPosition[hitName]+1;i<(int)hitLength;i++){
-					newPath.push_back(m_hitVertices.at(i));
+					Kmer kmer=m_hitVertices.at(i);
+					newPath.push_back(&kmer);
 				}
 
 				m_newPaths->push_back(newPath);
@@ -662,24 +673,23 @@ Also, don't do it if the matching ratios are below 10%.
 				cout<<"VALID"<<endl;
 
 				/* other path is always forward strand */
-				vector<Kmer> newPath=m_hitVertices;
+				ContigPath newPath=m_hitVertices;
 
 				/* we push the forward path */
 				if(!m_reverseStrand){
 					for(int i=m_maxPositionOnSelf[hitName]+1;i<(int)m_path->size();i++){
-						newPath.push_back(m_path->at(i));
+						Kmer kmer=m_path->at(i);
+						newPath.push_back(&kmer);
 					}
 
 				/* we push the reverse path */
 				}else{
-					vector<Kmer> rc;
-					for(int j=(*m_path).size()-1;j>=0;j--){
-						rc.push_back((*m_path)[j].complementVertex(m_parameters->getWordSize(),
-							m_parameters->getColorSpaceMode()));
-					}
+					ContigPath rc;
+					m_path->getReverseComplement(m_parameters->getColorSpaceMode(),&rc);
 
 					for(int i=m_maxPositionOnSelf[hitName]+1;i<(int)m_path->size();i++){
-						newPath.push_back(rc.at(i));
+						Kmer kmer=rc.at(i);
+						newPath.push_back(&kmer);
 					}
 
 				}
@@ -718,9 +728,9 @@ WorkerHandle JoinerWorker::getWorkerIdentifier(){
 	return m_workerIdentifier;
 }
 
-void JoinerWorker::constructor(WorkerHandle number,vector<Kmer>*path,PathHandle identifier,bool reverseStrand,
+void JoinerWorker::constructor(WorkerHandle number,ContigPath*path,PathHandle identifier,bool reverseStrand,
 	VirtualCommunicator*virtualCommunicator,Parameters*parameters,RingAllocator*outboxAllocator,
-vector<vector<Kmer> >*newPaths,
+vector<ContigPath>*newPaths,
 
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
@@ -743,12 +753,17 @@ vector<vector<Kmer> >*newPaths,
 	m_reverseStrand=reverseStrand;
 	m_path=path;
 	m_eliminated=false;
+	m_hitVertices.setKmerLength(parameters->getWordSize());
 
 	m_outboxAllocator=outboxAllocator;
 	m_parameters=parameters;
 	m_position=0;
 	m_requestedNumberOfPaths=false;
 
+	m_sawOtherPaths=false;
+	m_screener.constructor(m_path,m_reverseStrand,m_workerIdentifier,m_virtualCommunicator,
+		m_parameters,m_outboxAllocator,RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
+
 	if(m_parameters->hasOption("-debug-fusions")){
 		cout<<"Spawned worker number "<<number<<endl;
 		cout<<" path "<<m_identifier<<" reverse "<<m_reverseStrand<<" length "<<m_path->size()<<endl;
@@ -759,6 +774,10 @@ bool JoinerWorker::isPathEliminated(){
 	return m_eliminated;
 }
 
+bool JoinerWorker::isPathIsolated(){
+	return !m_sawOtherPaths && !m_screener.sawOtherPaths();
+}
+
 PathHandle JoinerWorker::getPathIdentifier(){
 	return m_identifier;
 }
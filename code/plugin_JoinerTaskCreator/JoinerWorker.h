@@ -26,6 +26,7 @@
 #include <scheduling/Worker.h>
 #include <plugin_KmerAcademyBuilder/Kmer.h>
 #include <application_core/Parameters.h>
+#include <plugin_SeedExtender/PathScreener.h>
 
 #include <stdint.h>
 #include <map>
@@ -43,9 +44,16 @@ class JoinerWorker: public Worker{
 	MessageTag RAY_MPI_TAG_GET_PATH_VERTEX;
 
 	bool m_requestedNumberOfPaths;
+
+	/* sampled positions queried before the walk */
+	PathScreener m_screener;
+
+	/* another path was seen at a queried vertex */
+	bool m_sawOtherPaths;
+
 	WorkerHandle m_workerIdentifier;
 	bool m_isDone;
-	vector<Kmer>*m_path;
+	ContigPath*m_path;
 	PathHandle m_identifier;
 	bool m_reverseStrand;
 	bool m_eliminated;
@@ -62,7 +70,7 @@ class JoinerWorker: public Worker{
 	map<PathHandle,int> m_hitLengths;
 	int m_hitIterator;
 
-	vector<vector<Kmer> >*m_newPaths;
+	vector<ContigPath>*m_newPaths;
 
 	bool m_selectedHit;
 	int m_selectedHitIndex;
@@ -76,7 +84,7 @@ class JoinerWorker: public Worker{
 	map<PathHandle,vector<int> > m_selfPositions;
 	map<PathHandle,vector<int> > m_hitPositions;
 
-	vector<Kmer> m_hitVertices;
+	ContigPath m_hitVertices;
 	int m_hitPosition;
 	bool m_requestedHitVertex;
 
@@ -84,9 +92,9 @@ class JoinerWorker: public Worker{
 	bool m_receivedPath;
 	bool m_requestedPath;
 public:
-	void constructor(WorkerHandle i,vector<Kmer>*path,PathHandle identifier,bool reverseStrand,
+	void constructor(WorkerHandle i,ContigPath*path,PathHandle identifier,bool reverseStrand,
 VirtualCommunicator*virtualCommunicator,Parameters*parameters,RingAllocator*outboxAllocator,
-vector<vector<Kmer> >*newPaths,
+vector<ContigPath>*newPaths,
 
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATH,
 	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,
@@ -102,6 +110,9 @@ vector<vector<Kmer> >*newPaths,
 	WorkerHandle getWorkerIdentifier();
 
 	bool isPathEliminated();
+
+	/** no other path goes through the queried vertices of this strand */
+	bool isPathIsolated();
 	PathHandle getPathIdentifier();
 };
 
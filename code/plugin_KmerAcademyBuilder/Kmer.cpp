@@ -160,6 +160,62 @@ int Kmer::vertexRank(int _size,int w,bool color){
 	return b.hash_function_1()%_size;
 }
 
+int Kmer::minimizerRank(int _size,int w,int minimizerLength,bool color){
+	uint64_t minimizer=0;
+
+	// low-complexity minimizers are too frequent, their k-mers are spread
+	if(!getMinimizer(w,minimizerLength,color,&minimizer))
+		return vertexRank(_size,w,color);
+
+	return uniform_hashing_function_2_64_64(minimizer)%_size;
+}
+
+bool Kmer::getMinimizer(int w,int minimizerLength,bool color,uint64_t*minimizer){
+	#ifdef ASSERT
+	assert(minimizerLength>0 && minimizerLength<32 && minimizerLength<=w);
+	#endif
+
+	uint64_t mask=(((uint64_t)1)<<(2*minimizerLength))-1;
+	int firstSymbolShift=2*(minimizerLength-1);
+
+	uint64_t forward=0;
+	uint64_t reverse=0;
+	uint64_t lowestHash=0;
+	bool found=false;
+
+	for(int position=0;position<w;position++){
+		uint64_t code=(getU64(position/32)>>((2*position)%64))&3;
+		uint64_t complement=code;
+
+		if(!color) /* in color space, reverse complement is just reverse */
+			complement=(~code)&3;
+
+		// the m-mer ending here, and its reverse complement
+		forward=((forward<<2)|code)&mask;
+		reverse=(reverse>>2)|(complement<<firstSymbolShift);
+
+		if(position<minimizerLength-1)
+			continue;
+
+		uint64_t canonical=forward;
+		if(reverse<forward)
+			canonical=reverse;
+
+		// a hashed order avoids picking poly-A m-mers everywhere
+		uint64_t hash=uniform_hashing_function_1_64_64(canonical);
+
+		if(!found || hash<lowestHash){
+			lowestHash=hash;
+			*minimizer=canonical;
+			found=true;
+		}
+	}
+
+	// a period of 1, 2 or 3 symbols
+	return ((*minimizer)>>4)!=((*minimizer)&(mask>>4))
+		&& ((*minimizer)>>6)!=((*minimizer)&(mask>>6));
+}
+
 /**
  * Get the outgoing edges
  * one bit (1=yes, 0=no) per possible edge
@@ -350,14 +406,14 @@ char codeToChar(uint8_t a,bool color){
 	return 'A';
 }
 
-void Kmer::write(ofstream*f){
+void Kmer::write(ostream*f){
 	for(int i=0;i<getNumberOfU64();i++){
 		uint64_t a=getU64(i);
 		f->write((char*)&a,sizeof(uint64_t));
 	}
 }
 
-void Kmer::read(ifstream*f){
+void Kmer::read(istream*f){
 	for(int i=0;i<getNumberOfU64();i++){
 		uint64_t a=0;
 		f->read((char*)&a,sizeof(uint64_t));
@@ -103,6 +103,14 @@ public:
 	uint8_t getFirstSegmentFirstCode(int w);
 	uint8_t getSecondSegmentLastCode(int w);
 	int vertexRank(int _size,int w,bool color);
+
+/** the rank is given by the minimizer of the k-mer, so that
+ * consecutive k-mers are often on the same rank **/
+	int minimizerRank(int _size,int w,int minimizerLength,bool color);
+
+/** get the canonical m-mer with the lowest hash value, m<32.
+ * Returns false if the minimizer is a repeat of 1, 2 or 3 symbols. **/
+	bool getMinimizer(int w,int minimizerLength,bool color,uint64_t*minimizer);
 /**
  * get the outgoing Kmer objects for a Kmer a having edges and
  * a k-mer length k
@@ -125,8 +133,8 @@ public:
  */
 	string idToWord(int wordSize,bool color);
 
-	void write(ofstream*f);
-	void read(ifstream*f);
+	void write(ostream*f);
+	void read(istream*f);
 
 	void convertToString(int kmerLength,bool coloredMode,char*buffer);
 	double getGuanineCytosineProportion(int kmerLength,bool coloredMode);
@@ -28,29 +28,28 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <application_core/Parameters.h>
+#include <structures/MyHashTableIterator.h>
 using namespace std;
 
 void KmerAcademy::constructor(int rank,Parameters*parameters){
 	m_parameters=parameters;
 	m_size=0;
 
-	int buckets=m_parameters->getNumberOfBuckets();
-	int bucketsPerGroup=m_parameters->getNumberOfBucketsPerGroup();
-	double loadFactorThreshold=m_parameters->getLoadFactorThreshold();
+	m_hashTable=m_hashTables;
+	constructHashTable(m_hashTable);
 
-	cout<<"[KmerAcademy] buckets="<<buckets<<" bucketsPerGroup="<<bucketsPerGroup;
-	cout<<" loadFactorThreshold="<<loadFactorThreshold<<endl;
+	m_budget=m_parameters->getMaximumKmersPerRank();
+	m_evictedKmers=0;
+	m_evictions=0;
 
-	m_hashTable.constructor(buckets,"RAY_MALLOC_TYPE_KMER_ACADEMY",
-		m_parameters->showMemoryAllocations(),m_parameters->getRank(),
-		bucketsPerGroup,loadFactorThreshold
-		);
-
-	if(m_parameters->hasOption("-hash-table-verbosity"))
-		m_hashTable.toggleVerbosity();
+	/* entries start with a count of 2: one for the Bloom filter and one
+ * for the insertion */
+	m_evictionThreshold=2;
 
 	m_inserted=false;
 
+	m_coverageHistogram.constructor();
+
 	if(m_parameters->showMemoryUsage()){
 		showMemoryUsage(rank);
 	}
@@ -70,7 +69,7 @@ KmerCandidate*KmerAcademy::find(Kmer*key){
 	if(key->isLower(&lowerKey)){
 		lowerKey=*key;
 	}
-	return m_hashTable.find(&lowerKey);
+	return m_hashTable->find(&lowerKey);
 }
 
 /**
@@ -81,9 +80,9 @@ KmerCandidate*KmerAcademy::insert(Kmer*key){
 	if(key->isLower(&lowerKey)){
 		lowerKey=*key;
 	}
-	LargeCount sizeBefore=m_hashTable.size();
-	KmerCandidate*entry=m_hashTable.insert(&lowerKey);
-	m_inserted=m_hashTable.size()>sizeBefore;
+	LargeCount sizeBefore=m_hashTable->size();
+	KmerCandidate*entry=m_hashTable->insert(&lowerKey);
+	m_inserted=m_hashTable->size()>sizeBefore;
 
 	/* for any pair of reverse-complement k-mers
  * 	we only insert the lowest so when we do so we virtually insert 2 k-mers
@@ -102,23 +101,134 @@ void KmerAcademy::destructor(){
 		showMemoryUsage(m_parameters->getRank());
 	}
 
-	m_hashTable.destructor();
+	m_hashTable->destructor();
+	m_coverageHistogram.destructor();
 
 	if(m_parameters->showMemoryUsage()){
 		showMemoryUsage(m_parameters->getRank());
 	}
 }
 
+void KmerAcademy::constructHashTable(MyHashTable<Kmer,KmerCandidate>*table){
+	int buckets=m_parameters->getNumberOfBuckets();
+	int bucketsPerGroup=m_parameters->getNumberOfBucketsPerGroup();
+	double loadFactorThreshold=m_parameters->getLoadFactorThreshold();
+
+	cout<<"[KmerAcademy] buckets="<<buckets<<" bucketsPerGroup="<<bucketsPerGroup;
+	cout<<" loadFactorThreshold="<<loadFactorThreshold<<endl;
+
+	table->constructor(buckets,"RAY_MALLOC_TYPE_KMER_ACADEMY",
+		m_parameters->showMemoryAllocations(),m_parameters->getRank(),
+		bucketsPerGroup,loadFactorThreshold
+		);
+
+	if(m_parameters->hasOption("-hash-table-verbosity"))
+		table->toggleVerbosity();
+}
+
 MyHashTable<Kmer,KmerCandidate>*KmerAcademy::getHashTable(){
-	return &m_hashTable;
+	return m_hashTable;
+}
+
+CoverageHistogram*KmerAcademy::getCoverageHistogram(){
+	return &m_coverageHistogram;
 }
 
 /** print statistics of the hash table */
 void KmerAcademy::printStatistics(){
-	m_hashTable.printProbeStatistics();
+	m_hashTable->printProbeStatistics();
 }
 
 void KmerAcademy::completeResizing(){
-	m_hashTable.completeResizing();
+	m_hashTable->completeResizing();
+
+}
+
+bool KmerAcademy::isAboveBudget(){
+	return m_budget>0 && m_hashTable->size()>=m_budget;
+}
+
+void KmerAcademy::evictSingletons(){
+	MyHashTable<Kmer,KmerCandidate>*survivors=m_hashTables;
+	if(survivors==m_hashTable)
+		survivors++;
+
+	constructHashTable(survivors);
+
+	m_hashTable->completeResizing();
+
+	LargeCount evicted=0;
+
+	MyHashTableIterator<Kmer,KmerCandidate> iterator;
+	iterator.constructor(m_hashTable);
+
+	while(iterator.hasNext()){
+		KmerCandidate*entry=iterator.next();
+
+		if(entry->m_count<=m_evictionThreshold){
+			m_coverageHistogram.remove(entry->m_count,1);
+			evicted++;
+			continue;
+		}
+
+		Kmer key=entry->m_lowerKey;
+		KmerCandidate*survivor=survivors->insert(&key);
+		survivor->m_count=entry->m_count;
+	}
+
+	m_hashTable->destructor();
+	m_hashTable=survivors;
+
+	m_size-=2*evicted;
+	m_evictedKmers+=evicted;
+	m_evictions++;
+
+	LargeCount remaining=m_hashTable->size();
+
+	#if defined(RAY_64_BITS)
+	printf("Rank %i evicted %lu k-mers seen at most %i times from the k-mer academy, %lu remain\n",
+		m_parameters->getRank(),evicted,(int)m_evictionThreshold,remaining);
+	#elif defined(RAY_32_BITS)
+	printf("Rank %i evicted %llu k-mers seen at most %i times from the k-mer academy, %llu remain\n",
+		m_parameters->getRank(),evicted,(int)m_evictionThreshold,remaining);
+	#endif
+	fflush(stdout);
+
+	// another eviction at this threshold would not free enough memory
+	if(remaining<m_budget/2)
+		return;
+
+	if(m_evictionThreshold<KMER_ACADEMY_MAXIMUM_EVICTION_THRESHOLD){
+		m_evictionThreshold++;
+
+		printf("Rank %i: warning: the budget is small, k-mers seen %i times will also be evicted\n",
+			m_parameters->getRank(),(int)m_evictionThreshold);
+		fflush(stdout);
+		return;
+	}
+
+	#if defined(RAY_64_BITS)
+	printf("Rank %i: warning: the budget of %lu k-mers is too small, no more k-mers will be evicted\n",
+		m_parameters->getRank(),m_budget);
+	#elif defined(RAY_32_BITS)
+	printf("Rank %i: warning: the budget of %llu k-mers is too small, no more k-mers will be evicted\n",
+		m_parameters->getRank(),m_budget);
+	#endif
+	fflush(stdout);
+
+	m_budget=0;
+}
 
+void KmerAcademy::printEvictionStatistics(){
+	if(m_evictions==0)
+		return;
+
+	#if defined(RAY_64_BITS)
+	printf("Rank %i evicted %lu k-mers from the k-mer academy in %i evictions\n",
+		m_parameters->getRank(),m_evictedKmers,m_evictions);
+	#elif defined(RAY_32_BITS)
+	printf("Rank %i evicted %llu k-mers from the k-mer academy in %i evictions\n",
+		m_parameters->getRank(),m_evictedKmers,m_evictions);
+	#endif
+	fflush(stdout);
 }
@@ -25,10 +25,14 @@
 #include <memory/MyAllocator.h>
 #include <plugin_KmerAcademyBuilder/Kmer.h>
 #include <plugin_KmerAcademyBuilder/KmerCandidate.h>
+#include <plugin_CoverageGatherer/CoverageHistogram.h>
 #include <application_core/Parameters.h>
 #include <structures/MyHashTable.h>
 #include <stdint.h>
 
+/** the eviction threshold is raised up to this count when evictions
+ * do not free enough memory **/
+#define KMER_ACADEMY_MAXIMUM_EVICTION_THRESHOLD 3
 
 /**
  * The KmerAcademy is the place where KmerCandidate  
@@ -43,7 +47,21 @@ class KmerAcademy{
 	Parameters*m_parameters;
 	LargeCount m_size;
 	bool m_inserted;
-	MyHashTable<Kmer,KmerCandidate> m_hashTable;
+
+/** the second table is only used while evicting entries **/
+	MyHashTable<Kmer,KmerCandidate> m_hashTables[2];
+	MyHashTable<Kmer,KmerCandidate>*m_hashTable;
+
+/** maximum number of entries, 0 if there is no limit **/
+	LargeCount m_budget;
+	LargeCount m_evictedKmers;
+	int m_evictions;
+
+/** entries with a count up to this value are evicted **/
+	CoverageDepth m_evictionThreshold;
+
+/** coverage distribution of the k-mers in the academy **/
+	CoverageHistogram m_coverageHistogram;
 
 public:
 	void constructor(Rank rank,Parameters*a);
@@ -53,8 +71,18 @@ public:
 	bool inserted();
 	void destructor();
 	MyHashTable<Kmer,KmerCandidate>*getHashTable();
+	void constructHashTable(MyHashTable<Kmer,KmerCandidate>*table);
 	void printStatistics();
 	void completeResizing();
+	CoverageHistogram*getCoverageHistogram();
+
+	bool isAboveBudget();
+
+/** remove the entries that were not seen again since they passed
+ * the Bloom filter. Survivors are moved to a new table, so both
+ * tables are allocated while this runs. **/
+	void evictSingletons();
+	void printEvictionStatistics();
 };
 
 #endif
@@ -153,7 +153,7 @@ void KmerAcademyBuilder::call_RAY_SLAVE_MODE_BUILD_KMER_ACADEMY(){
 			if(reverseComplementKmer<lowerKmer)
 				lowerKmer=reverseComplementKmer;
 
-			int rankToFlush=lowerKmer.hash_function_1()%m_parameters->getSize();
+			int rankToFlush=m_parameters->_vertexRank(&lowerKmer);
 			
 			for(int i=0;i<KMER_U64_ARRAY_SIZE;i++){
 				m_bufferedData.addAt(rankToFlush,lowerKmer.getU64(i));
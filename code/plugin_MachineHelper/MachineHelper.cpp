@@ -19,6 +19,7 @@
 */
 
 #include <plugin_MachineHelper/MachineHelper.h>
+#include <application_core/CheckpointFile.h>
 #include <communication/mpi_tags.h>
 #include <communication/Message.h>
 #include <plugin_CoverageGatherer/CoverageDistribution.h>
@@ -188,6 +189,7 @@ SequencesLoader*sl,time_t*lastTime,bool*writeKmerInitialised,Partitioner*partiti
 	m_numberOfRanksWithCoverageData=numberOfRanksWithCoverageData;
 
 	m_initialisedKiller=false;
+	m_sentContigsFileSize=false;
 
 }
 
@@ -195,7 +197,7 @@ void MachineHelper::call_RAY_MASTER_MODE_SEND_COVERAGE_VALUES (){
 	if(m_parameters->hasCheckpoint("GenomeGraph")){
 		cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint CoverageDistribution"<<endl;
 		m_coverageDistribution->clear();
-		ifstream f(m_parameters->getCheckpointFile("CoverageDistribution").c_str());
+		CheckpointReader f(m_parameters,"CoverageDistribution");
 		int n=0;
 		f.read((char*)&n,sizeof(int));
 		int coverage=0;
@@ -211,7 +213,7 @@ void MachineHelper::call_RAY_MASTER_MODE_SEND_COVERAGE_VALUES (){
 
 	if(m_parameters->writeCheckpoints() && !m_parameters->hasCheckpoint("CoverageDistribution")){
 		cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint CoverageDistribution"<<endl;
-		ofstream f(m_parameters->getCheckpointFile("CoverageDistribution").c_str());
+		CheckpointWriter f(m_parameters,"CoverageDistribution");
 		int theSize=m_coverageDistribution->size();
 		f.write((char*)&theSize,sizeof(int));
 
@@ -234,6 +236,11 @@ void MachineHelper::call_RAY_MASTER_MODE_SEND_COVERAGE_VALUES (){
 	}
 	(*m_numberOfMachinesDoneSendingCoverage)=-1;
 	string file=m_parameters->getCoverageDistributionFile();
+
+	#ifdef ASSERT
+	CoverageDistribution::test();
+	#endif
+
 	CoverageDistribution distribution(m_coverageDistribution,&file);
 
 	m_parameters->setMinimumCoverage(distribution.getMinimumCoverage());
@@ -246,6 +253,7 @@ void MachineHelper::call_RAY_MASTER_MODE_SEND_COVERAGE_VALUES (){
 	cout<<endl;
 	cout<<"Rank "<<getRank()<<": the minimum coverage is "<<m_parameters->getMinimumCoverage()<<endl;
 	cout<<"Rank "<<getRank()<<": the peak coverage is "<<m_parameters->getPeakCoverage()<<endl;
+	distribution.printModel(&cout);
 
 	LargeCount numberOfVertices=0;
 	LargeCount verticesWith1Coverage=0;
@@ -285,6 +293,7 @@ void MachineHelper::call_RAY_MASTER_MODE_SEND_COVERAGE_VALUES (){
 	outputFile<<"PeakCoverage:\t"<<m_parameters->getPeakCoverage()<<endl;
 	outputFile<<"RepeatCoverage:\t"<<m_parameters->getRepeatCoverage()<<endl;
 	outputFile<<"Number of k-mers with at least MinimumCoverage:\t"<<genomeKmers<<" k-mers"<<endl;
+	distribution.printModel(&outputFile);
 
 	// don't report this as it is not accurate with the new algorithms
 	//outputFile<<"Estimated genome length:\t"<<genomeKmers/2<<" nucleotides"<<endl;
@@ -593,9 +602,28 @@ void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_EXTENSIONS(){
 }
 
 void MachineHelper::call_RAY_SLAVE_MODE_SEND_EXTENSION_DATA(){
+
+	/* the master replies with the offset of this rank in Contigs.fasta */
+	if(m_sentContigsFileSize){
+		if(m_inbox->size()>0 && m_inbox->at(0)->getTag()==RAY_MPI_TAG_CONTIGS_FILE_OFFSET){
+			MessageUnit*buffer=(MessageUnit*)m_inbox->at(0)->getBuffer();
+			LargeCount offset=buffer[0];
+
+			writeContigs(offset);
+
+			m_sentContigsFileSize=false;
+
+			m_switchMan->setSlaveMode(RAY_SLAVE_MODE_DO_NOTHING);
+			Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_EXTENSION_DATA_END,getRank());
+			m_outbox->push_back(aMessage);
+		}
+
+		return;
+	}
+
 	/* clear eliminated paths */
 	vector<PathHandle> newNames;
-	vector<vector<Kmer> > newPaths;
+	vector<ContigPath> newPaths;
 
 	for(int i=0;i<(int)m_ed->m_EXTENSION_contigs.size();i++){
 		PathHandle uniqueId=m_ed->m_EXTENSION_identifiers[i];
@@ -613,26 +641,62 @@ void MachineHelper::call_RAY_SLAVE_MODE_SEND_EXTENSION_DATA(){
 	m_ed->m_EXTENSION_identifiers=newNames;
 	m_ed->m_EXTENSION_contigs=newPaths;
 
-	cout<<"Rank "<<m_parameters->getRank()<< " is appending its fusions"<<endl;
+	m_scaffolder->setContigPaths(&(m_ed->m_EXTENSION_identifiers),&(m_ed->m_EXTENSION_contigs));
+	m_searcher->setContigs(&(m_ed->m_EXTENSION_contigs),&(m_ed->m_EXTENSION_identifiers));
+
+	/* send the number of bytes to write to the master */
+	m_contigsFileSize=getContigsFileSize();
+
+	MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+	message[0]=m_contigsFileSize;
+	Message aMessage(message,1,MASTER_RANK,RAY_MPI_TAG_CONTIGS_FILE_SIZE,getRank());
+	m_outbox->push_back(aMessage);
+
+	m_sentContigsFileSize=true;
+
+	/** possibly write the checkpoint while the other ranks report their sizes */
+	if(m_parameters->writeCheckpoints() && !m_parameters->hasCheckpoint("ContigPaths")){
+		writeContigPathsCheckpoint();
+	}
+}
+
+/** the number of bytes that writeContigs will write */
+LargeCount MachineHelper::getContigsFileSize(){
+	LargeCount bytes=0;
+	int columns=m_parameters->getColumns();
+
+	for(int i=0;i<(int)m_ed->m_EXTENSION_contigs.size();i++){
+		PathHandle uniqueId=m_ed->m_EXTENSION_identifiers[i];
+		int length=m_ed->m_EXTENSION_contigs[i].size()+m_parameters->getWordSize()-1;
+
+		ostringstream header;
+		header<<">contig-"<<uniqueId<<" "<<length<<" nucleotides"<<endl;
+
+		/* addLineBreaks adds a new line after each line */
+		bytes+=header.str().length()+length+(length+columns-1)/columns;
+	}
+
+	return bytes;
+}
+
+void MachineHelper::writeContigs(LargeCount offset){
+
+	cout<<"Rank "<<m_parameters->getRank()<<" is writing its contigs at offset "<<offset<<endl;
+
 	string output=m_parameters->getOutputFile();
-	ofstream fp;
 
-	fp.open(output.c_str(),ios_base::out|ios_base::app);
+	/* the master created the file, every rank writes in its own region */
+	fstream fp;
+	fp.open(output.c_str(),ios_base::in|ios_base::out|ios_base::binary);
+	fp.seekp(offset);
 
 	int total=0;
 
-	m_scaffolder->setContigPaths(&(m_ed->m_EXTENSION_identifiers),&(m_ed->m_EXTENSION_contigs));
-	m_searcher->setContigs(&(m_ed->m_EXTENSION_contigs),&(m_ed->m_EXTENSION_identifiers));
-
 	ostringstream operationBuffer;
 
 	for(int i=0;i<(int)m_ed->m_EXTENSION_contigs.size();i++){
 		PathHandle uniqueId=m_ed->m_EXTENSION_identifiers[i];
 
-		if(m_fusionData->m_FUSION_eliminated.count(uniqueId)>0){
-			continue;
-		}
-
 		total++;
 		string contig=convertToString(&(m_ed->m_EXTENSION_contigs[i]),m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
 		
@@ -643,39 +707,34 @@ void MachineHelper::call_RAY_SLAVE_MODE_SEND_EXTENSION_DATA(){
 		flushFileOperationBuffer(false,&operationBuffer,&fp,CONFIG_FILE_IO_BUFFER_SIZE);
 	}
 
-	cout<<"Rank "<<m_parameters->getRank()<<" appended "<<total<<" elements"<<endl;
-
 	flushFileOperationBuffer(true,&operationBuffer,&fp,CONFIG_FILE_IO_BUFFER_SIZE);
 
+	#ifdef ASSERT
+	assert((LargeCount)fp.tellp()==offset+m_contigsFileSize);
+	#endif
+
 	fp.close();
 
+	cout<<"Rank "<<m_parameters->getRank()<<" wrote "<<total<<" elements"<<endl;
+
 	if(m_parameters->showMemoryUsage()){
 		showMemoryUsage(getRank());
 	}
+}
 
-	/** possibly write the checkpoint */
-	if(m_parameters->writeCheckpoints() && !m_parameters->hasCheckpoint("ContigPaths")){
-		cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint ContigPaths"<<endl;
-		ofstream f(m_parameters->getCheckpointFile("ContigPaths").c_str());
-		int theSize=m_ed->m_EXTENSION_contigs.size();
-		f.write((char*)&theSize,sizeof(int));
-
-		/* write each path with its name and vertices */
-		for(int i=0;i<theSize;i++){
-			PathHandle name=m_ed->m_EXTENSION_identifiers[i];
-			int vertices=m_ed->m_EXTENSION_contigs[i].size();
-			f.write((char*)&name,sizeof(PathHandle));
-			f.write((char*)&vertices,sizeof(int));
-			for(int j=0;j<vertices;j++){
-				m_ed->m_EXTENSION_contigs[i][j].write(&f);
-			}
-		}
-		f.close();
+void MachineHelper::writeContigPathsCheckpoint(){
+	cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint ContigPaths"<<endl;
+	CheckpointWriter f(m_parameters,"ContigPaths");
+	int theSize=m_ed->m_EXTENSION_contigs.size();
+	f.write((char*)&theSize,sizeof(int));
+
+	/* write each path with its name and packed vertices */
+	for(int i=0;i<theSize;i++){
+		PathHandle name=m_ed->m_EXTENSION_identifiers[i];
+		f.write((char*)&name,sizeof(PathHandle));
+		m_ed->m_EXTENSION_contigs[i].write(&f);
 	}
-
-	m_switchMan->setSlaveMode(RAY_SLAVE_MODE_DO_NOTHING);
-	Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_EXTENSION_DATA_END,getRank());
-	m_outbox->push_back(aMessage);
+	f.close();
 }
 
 void MachineHelper::call_RAY_MASTER_MODE_TRIGGER_FUSIONS(){
@@ -759,9 +818,17 @@ void MachineHelper::call_RAY_MASTER_MODE_START_FUSION_CYCLE(){
 			m_outbox->push_back(aMessage);
 		}
 		(*m_FINISH_n)=0;
+
+		m_fusionData->m_FINISH_examinedPaths=0;
+		m_fusionData->m_FINISH_skippedPaths=0;
+		m_fusionData->m_FINISH_removedPaths=0;
 	}else if((*m_FINISH_n) ==getSize() && (*m_isFinalFusion) && m_currentCycleStep==3){
 		//cout<<"cycleStep= "<<m_currentCycleStep<<endl;
 		m_currentCycleStep++;
+
+		cout<<"Rank 0: cycleNumber= "<<m_cycleNumber<<" joining examined "<<m_fusionData->m_FINISH_examinedPaths;
+		cout<<" paths, skipped "<<m_fusionData->m_FINISH_skippedPaths<<" isolated paths, ";
+		cout<<m_fusionData->m_FINISH_removedPaths<<" paths were joined"<<endl;
 		int count=0;
 
 		//cout<<"DEBUG (*m_reductionOccured)= "<<(*m_reductionOccured)<<endl;
@@ -818,6 +885,10 @@ void MachineHelper::call_RAY_MASTER_MODE_START_FUSION_CYCLE(){
 		cout<<"Rank 0 tells others to compute fusions."<<endl;
 		m_fusionData->m_FUSION_numberOfRanksDone=0;
 		(*m_DISTRIBUTE_n)=-1;
+		m_fusionData->m_FUSION_examinedPaths=0;
+		m_fusionData->m_FUSION_skippedPaths=0;
+		m_fusionData->m_FUSION_removedPaths=0;
+
 		for(int i=0;i<(int)getSize();i++){// start fusion.
 			Message aMessage(NULL,0,i,RAY_MPI_TAG_START_FUSION,getRank());
 			m_outbox->push_back(aMessage);
@@ -832,6 +903,10 @@ void MachineHelper::call_RAY_MASTER_MODE_START_FUSION_CYCLE(){
 		//cout<<"cycleStep= "<<m_currentCycleStep<<endl;
 		m_fusionData->m_FUSION_numberOfRanksDone=-1;
 
+		cout<<"Rank 0: cycleNumber= "<<m_cycleNumber<<" fusion examined "<<m_fusionData->m_FUSION_examinedPaths;
+		cout<<" paths, skipped "<<m_fusionData->m_FUSION_skippedPaths<<" isolated paths, ";
+		cout<<m_fusionData->m_FUSION_removedPaths<<" contained paths were removed"<<endl;
+
 		//cout<<"DEBUG (*m_reductionOccured)= "<<(*m_reductionOccured)<<endl;
 
 		if(!(*m_reductionOccured) || m_cycleNumber == lastAllowedCycleNumber){ 
@@ -846,25 +921,53 @@ void MachineHelper::call_RAY_MASTER_MODE_START_FUSION_CYCLE(){
 
 void MachineHelper::call_RAY_MASTER_MODE_ASK_EXTENSIONS(){
 
-	// ask ranks to send their extensions.
+	// ask all the ranks to report the size of their contigs
 	if(!m_ed->m_EXTENSION_currentRankIsSet){
 		m_ed->m_EXTENSION_currentRankIsSet=true;
-		m_ed->m_EXTENSION_currentRankIsStarted=false;
-		m_ed->m_EXTENSION_rank++;
+		m_ed->m_EXTENSION_numberOfRanksDone=0;
 
 		m_seedExtender->closePathFile();
 
-	}
-	if(m_ed->m_EXTENSION_rank==getSize()){
+		m_contigsFileSizes.clear();
+		m_contigsFileSizes.resize(getSize(),0);
+		m_receivedContigsFileSizes=0;
+
+		for(int i=0;i<getSize();i++){
+			Message aMessage(NULL,0,i,RAY_MPI_TAG_ASK_EXTENSION_DATA,getRank());
+			m_outbox->push_back(aMessage);
+		}
+
+	// give each rank its offset, ranks are in order in the file
+	}else if(m_inbox->size()>0 && m_inbox->at(0)->getTag()==RAY_MPI_TAG_CONTIGS_FILE_SIZE){
+		MessageUnit*buffer=(MessageUnit*)m_inbox->at(0)->getBuffer();
+		m_contigsFileSizes[m_inbox->at(0)->getSource()]=buffer[0];
+		m_receivedContigsFileSizes++;
+
+		if(m_receivedContigsFileSizes<getSize())
+			return;
+
+		/* create the file, and keep what is already in it */
+		string output=m_parameters->getOutputFile();
+		ofstream fp(output.c_str(),ios_base::out|ios_base::app);
+		fp.seekp(0,ios_base::end);
+		LargeCount offset=fp.tellp();
+		fp.close();
+
+		for(int i=0;i<getSize();i++){
+			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
+			message[0]=offset;
+			Message aMessage(message,1,i,RAY_MPI_TAG_CONTIGS_FILE_OFFSET,getRank());
+			m_outbox->push_back(aMessage);
+
+			offset+=m_contigsFileSizes[i];
+		}
+
+		cout<<"Rank "<<getRank()<<" assigned regions of "<<output<<" to "<<getSize()<<" ranks, "<<offset<<" bytes"<<endl;
+
+	}else if(m_ed->m_EXTENSION_numberOfRanksDone==getSize()){
 		m_timePrinter->printElapsedTime("Generation of contigs");
 		if(m_parameters->useAmos()){
 			m_switchMan->setMasterMode(RAY_MASTER_MODE_AMOS);
-
-			m_ed->m_EXTENSION_currentRankIsStarted=false;
-			m_ed->m_EXTENSION_currentPosition=0;
-			m_ed->m_EXTENSION_rank=0;
-			m_seedingData->m_SEEDING_i=0;
-			m_ed->m_EXTENSION_reads_requested=false;
 			cout<<endl;
 		}else{
 
@@ -872,14 +975,7 @@ void MachineHelper::call_RAY_MASTER_MODE_ASK_EXTENSIONS(){
 
 			m_scaffolder->m_numberOfRanksFinished=0;
 		}
-		
-	}else if(!m_ed->m_EXTENSION_currentRankIsStarted){
-		m_ed->m_EXTENSION_currentRankIsStarted=true;
-		Message aMessage(NULL,0,m_ed->m_EXTENSION_rank,RAY_MPI_TAG_ASK_EXTENSION_DATA,getRank());
-		m_outbox->push_back(aMessage);
-		m_ed->m_EXTENSION_currentRankIsDone=false;
-	}else if(m_ed->m_EXTENSION_currentRankIsDone){
-		m_ed->m_EXTENSION_currentRankIsSet=false;
+
 	}
 }
 
@@ -1114,6 +1210,11 @@ void MachineHelper::registerPlugin(ComputeCore*core){
 	RAY_MPI_TAG_GOOD_JOB_SEE_YOU_SOON_REPLY=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_GOOD_JOB_SEE_YOU_SOON_REPLY,"RAY_MPI_TAG_GOOD_JOB_SEE_YOU_SOON_REPLY");
 
+	RAY_MPI_TAG_CONTIGS_FILE_SIZE=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_CONTIGS_FILE_SIZE,"RAY_MPI_TAG_CONTIGS_FILE_SIZE");
+
+	RAY_MPI_TAG_CONTIGS_FILE_OFFSET=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_CONTIGS_FILE_OFFSET,"RAY_MPI_TAG_CONTIGS_FILE_OFFSET");
 }
 
 void MachineHelper::resolveSymbols(ComputeCore*core){
@@ -1260,6 +1361,8 @@ void MachineHelper::resolveSymbols(ComputeCore*core){
 	RAY_MPI_TAG_COUNT_SEARCH_ELEMENTS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_COUNT_SEARCH_ELEMENTS");
 	RAY_MPI_TAG_DISTRIBUTE_FUSIONS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_DISTRIBUTE_FUSIONS");
 	RAY_MPI_TAG_EXTENSION_DATA_END=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_EXTENSION_DATA_END");
+	RAY_MPI_TAG_CONTIGS_FILE_SIZE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_CONTIGS_FILE_SIZE");
+	RAY_MPI_TAG_CONTIGS_FILE_OFFSET=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_CONTIGS_FILE_OFFSET");
 
 	core->setFirstMasterMode(m_plugin,RAY_MASTER_MODE_LOAD_CONFIG);
 
@@ -144,6 +144,8 @@ class MachineHelper: public CorePlugin{
 	MessageTag RAY_MPI_TAG_COUNT_SEARCH_ELEMENTS;
 	MessageTag RAY_MPI_TAG_DISTRIBUTE_FUSIONS;
 	MessageTag RAY_MPI_TAG_EXTENSION_DATA_END;
+	MessageTag RAY_MPI_TAG_CONTIGS_FILE_SIZE;
+	MessageTag RAY_MPI_TAG_CONTIGS_FILE_OFFSET;
 
 	MasterMode RAY_MASTER_MODE_ADD_COLORS;
 	MasterMode RAY_MASTER_MODE_AMOS;
@@ -265,6 +267,16 @@ class MachineHelper: public CorePlugin{
 	int m_machineRank;
 	int m_numberOfRanksDone;
 
+	/** Contigs.fasta is written by all ranks at once, each at its own offset */
+	bool m_sentContigsFileSize;
+	LargeCount m_contigsFileSize;
+	vector<LargeCount> m_contigsFileSizes;
+	int m_receivedContigsFileSizes;
+
+	LargeCount getContigsFileSize();
+	void writeContigs(LargeCount offset);
+	void writeContigPathsCheckpoint();
+
 	int*m_numberOfMachinesDoneSendingVertices;
 	bool*m_initialisedAcademy;
 	int*m_repeatedLength;
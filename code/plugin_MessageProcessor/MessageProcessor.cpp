@@ -22,6 +22,7 @@
 //#define GUILLIMIN_BUG
 
 #include <application_core/constants.h>
+#include <application_core/CheckpointFile.h>
 #include <string.h>
 #include <core/OperatingSystem.h>
 #include <assert.h>
@@ -81,6 +82,8 @@ __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_E
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_REQUEST_VERTEX_EDGES); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_REQUEST_VERTEX_EDGES_REPLY); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY); /**/
+__CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES); /**/
+__CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_SEEDING_IS_OVER); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_REQUEST_SEED_LENGTHS); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_SEND_SEED_LENGTHS); /**/
@@ -135,7 +138,6 @@ __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_ELIMINATE_PATH); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_VERTEX); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_GET_PATH_VERTEX_REPLY); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS); /**/
-__CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS_REPLY); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION_IS_DONE); /**/
 __CreateMessageTagAdapter(MessageProcessor,RAY_MPI_TAG_LIBRARY_DISTANCE_REPLY); /**/
@@ -617,7 +619,7 @@ void MessageProcessor::call_RAY_MPI_TAG_START_INDEXING_SEQUENCES(Message*message
 	/* read the Graph checkpoint here */
 	if(m_parameters->hasCheckpoint("GenomeGraph")){
 		cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint GenomeGraph"<<endl;
-		ifstream f(m_parameters->getCheckpointFile("GenomeGraph").c_str());
+		CheckpointReader f(m_parameters,"GenomeGraph");
 		LargeCount n=0;
 		f.read((char*)&n,sizeof(LargeCount));
 
@@ -682,7 +684,7 @@ void MessageProcessor::call_RAY_MPI_TAG_START_INDEXING_SEQUENCES(Message*message
 		cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint GenomeGraph"<<endl;
 		cout.flush();
 
-		ofstream f(m_parameters->getCheckpointFile("GenomeGraph").c_str());
+		CheckpointWriter f(m_parameters,"GenomeGraph");
 
 		GridTableIterator iterator;
 		iterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
@@ -920,6 +922,8 @@ void MessageProcessor::call_RAY_MPI_TAG_PREPARE_COVERAGE_DISTRIBUTION(Message*me
 	printf("Rank %i has %i k-mers (completed)\n",m_rank,(int)m_subgraph->getKmerAcademy()->size());
 	fflush(stdout);
 
+	m_subgraph->getKmerAcademy()->printEvictionStatistics();
+
 	#if 0
 	m_subgraph->getKmerAcademy()->printStatistics();
 	#endif
@@ -981,7 +985,7 @@ void MessageProcessor::call_RAY_MPI_TAG_START_SEEDING(Message*message){
 	
 	if(m_parameters->hasCheckpoint("OptimalMarkers") && m_parameters->hasCheckpoint("ReadOffsets")){
 		cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint ReadOffsets"<<endl;
-		ifstream f(m_parameters->getCheckpointFile("ReadOffsets").c_str());
+		CheckpointReader f(m_parameters,"ReadOffsets");
 		LargeCount n=0;
 		f.read((char*)&n,sizeof(LargeCount));
 		for(LargeIndex i=0;i<n;i++){
@@ -990,7 +994,7 @@ void MessageProcessor::call_RAY_MPI_TAG_START_SEEDING(Message*message){
 		f.close();
 
 		cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint OptimalMarkers"<<endl;
-		ifstream f2(m_parameters->getCheckpointFile("OptimalMarkers").c_str());
+		CheckpointReader f2(m_parameters,"OptimalMarkers");
 
 		n=0;
 		f2.read((char*)&n,sizeof(LargeCount));
@@ -1038,7 +1042,7 @@ void MessageProcessor::call_RAY_MPI_TAG_START_SEEDING(Message*message){
 	/* write checkpoint */
 	if(m_parameters->writeCheckpoints() && !m_parameters->hasCheckpoint("OptimalMarkers")){
 		cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint ReadOffsets"<<endl;
-		ofstream f(m_parameters->getCheckpointFile("ReadOffsets").c_str());
+		CheckpointWriter f(m_parameters,"ReadOffsets");
 		LargeCount count=m_myReads->size();
 		f.write((char*)&count,sizeof(LargeCount));
 		for(int i=0;i<(int)m_myReads->size();i++){
@@ -1047,7 +1051,7 @@ void MessageProcessor::call_RAY_MPI_TAG_START_SEEDING(Message*message){
 		f.close();
 	
 		cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint OptimalMarkers"<<endl;
-		ofstream f2(m_parameters->getCheckpointFile("OptimalMarkers").c_str());
+		CheckpointWriter f2(m_parameters,"OptimalMarkers");
 
 		GridTableIterator iterator;
 		iterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
@@ -1233,6 +1237,59 @@ void MessageProcessor::call_RAY_MPI_TAG_REQUEST_VERTEX_EDGES_REPLY(Message*messa
 	(m_seedingData->m_SEEDING_edgesReceived)=true;
 }
 
+/**
+ * Coverage and children of many vertices for DepthFirstSearchData.
+ * Each vertex takes DEPTH_FIRST_SEARCH_REPLY_PERIOD elements in the reply.
+ */
+void MessageProcessor::call_RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES(Message*message){
+	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
+	int count=message->getCount();
+	int vertices=count/KMER_U64_ARRAY_SIZE;
+	MessageUnit*message2=(MessageUnit*)m_outboxAllocator->allocate(vertices*DEPTH_FIRST_SEARCH_REPLY_PERIOD*sizeof(MessageUnit));
+	int outputPosition=0;
+
+	for(int i=0;i<vertices;i++){
+		Kmer vertex;
+		int bufferPosition=i*KMER_U64_ARRAY_SIZE;
+		vertex.unpack(incoming,&bufferPosition);
+
+		Vertex*node=m_subgraph->find(&vertex);
+
+		// if it is not there, then it has a coverage of 0
+		CoverageDepth coverage=0;
+		vector<Kmer> outgoingEdges;
+
+		if(node!=NULL){
+			coverage=node->getCoverage(&vertex);
+			outgoingEdges=node->getOutgoingEdges(&vertex,*m_wordSize);
+		}
+
+		outputPosition=i*DEPTH_FIRST_SEARCH_REPLY_PERIOD;
+		vertex.pack(message2,&outputPosition);
+		message2[outputPosition++]=coverage;
+		message2[outputPosition++]=outgoingEdges.size();
+
+		for(int j=0;j<(int)outgoingEdges.size();j++){
+			outgoingEdges[j].pack(message2,&outputPosition);
+		}
+	}
+
+	Message aMessage(message2,vertices*DEPTH_FIRST_SEARCH_REPLY_PERIOD,message->getSource(),
+		RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY,m_rank);
+	m_outbox->push_back(aMessage);
+}
+
+void MessageProcessor::call_RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY(Message*message){
+	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
+	int count=message->getCount();
+
+	for(int i=0;i<count;i++){
+		m_seedingData->m_SEEDING_receivedVertexData.push_back(incoming[i]);
+	}
+
+	m_seedingData->m_SEEDING_receivedVertexReplies++;
+}
+
 void MessageProcessor::call_RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY(Message*message){
 	void*buffer=message->getBuffer();
 	MessageUnit*incoming=(MessageUnit*)buffer;
@@ -1409,6 +1466,7 @@ void MessageProcessor::call_RAY_MPI_TAG_EXTENSION_DATA(Message*message){
 
 void MessageProcessor::call_RAY_MPI_TAG_EXTENSION_DATA_END(Message*message){
 	(m_ed->m_EXTENSION_currentRankIsDone)=true;
+	(m_ed->m_EXTENSION_numberOfRanksDone)++;
 }
 
 void MessageProcessor::call_RAY_MPI_TAG_ATTACH_SEQUENCE(Message*message){
@@ -1577,6 +1635,13 @@ void MessageProcessor::call_RAY_MPI_TAG_FUSION_DONE(Message*message){
 		(*m_nextReductionOccured)=true;
 	}
 
+	/* statistics of the round */
+	if(message->getCount()>=4){
+		m_fusionData->m_FUSION_examinedPaths+=incoming[1];
+		m_fusionData->m_FUSION_skippedPaths+=incoming[2];
+		m_fusionData->m_FUSION_removedPaths+=incoming[3];
+	}
+
 	m_fusionData->m_FUSION_numberOfRanksDone++;
 	if(m_fusionData->m_FUSION_numberOfRanksDone==m_size && !(*m_isFinalFusion)){
 		(*m_master_mode)=RAY_MASTER_MODE_TRIGGER_FIRST_FUSIONS;
@@ -1996,9 +2061,14 @@ void MessageProcessor::call_RAY_MPI_TAG_CLEAR_DIRECTIONS(Message*message){
 
 	m_fusionData->m_FINISH_newFusions.clear();
 
-	vector<vector<Kmer> > fusions;
+	vector<ContigPath> fusions;
+
+	/* isolated paths keep their status with their new identifiers */
+	vector<bool> isolated;
+
 	for(int i=0;i<(int)(m_ed->m_EXTENSION_contigs).size();i++){
 		bool eliminated=false;
+		bool isolatedPath=false;
 
 		/* it is not a new one */
 		if(i<(int)m_ed->m_EXTENSION_identifiers.size()){
@@ -2007,25 +2077,27 @@ void MessageProcessor::call_RAY_MPI_TAG_CLEAR_DIRECTIONS(Message*message){
 			if(m_fusionData->m_FUSION_eliminated.count(id)>0){
 				eliminated=true;
 			}
+
+			isolatedPath=m_fusionData->m_FUSION_isolated.count(id)>0;
 		}
 
 		if(!eliminated){
 			fusions.push_back((m_ed->m_EXTENSION_contigs)[i]);
+			isolated.push_back(isolatedPath);
 			if(!appendReverseComplement){
 				continue;
 			}
 
-			vector<Kmer> rc;
-			for(int j=(m_ed->m_EXTENSION_contigs)[i].size()-1;j>=0;j--){
-				rc.push_back(m_ed->m_EXTENSION_contigs[i][j].complementVertex(*m_wordSize,
-					m_parameters->getColorSpaceMode()));
-			}
+			ContigPath rc;
+			(m_ed->m_EXTENSION_contigs)[i].getReverseComplement(m_parameters->getColorSpaceMode(),&rc);
 			fusions.push_back(rc);
+			isolated.push_back(false);
 		}
 	}
 
 	(m_ed->m_EXTENSION_identifiers).clear();
 	m_fusionData->m_FUSION_eliminated.clear();
+	m_fusionData->m_FUSION_isolated.clear();
 
 	for(int i=0;i<(int)fusions.size();i++){
 		PathHandle id=getPathUniqueId(m_rank,i);
@@ -2036,6 +2108,9 @@ void MessageProcessor::call_RAY_MPI_TAG_CLEAR_DIRECTIONS(Message*message){
 		assert((int)getRankFromPathUniqueId(id)<m_size);
 		#endif
 		(m_ed->m_EXTENSION_identifiers).push_back(id);
+
+		if(isolated[i])
+			m_fusionData->m_FUSION_isolated.insert(id);
 	}
 
 	m_fusionData->m_FUSION_identifier_map.clear();
@@ -2057,7 +2132,7 @@ void MessageProcessor::call_RAY_MPI_TAG_CLEAR_DIRECTIONS(Message*message){
 	assert(m_fusionData->m_FUSION_identifier_map.size()==m_ed->m_EXTENSION_contigs.size());
 	#endif
 
-	cout<<"Rank "<<m_parameters->getRank()<<" cleared, "<<m_ed->m_EXTENSION_contigs.size()<<" paths"<<endl;
+	cout<<"Rank "<<m_parameters->getRank()<<" cleared, "<<m_ed->m_EXTENSION_contigs.size()<<" paths, "<<m_fusionData->m_FUSION_isolated.size()<<" isolated"<<endl;
 
 	Message aMessage(NULL,0,source,RAY_MPI_TAG_CLEAR_DIRECTIONS_REPLY,m_rank);
 	m_outbox->push_back(aMessage);
@@ -2085,6 +2160,13 @@ void MessageProcessor::call_RAY_MPI_TAG_FINISH_FUSIONS_FINISHED(Message*message)
 		(*m_nextReductionOccured)=true;
 	}
 
+	/* statistics of the round */
+	if(message->getCount()>=4){
+		m_fusionData->m_FINISH_examinedPaths+=incoming[1];
+		m_fusionData->m_FINISH_skippedPaths+=incoming[2];
+		m_fusionData->m_FINISH_removedPaths+=incoming[3];
+	}
+
 	(*m_FINISH_n)++;
 }
 
@@ -2146,7 +2228,7 @@ void MessageProcessor::call_RAY_MPI_TAG_GET_PATH_VERTEX(Message*message){
 		assert(position<(int)(m_ed->m_EXTENSION_contigs)[m_fusionData->m_FUSION_identifier_map[id]].size());
 		#endif
 
-		Kmer a=(m_ed->m_EXTENSION_contigs)[m_fusionData->m_FUSION_identifier_map[id]][position];
+		Kmer a=(m_ed->m_EXTENSION_contigs)[m_fusionData->m_FUSION_identifier_map[id]].at(position);
 		int pos=i;
 		a.pack(messageBytes,&pos);
 	}
@@ -2168,15 +2250,10 @@ void MessageProcessor::call_RAY_MPI_TAG_WRITE_AMOS(Message*message){
 	m_ed->m_EXTENSION_currentPosition=((MessageUnit*)message->getBuffer())[0];
 }
 
-void MessageProcessor::call_RAY_MPI_TAG_WRITE_AMOS_REPLY(Message*message){
-	m_ed->m_EXTENSION_currentRankIsDone=true;
-	m_ed->m_EXTENSION_currentPosition=((MessageUnit*)message->getBuffer())[0];
-}
-
 void MessageProcessor::call_RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION(Message*message){
 	/* write the Seeds checkpoint */
 	if(m_parameters->writeCheckpoints() && !m_parameters->hasCheckpoint("Seeds")){
-		ofstream f(m_parameters->getCheckpointFile("Seeds").c_str());
+		CheckpointWriter f(m_parameters,"Seeds");
 		cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint Seeds"<<endl;
 		int count=m_seedingData->m_SEEDING_seeds.size();
 		f.write((char*)&count,sizeof(int));
@@ -2295,9 +2372,12 @@ void MessageProcessor::call_RAY_MPI_TAG_KMER_ACADEMY_DATA(Message*message){
 		assert(tmp!=NULL);
 		#endif
 
+		CoverageHistogram*histogram=m_subgraph->getKmerAcademy()->getCoverageHistogram();
+
 		/** start at 1 since this step was avoided by the BloomFilter */
 		if(m_subgraph->insertedInAcademy()){
 			tmp->m_count=1;
+			histogram->add(tmp->m_count,1);
 		}
 
 		CoverageDepth oldValue=tmp->m_count;
@@ -2305,7 +2385,13 @@ void MessageProcessor::call_RAY_MPI_TAG_KMER_ACADEMY_DATA(Message*message){
 			tmp->m_count++;
 		if(tmp->m_count<oldValue)
 			tmp->m_count=oldValue; /* avoids overflow */
+
+		histogram->move(oldValue,tmp->m_count);
 	}
+
+	if(m_subgraph->getKmerAcademy()->isAboveBudget())
+		m_subgraph->getKmerAcademy()->evictSingletons();
+
 	Message aMessage(NULL,0,message->getSource(),RAY_MPI_TAG_KMER_ACADEMY_DATA_REPLY,m_rank);
 	m_outbox->push_back(aMessage);
 }
@@ -2391,17 +2477,28 @@ void MessageProcessor::call_RAY_MPI_TAG_GET_CONTIG_CHUNK(Message*message){
 	PathHandle contigId=incoming[0];
 	int position=incoming[1];
 	int index=m_fusionData->m_FUSION_identifier_map[contigId];
-	int length=m_ed->m_EXTENSION_contigs[index].size();
+	ContigPath*path=&(m_ed->m_EXTENSION_contigs[index]);
+	int length=path->size();
 	MessageUnit*messageContent=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+	int maximumPosition=MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit);
 	int outputPosition=0;
 	int origin=outputPosition;
 	outputPosition++;
 	int count=0;
 
-	while(position<length
-	 && (outputPosition+KMER_U64_ARRAY_SIZE)<(int)(MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit))){
-		m_ed->m_EXTENSION_contigs[index][position++].pack(messageContent,&outputPosition);
-		count++;
+	/* the first k-mer is sent in full */
+	Kmer first=path->at(position++);
+	first.pack(messageContent,&outputPosition);
+	count++;
+
+	/* the other ones are sent as their last nucleotide, 32 per message unit */
+	while(position<length && outputPosition<maximumPosition){
+		MessageUnit codes=0;
+		for(int i=0;i<32 && position<length;i++){
+			codes|=((MessageUnit)path->getCode(position++))<<(2*i);
+			count++;
+		}
+		messageContent[outputPosition++]=codes;
 	}
 	messageContent[origin]=count;
 	Message aMessage(messageContent,
@@ -2700,6 +2797,14 @@ void MessageProcessor::registerPlugin(ComputeCore*core){
 	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY, __GetAdapter(MessageProcessor,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY));
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY,"RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY");
 
+	RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES, __GetAdapter(MessageProcessor,RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES,"RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES");
+
+	RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY, __GetAdapter(MessageProcessor,RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY,"RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY");
+
 	RAY_MPI_TAG_SEEDING_IS_OVER=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_SEEDING_IS_OVER, __GetAdapter(MessageProcessor,RAY_MPI_TAG_SEEDING_IS_OVER));
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_SEEDING_IS_OVER,"RAY_MPI_TAG_SEEDING_IS_OVER");
@@ -2918,7 +3023,6 @@ void MessageProcessor::registerPlugin(ComputeCore*core){
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_WRITE_AMOS,"RAY_MPI_TAG_WRITE_AMOS");
 
 	RAY_MPI_TAG_WRITE_AMOS_REPLY=core->allocateMessageTagHandle(plugin);
-	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_WRITE_AMOS_REPLY, __GetAdapter(MessageProcessor,RAY_MPI_TAG_WRITE_AMOS_REPLY));
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_WRITE_AMOS_REPLY,"RAY_MPI_TAG_WRITE_AMOS_REPLY");
 
 	RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION=core->allocateMessageTagHandle(plugin);
@@ -3029,6 +3133,8 @@ void MessageProcessor::resolveSymbols(ComputeCore*core){
 	RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES");
 	RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY");
 	RAY_MPI_TAG_REQUEST_VERTEX_READS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_READS");
+	RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES");
+	RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY");
 	RAY_MPI_TAG_REQUEST_VERTEX_READS_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_READS_REPLY");
 	RAY_MPI_TAG_SAVE_WAVE_PROGRESSION=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_SAVE_WAVE_PROGRESSION");
 	RAY_MPI_TAG_SAVE_WAVE_PROGRESSION_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_SAVE_WAVE_PROGRESSION_REPLY");
@@ -3179,6 +3285,7 @@ void MessageProcessor::resolveSymbols(ComputeCore*core){
 	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_VERTEX_INFO,                  RAY_MPI_TAG_VERTEX_INFO_REPLY );
 	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_REQUEST_READ_SEQUENCE,                RAY_MPI_TAG_REQUEST_READ_SEQUENCE_REPLY );
 	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,        RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY );
+	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES,  RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY );
 	core->setMessageTagReplyMessageTag(m_plugin, RAY_MPI_TAG_TEST_NETWORK_MESSAGE,                 RAY_MPI_TAG_TEST_NETWORK_MESSAGE_REPLY );
 
 	core->setMessageTagSize(m_plugin, RAY_MPI_TAG_GET_CONTIG_CHUNK,             MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit) );
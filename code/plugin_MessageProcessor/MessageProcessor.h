@@ -90,6 +90,8 @@ class MessageProcessor :  public CorePlugin {
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS_REPLY;
+	MessageTag RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES;
+	MessageTag RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY;
 	MessageTag RAY_MPI_TAG_SAVE_WAVE_PROGRESSION;
 	MessageTag RAY_MPI_TAG_SAVE_WAVE_PROGRESSION_REPLY;
 	MessageTag RAY_MPI_TAG_SAVE_WAVE_PROGRESSION_WITH_REPLY;
@@ -414,6 +416,8 @@ SequencesIndexer*m_si
 	void call_RAY_MPI_TAG_REQUEST_VERTEX_EDGES(Message*message);
 	void call_RAY_MPI_TAG_REQUEST_VERTEX_EDGES_REPLY(Message*message);
 	void call_RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES_REPLY(Message*message);
+	void call_RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES(Message*message);
+	void call_RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES_REPLY(Message*message);
 	void call_RAY_MPI_TAG_SEEDING_IS_OVER(Message*message);
 	void call_RAY_MPI_TAG_REQUEST_SEED_LENGTHS(Message*message);
 	void call_RAY_MPI_TAG_SEND_SEED_LENGTHS(Message*message);
@@ -468,7 +472,6 @@ SequencesIndexer*m_si
 	void call_RAY_MPI_TAG_GET_PATH_VERTEX(Message*message);
 	void call_RAY_MPI_TAG_GET_PATH_VERTEX_REPLY(Message*message);
 	void call_RAY_MPI_TAG_WRITE_AMOS(Message*message);
-	void call_RAY_MPI_TAG_WRITE_AMOS_REPLY(Message*message);
 	void call_RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION(Message*message);
 	void call_RAY_MPI_TAG_AUTOMATIC_DISTANCE_DETECTION_IS_DONE(Message*message);
 	void call_RAY_MPI_TAG_LIBRARY_DISTANCE_REPLY(Message*message);
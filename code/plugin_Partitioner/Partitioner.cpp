@@ -20,6 +20,7 @@
 */
 
 #include <plugin_Partitioner/Partitioner.h>
+#include <application_core/CheckpointFile.h>
 #include <core/OperatingSystem.h>
 
 #include <stdlib.h>
@@ -164,7 +165,7 @@ void Partitioner::call_RAY_SLAVE_MODE_COUNT_FILE_ENTRIES(){
 		
 		/* possibly read the checkpoint */
 		if(m_parameters->hasCheckpoint("Partition")){
-			ifstream f(m_parameters->getCheckpointFile("Partition").c_str());
+			CheckpointReader f(m_parameters,"Partition");
 			cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint Partition"<<endl;
 			int count=0;
 			f.read((char*)&count,sizeof(int));
@@ -198,7 +199,7 @@ void Partitioner::call_RAY_SLAVE_MODE_COUNT_FILE_ENTRIES(){
 
 		/* Here we write the checkpoint Partition */
 		if(m_parameters->writeCheckpoints() && !m_parameters->hasCheckpoint("Partition")){
-			ofstream f(m_parameters->getCheckpointFile("Partition").c_str());
+			CheckpointWriter f(m_parameters,"Partition");
 			cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint Partition"<<endl;
 			int count=m_slaveCounts.size();
 			f.write((char*)&count,sizeof(int));
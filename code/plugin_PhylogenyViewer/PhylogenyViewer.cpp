@@ -310,6 +310,8 @@ void PhylogenyViewer::call_RAY_MPI_TAG_TOUCH_TAXON(Message*message){
 void PhylogenyViewer::loadTree(){
 	
 	if(!m_parameters->hasOption("-with-taxonomy")){
+		buildTaxonomyIndex();
+
 		m_loadedTree=true;
 
 		return;
@@ -345,8 +347,6 @@ void PhylogenyViewer::loadTree(){
 				
 				m_taxonsForPhylogeny.insert(parent);
 
-				m_treeChildren[parent].insert(child);
-	
 				m_treeParents[child]=parent;
 			}
 		}
@@ -363,6 +363,8 @@ void PhylogenyViewer::loadTree(){
 	// load taxonNames
 	loadTaxonNames();
 
+	buildTaxonomyIndex();
+
 	// don't test paths in production
 	//testPaths();
 
@@ -371,6 +373,19 @@ void PhylogenyViewer::loadTree(){
 	m_gatheredObservations=false;
 }
 
+void PhylogenyViewer::buildTaxonomyIndex(){
+	m_taxonomyIndex.build(&m_taxonsForPhylogeny,&m_treeParents,&m_genomeToTaxon);
+
+	// the index has everything now
+	m_treeParents.clear();
+
+	m_selfObservations.clear();
+	m_selfObservations.resize(m_taxonomyIndex.size(),0);
+
+	cout<<"Rank "<<m_rank<<" indexed "<<m_taxonomyIndex.size()<<" taxons and ";
+	cout<<m_taxonomyIndex.getNumberOfGenomes()<<" genomes"<<endl;
+}
+
 void PhylogenyViewer::gatherKmerObservations(){
 
 	/* set to true to use only assembled kmers */
@@ -436,7 +451,7 @@ void PhylogenyViewer::gatherKmerObservations(){
 		VirtualKmerColorHandle color=node->getVirtualColor();
 		set<PhysicalKmerColor>*physicalColors=m_colorSet->getPhysicalColors(color);
 
-		vector<TaxonIdentifier> taxons;
+		m_kmerTaxons.clear();
 
 		// get a list of taxons associated with this kmer
 		for(set<PhysicalKmerColor>::iterator j=physicalColors->begin();
@@ -457,11 +472,13 @@ void PhylogenyViewer::gatherKmerObservations(){
 
 				//assert(m_colorsForPhylogeny.count(colorForPhylogeny)>0);
 
+				TaxonIndex taxon=m_taxonomyIndex.getTaxonOfGenome(colorForPhylogeny);
+
 				// this means that this genome is not in the taxonomy tree
-				if(m_genomeToTaxon.count(colorForPhylogeny)==0){
+				if(taxon==TAXON_INDEX_NONE){
 
 					if(m_warnings.count(colorForPhylogeny)==0){
-						cout<<"Warning, color "<<colorForPhylogeny<<" is not stored, "<<m_genomeToTaxon.size()<<" available. This means that you provided a genome sequence that is not classified in the taxonomy."<<endl;
+						cout<<"Warning, color "<<colorForPhylogeny<<" is not stored, "<<m_taxonomyIndex.getNumberOfGenomes()<<" available. This means that you provided a genome sequence that is not classified in the taxonomy."<<endl;
 
 						#ifdef VERBOSE
 						for(map<GenomeIdentifier,TaxonIdentifier>::iterator i=m_genomeToTaxon.begin();i!=m_genomeToTaxon.end();i++){
@@ -476,19 +493,13 @@ void PhylogenyViewer::gatherKmerObservations(){
 					continue;
 				}
 
-				#ifdef ASSERT
-				assert(m_genomeToTaxon.count(colorForPhylogeny)>0);
-				#endif
-
-				TaxonIdentifier taxon=m_genomeToTaxon[colorForPhylogeny];
-
-				taxons.push_back(taxon);
+				m_kmerTaxons.push_back(taxon);
 			}
 		}
 
-		classifySignal(&taxons,kmerCoverage,node,&key);
+		classifySignal(&m_kmerTaxons,kmerCoverage,node,&key);
 
-		int count=taxons.size();
+		int count=m_kmerTaxons.size();
 
 		frequencies[count]++;
 	}
@@ -507,6 +518,14 @@ void PhylogenyViewer::gatherKmerObservations(){
 	cout<<"Taxon observations"<<endl;
 */
 
+	// move the counts in the table that is sent to the master
+	for(TaxonIndex i=0;i<(int)m_selfObservations.size();i++){
+		if(m_selfObservations[i]>0)
+			m_taxonObservations[m_taxonomyIndex.getTaxon(i)]+=m_selfObservations[i];
+	}
+
+	m_selfObservations.clear();
+
 	//showObservations(&cout);
 
 	m_gatheredObservations=true;
@@ -561,6 +580,8 @@ void PhylogenyViewer::showObservations_XML(ostream*stream){
 	map<string,LargeCount> rankRecursiveObservations;
 	map<string,LargeCount> rankSelfObservations;
 
+	computeRecursiveObservations();
+
 	populateRanks(&rankSelfObservations,&rankRecursiveObservations);
 
 	operationBuffer<<"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"<<endl;
@@ -614,6 +635,25 @@ void PhylogenyViewer::showObservations_XML(ostream*stream){
 	map<string,FILE*> tsvFiles;
 	map<string,ostringstream*> tsvBuffers;
 
+	// optional columnar output, with the same content as the entries
+	ostringstream tableFile;
+	tableFile<<m_parameters->getPrefix()<<"/BiologicalAbundances/"<<ABUNDANCE_TABLE_FILE;
+
+	AbundanceTable taxonTable;
+	taxonTable.constructor(tableFile.str().c_str(),ABUNDANCE_TABLE_TAXONS,m_rank,
+		m_parameters->hasOption("-write-abundance-tables"));
+
+	taxonTable.addColumn("identifier",ABUNDANCE_COLUMN_INTEGER);
+	taxonTable.addColumn("name",ABUNDANCE_COLUMN_TEXT);
+	taxonTable.addColumn("rank",ABUNDANCE_COLUMN_TEXT);
+	taxonTable.addColumn("selfKmerObservations",ABUNDANCE_COLUMN_INTEGER);
+	taxonTable.addColumn("selfProportion",ABUNDANCE_COLUMN_REAL);
+	taxonTable.addColumn("selfColoredProportion",ABUNDANCE_COLUMN_REAL);
+	taxonTable.addColumn("recursiveKmerObservations",ABUNDANCE_COLUMN_INTEGER);
+	taxonTable.addColumn("recursiveProportion",ABUNDANCE_COLUMN_REAL);
+	taxonTable.addColumn("recursiveColoredProportion",ABUNDANCE_COLUMN_REAL);
+	taxonTable.addColumn("coloredProportionInRank",ABUNDANCE_COLUMN_REAL);
+
 	for(map<TaxonIdentifier,string>::iterator i=m_taxonNames.begin();
 		i!=m_taxonNames.end();i++){
 
@@ -726,8 +766,23 @@ void PhylogenyViewer::showObservations_XML(ostream*stream){
 
 		*(tsvBuffers[rank])<<taxon<<"	"<<name<<"	"<<rank;
 		*(tsvBuffers[rank])<<"	"<<coloredRatioInRank<<endl;
+
+		int column=0;
+		taxonTable.addInteger(column++,taxon);
+		taxonTable.addText(column++,name.c_str());
+		taxonTable.addText(column++,rank.c_str());
+		taxonTable.addInteger(column++,count);
+		taxonTable.addReal(column++,ratio);
+		taxonTable.addReal(column++,coloredRatio);
+		taxonTable.addInteger(column++,recursiveCount);
+		taxonTable.addReal(column++,ratio2);
+		taxonTable.addReal(column++,coloredRatio2);
+		taxonTable.addReal(column++,coloredRatioInRank);
+		taxonTable.endRow();
 	}
 
+	taxonTable.flush();
+
 	// close XML files
 	operationBuffer<<"</root>"<<endl;
 	flushFileOperationBuffer(true,&operationBuffer,stream,CONFIG_FILE_IO_BUFFER_SIZE);
@@ -754,31 +809,30 @@ void PhylogenyViewer::showObservations_XML(ostream*stream){
 
 LargeCount PhylogenyViewer::getRecursiveCount(TaxonIdentifier taxon){
 
-	if(m_taxonRecursiveObservations.count(taxon)>0){
-
-		#ifdef DEBUG_RECURSION
-		cout<<"[fast return] for taxon "<<getTaxonName(taxon)<<" value= ";
-		cout<<m_taxonRecursiveObservations[taxon]<<endl;
-		#endif
+	TaxonIndex index=m_taxonomyIndex.getIndex(taxon);
 
-		return m_taxonRecursiveObservations[taxon];
+	if(index==TAXON_INDEX_NONE || index>=(int)m_recursiveObservations.size()){
+		return getSelfCount(taxon);
 	}
 
-	LargeCount count=getSelfCount(taxon);
+	return m_recursiveObservations[index];
+}
 
-	if(m_treeChildren.count(taxon)>0){
-		for(set<TaxonIdentifier>::iterator i=m_treeChildren[taxon].begin();
-			i!=m_treeChildren[taxon].end();i++){
-			
-			TaxonIdentifier child=*i;
+/* one pass over the tree, children before parents */
+void PhylogenyViewer::computeRecursiveObservations(){
 
-			count+=getRecursiveCount(child);
-		}
-	}
+	vector<LargeCount> selfObservations(m_taxonomyIndex.size(),0);
+
+	for(map<TaxonIdentifier,LargeCount>::iterator i=m_taxonObservations.begin();
+		i!=m_taxonObservations.end();i++){
+
+		TaxonIndex index=m_taxonomyIndex.getIndex(i->first);
 
-	m_taxonRecursiveObservations[taxon]=count;
+		if(index!=TAXON_INDEX_NONE)
+			selfObservations[index]=i->second;
+	}
 
-	return count;
+	m_taxonomyIndex.computeRecursiveCounts(&selfObservations,&m_recursiveObservations);
 }
 
 void PhylogenyViewer::showObservations(ostream*stream){
@@ -807,7 +861,7 @@ void PhylogenyViewer::showObservations(ostream*stream){
 	(*stream)<<" k-mer observations: "<<m_unknown<<endl;
 }
 
-void PhylogenyViewer::classifySignal(vector<TaxonIdentifier>*taxons,int kmerCoverage,Vertex*vertex,Kmer*key){
+void PhylogenyViewer::classifySignal(vector<TaxonIndex>*taxons,int kmerCoverage,Vertex*vertex,Kmer*key){
 	// given a list of taxon,
 	// place the kmer coverage somewhere in
 	// the tree
@@ -832,9 +886,9 @@ void PhylogenyViewer::classifySignal(vector<TaxonIdentifier>*taxons,int kmerCove
 		m_unknown+=kmerCoverage; // case 1.
 
 	}else if(taxons->size()==1){
-		TaxonIdentifier taxon=taxons->at(0);
+		TaxonIndex taxon=taxons->at(0);
 
-		m_taxonObservations[taxon]+=kmerCoverage; // case 2.
+		m_selfObservations[taxon]+=kmerCoverage; // case 2.
 
 	}else{ // more than 1
 
@@ -845,43 +899,37 @@ void PhylogenyViewer::classifySignal(vector<TaxonIdentifier>*taxons,int kmerCove
 		// a taxon can only have one parent,
 		// simply check if they have all the same parent...
 
-		map<TaxonIdentifier,int> parentCount;
+		m_kmerParents.clear();
 
-		int found=0;
+		bool sameParent=true;
 
 		for(int i=0;i<(int)taxons->size();i++){
-			TaxonIdentifier taxon=taxons->at(i);
+			TaxonIndex taxon=taxons->at(i);
+			TaxonIndex parent=m_taxonomyIndex.getParent(taxon);
 
-			if(m_treeParents.count(taxon)==0){
+			if(parent==TAXON_INDEX_NONE){
 				
-				cout<<"Warning: Taxon "<<taxon<<" is not in the tree"<<endl;
+				cout<<"Warning: Taxon "<<m_taxonomyIndex.getTaxon(taxon)<<" is not in the tree"<<endl;
 				continue;
 			}
 
-			TaxonIdentifier parent=getTaxonParent(taxon);
+			if(!m_kmerParents.empty() && parent!=m_kmerParents[0])
+				sameParent=false;
 
-			parentCount[parent]++;
-			found++;
+			m_kmerParents.push_back(parent);
 		}
 
-		if(parentCount.size()==1){ // only 1 common ancestor, easy
-			
-			#ifdef ASSERT
-			if(!(parentCount.begin()->second == found)){
-				cout<<"Error: taxons: "<<taxons->size()<<", parentCount: "<<parentCount.size()<<" 1 element with "<<parentCount.begin()->second<<" taxons"<<endl;
-			}
-			assert(parentCount.begin()->second == found);
-			#endif
-
-			TaxonIdentifier taxon=parentCount.begin()->first;
-
-			m_taxonObservations[taxon]+=kmerCoverage; // case 3.
-
+		if(m_kmerParents.size()==0){
+			cout<<"Error, no parents, returning now."<<endl;
 			return;
 		}
 
-		if(parentCount.size()==0){
-			cout<<"Error, no parents, returning now."<<endl;
+		if(sameParent){ // only 1 common ancestor, easy
+			
+			TaxonIndex taxon=m_kmerParents[0];
+
+			m_selfObservations[taxon]+=kmerCoverage; // case 3.
+
 			return;
 		}
 
@@ -891,74 +939,36 @@ void PhylogenyViewer::classifySignal(vector<TaxonIdentifier>*taxons,int kmerCove
 		// since we have a tree, find the nearest common ancestor
 		// in the worst case, the common ancestor is the root
 
-		#ifdef ASSERT
-		assert(parentCount.size()>1);
-		#endif
-
-		TaxonIdentifier taxon=findCommonAncestor(taxons);
-
-		// classify it
-		m_taxonObservations[taxon]+=kmerCoverage; // case 4.
-	}
-}
-
-TaxonIdentifier PhylogenyViewer::findCommonAncestor(vector<TaxonIdentifier>*taxons){
-
-	map<TaxonIdentifier,int> counts;
-
-	// for a deep tree, this algorithm would not be really fast.
-	// so instead of computing path to the root,
-	// the algorithm should stop when one ancestor is found
-
-	vector<TaxonIdentifier> currentTaxons;
-
-	for(int i=0;i<(int)taxons->size();i++){
-		TaxonIdentifier taxon=taxons->at(i);
-		currentTaxons.push_back(taxon);
-	}
-
-	while(1){
-		int blocked=0;
+		TaxonIndex taxon=TAXON_INDEX_NONE;
 
-		// compute each path to the root
-		for(int i=0;i<(int)currentTaxons.size();i++){
-			TaxonIdentifier taxon=currentTaxons[i];
+		if(m_kmerParents.size()==taxons->size())
+			taxon=findCommonAncestor(&m_kmerParents);
 
-			// no more parents
-			if(m_treeParents.count(taxon)==0){
-				blocked++;
-				continue;
-			}
-
-			TaxonIdentifier parent=m_treeParents[taxon];
+		if(taxon==TAXON_INDEX_NONE){
+			cout<<"Error, this is not a tree, taxons: "<<taxons->size()<<" parents: "<<m_kmerParents.size()<<endl;
 
-			counts[parent]++;
-
-			// we found a common ancestor
-			// this is the deepest
-			if(counts[parent]==(int)currentTaxons.size()){ 
-				return parent;
-			}
-			
-			currentTaxons[i]=parent; // update it
+			m_taxonObservations[999999999999]+=kmerCoverage;
+			return;
 		}
 
-		if(blocked==(int)currentTaxons.size()){ // this will happen if it is not a tree
-			
-			cout<<"Error, this is not a tree, blocked: "<<blocked<<" currentTaxons: "<<currentTaxons.size()<<endl;
-			break;
-		}
+		// classify it
+		m_selfObservations[taxon]+=kmerCoverage; // case 4.
 	}
-
-	return 999999999999;
 }
 
-TaxonIdentifier PhylogenyViewer::getTaxonParent(TaxonIdentifier taxon){
-	if(m_treeParents.count(taxon)>0){
-		return m_treeParents[taxon];
+/**
+ * The common ancestor of the parents of the taxons is
+ * the deepest taxon that is above all the taxons.
+ */
+TaxonIndex PhylogenyViewer::findCommonAncestor(vector<TaxonIndex>*taxons){
+
+	TaxonIndex ancestor=taxons->at(0);
+
+	for(int i=1;i<(int)taxons->size() && ancestor!=TAXON_INDEX_NONE;i++){
+		ancestor=m_taxonomyIndex.getLowestCommonAncestor(ancestor,taxons->at(i));
 	}
 
-	return 999999999999;
+	return ancestor;
 }
 
 void PhylogenyViewer::loadTaxonNames(){
@@ -1081,10 +1091,12 @@ void PhylogenyViewer::getTaxonPathFromRoot(TaxonIdentifier taxon,vector<TaxonIde
 
 	int maximum=100;
 
-	while(m_treeParents.count(current)>0){
-		TaxonIdentifier parent=m_treeParents[current];
+	TaxonIndex index=m_taxonomyIndex.getIndex(current);
+
+	while(index!=TAXON_INDEX_NONE && m_taxonomyIndex.getParent(index)!=TAXON_INDEX_NONE){
+		index=m_taxonomyIndex.getParent(index);
 	
-		current=parent;
+		current=m_taxonomyIndex.getTaxon(index);
 
 		reversePath.push_back(current);
 
@@ -1360,6 +1372,8 @@ void PhylogenyViewer::registerPlugin(ComputeCore*core){
 
 	m_loadAllTree=true;
 
+	m_taxonomyIndex.constructor();
+
 	m_core=core;
 }
 
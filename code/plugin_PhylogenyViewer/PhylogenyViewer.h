@@ -61,7 +61,9 @@ Genome-to-Taxon.tsv  Taxon-Names.tsv  Taxon-Types.tsv  TreeOfLife-Edges.tsv
 #include <profiling/TimePrinter.h>
 
 #include <plugin_Searcher/Searcher.h>
+#include <plugin_Searcher/AbundanceTable.h>
 #include <plugin_PhylogenyViewer/types.h>
+#include <plugin_PhylogenyViewer/TaxonomyIndex.h>
 
 #include <set>
 #include <stdint.h>
@@ -111,16 +113,24 @@ class PhylogenyViewer: public CorePlugin{
 	map<TaxonIdentifier,LargeCount> m_taxonObservations;
 	map<TaxonIdentifier,LargeCount> m_taxonObservationsMaster;
 
-	map<TaxonIdentifier,LargeCount> m_taxonRecursiveObservations;
+/** observations indexed by TaxonIndex while iterating over the graph */
+	vector<LargeCount> m_selfObservations;
+	vector<LargeCount> m_recursiveObservations;
+
+/** taxons of the current k-mer and their parents */
+	vector<TaxonIndex> m_kmerTaxons;
+	vector<TaxonIndex> m_kmerParents;
 
 	TaxonIdentifier UNKNOWN_TAXON;
 
 	LargeCount m_unknown;
 	LargeCount m_unknownMaster;
 
-	map<TaxonIdentifier,set<TaxonIdentifier> > m_treeChildren;
+/** only used while loading the tree */
 	map<TaxonIdentifier,TaxonIdentifier> m_treeParents;
 
+	TaxonomyIndex m_taxonomyIndex;
+
 	GridTable*m_subgraph;
 	Parameters*m_parameters;
 	SwitchMan*m_switchMan;
@@ -178,18 +188,19 @@ class PhylogenyViewer: public CorePlugin{
 	string getTaxonName(TaxonIdentifier taxon);
 
 	void gatherKmerObservations();
-	void classifySignal(vector<TaxonIdentifier>*taxons,int kmerCoverage,Vertex*vertex,Kmer*key);
+	void classifySignal(vector<TaxonIndex>*taxons,int kmerCoverage,Vertex*vertex,Kmer*key);
 	void printTaxonPath(TaxonIdentifier taxon,vector<TaxonIdentifier>*path,ostream*stream);
-	TaxonIdentifier getTaxonParent(TaxonIdentifier taxon);
 	void showObservations(ostream*stream);
 	void sendTreeCounts();
-	TaxonIdentifier findCommonAncestor(vector<TaxonIdentifier>*taxons);
+	TaxonIndex findCommonAncestor(vector<TaxonIndex>*taxons);
 	string getTaxonRank(TaxonIdentifier taxon);
 
 	void showObservations_XML(ostream*stream);
 	void printTaxonPath_XML(TaxonIdentifier taxon,vector<TaxonIdentifier>*path,ostream*stream);
 	void printTaxon_XML(TaxonIdentifier taxon,ostream*stream);
 	LargeCount getRecursiveCount(TaxonIdentifier taxon);
+	void computeRecursiveObservations();
+	void buildTaxonomyIndex();
 
 	void populateRanks(map<string,LargeCount>*rankSelfObservations,
 		map<string,LargeCount>*rankRecursiveObservations);
@@ -0,0 +1,327 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include <plugin_PhylogenyViewer/TaxonomyIndex.h>
+
+#include <algorithm>
+#include <iostream>
+using namespace std;
+
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
+void TaxonomyIndex::constructor(){
+	m_taxons.clear();
+	m_parents.clear();
+	m_preorder.clear();
+	m_euler.clear();
+	m_eulerDepths.clear();
+	m_firstOccurrences.clear();
+	m_trees.clear();
+	m_blockMinimums.clear();
+	m_genomes.clear();
+	m_genomeTaxons.clear();
+}
+
+void TaxonomyIndex::build(set<TaxonIdentifier>*taxons,map<TaxonIdentifier,TaxonIdentifier>*parents,
+		map<GenomeIdentifier,TaxonIdentifier>*genomeToTaxon){
+
+	constructor();
+
+	// every taxon that appears somewhere gets an index
+	set<TaxonIdentifier> allTaxons=*taxons;
+
+	for(map<TaxonIdentifier,TaxonIdentifier>::iterator i=parents->begin();i!=parents->end();i++){
+		allTaxons.insert(i->first);
+		allTaxons.insert(i->second);
+	}
+
+	for(map<GenomeIdentifier,TaxonIdentifier>::iterator i=genomeToTaxon->begin();i!=genomeToTaxon->end();i++){
+		allTaxons.insert(i->second);
+	}
+
+	// a set is already sorted
+	m_taxons.assign(allTaxons.begin(),allTaxons.end());
+
+	m_parents.resize(m_taxons.size(),TAXON_INDEX_NONE);
+
+	for(map<TaxonIdentifier,TaxonIdentifier>::iterator i=parents->begin();i!=parents->end();i++){
+		m_parents[getIndex(i->first)]=getIndex(i->second);
+	}
+
+	// maps are sorted too
+	for(map<GenomeIdentifier,TaxonIdentifier>::iterator i=genomeToTaxon->begin();i!=genomeToTaxon->end();i++){
+		m_genomes.push_back(i->first);
+		m_genomeTaxons.push_back(getIndex(i->second));
+	}
+
+	buildEulerTour();
+	buildBlockMinimums();
+}
+
+void TaxonomyIndex::buildEulerTour(){
+
+	int taxons=size();
+
+	// children, stored contiguously for each parent
+	vector<int> childStarts(taxons+1,0);
+
+	for(TaxonIndex i=0;i<taxons;i++){
+		if(m_parents[i]!=TAXON_INDEX_NONE)
+			childStarts[m_parents[i]+1]++;
+	}
+
+	for(int i=0;i<taxons;i++)
+		childStarts[i+1]+=childStarts[i];
+
+	vector<TaxonIndex> children(childStarts[taxons]);
+	vector<int> positions(childStarts.begin(),childStarts.end()-1);
+
+	for(TaxonIndex i=0;i<taxons;i++){
+		if(m_parents[i]!=TAXON_INDEX_NONE)
+			children[positions[m_parents[i]]++]=i;
+	}
+
+	m_firstOccurrences.resize(taxons,-1);
+	m_trees.resize(taxons,-1);
+
+	// the next child to visit for each taxon on the stack
+	vector<int> nextChild(taxons,0);
+	vector<TaxonIndex> stack;
+	vector<int> depths;
+
+	int tree=0;
+
+	for(TaxonIndex root=0;root<taxons;root++){
+		if(m_parents[root]!=TAXON_INDEX_NONE)
+			continue;
+
+		stack.push_back(root);
+		depths.push_back(0);
+
+		m_firstOccurrences[root]=m_euler.size();
+		m_trees[root]=tree;
+		m_preorder.push_back(root);
+		m_euler.push_back(root);
+		m_eulerDepths.push_back(0);
+
+		while(!stack.empty()){
+			TaxonIndex taxon=stack.back();
+			int depth=depths.back();
+
+			int child=childStarts[taxon]+nextChild[taxon];
+
+			if(child==childStarts[taxon+1]){
+				stack.pop_back();
+				depths.pop_back();
+
+				// back to the parent
+				if(!stack.empty()){
+					m_euler.push_back(stack.back());
+					m_eulerDepths.push_back(depths.back());
+				}
+
+				continue;
+			}
+
+			nextChild[taxon]++;
+
+			TaxonIndex childTaxon=children[child];
+
+			m_firstOccurrences[childTaxon]=m_euler.size();
+			m_trees[childTaxon]=tree;
+			m_preorder.push_back(childTaxon);
+			m_euler.push_back(childTaxon);
+			m_eulerDepths.push_back(depth+1);
+
+			stack.push_back(childTaxon);
+			depths.push_back(depth+1);
+		}
+
+		tree++;
+	}
+
+	// taxons on a cycle are not reachable from a root
+	if((int)m_preorder.size()!=taxons){
+		cout<<"Warning: "<<taxons-m_preorder.size()<<" taxons are not in a tree"<<endl;
+	}
+}
+
+void TaxonomyIndex::buildBlockMinimums(){
+	int blocks=(m_euler.size()+TAXONOMY_INDEX_BLOCK_SIZE-1)/TAXONOMY_INDEX_BLOCK_SIZE;
+
+	if(blocks==0)
+		return;
+
+	m_blockMinimums.push_back(vector<int>(blocks));
+
+	for(int block=0;block<blocks;block++){
+		int first=block*TAXONOMY_INDEX_BLOCK_SIZE;
+		int last=min(first+TAXONOMY_INDEX_BLOCK_SIZE,(int)m_euler.size())-1;
+
+		int best=first;
+		for(int i=first+1;i<=last;i++){
+			if(m_eulerDepths[i]<m_eulerDepths[best])
+				best=i;
+		}
+
+		m_blockMinimums[0][block]=best;
+	}
+
+	for(int level=1;(1<<level)<=blocks;level++){
+		int span=1<<level;
+		int half=span/2;
+
+		m_blockMinimums.push_back(vector<int>(blocks-span+1));
+
+		for(int block=0;block+span<=blocks;block++){
+			m_blockMinimums[level][block]=getShallowest(m_blockMinimums[level-1][block],
+				m_blockMinimums[level-1][block+half]);
+		}
+	}
+}
+
+int TaxonomyIndex::getShallowest(int first,int second){
+	if(m_eulerDepths[second]<m_eulerDepths[first])
+		return second;
+
+	return first;
+}
+
+int TaxonomyIndex::getShallowestPosition(int first,int last){
+
+	int firstBlock=first/TAXONOMY_INDEX_BLOCK_SIZE;
+	int lastBlock=last/TAXONOMY_INDEX_BLOCK_SIZE;
+
+	// short ranges are scanned
+	if(lastBlock-firstBlock<=1){
+		int best=first;
+		for(int i=first+1;i<=last;i++){
+			if(m_eulerDepths[i]<m_eulerDepths[best])
+				best=i;
+		}
+		return best;
+	}
+
+	int best=first;
+	int endOfFirstBlock=(firstBlock+1)*TAXONOMY_INDEX_BLOCK_SIZE;
+	for(int i=first+1;i<endOfFirstBlock;i++){
+		if(m_eulerDepths[i]<m_eulerDepths[best])
+			best=i;
+	}
+
+	for(int i=lastBlock*TAXONOMY_INDEX_BLOCK_SIZE;i<=last;i++){
+		if(m_eulerDepths[i]<m_eulerDepths[best])
+			best=i;
+	}
+
+	// full blocks in between, with two overlapping spans
+	int left=firstBlock+1;
+	int right=lastBlock-1;
+	int level=0;
+	while((2<<level)<=right-left+1)
+		level++;
+
+	best=getShallowest(best,m_blockMinimums[level][left]);
+	best=getShallowest(best,m_blockMinimums[level][right-(1<<level)+1]);
+
+	return best;
+}
+
+int TaxonomyIndex::size(){
+	return m_taxons.size();
+}
+
+TaxonIndex TaxonomyIndex::getIndex(TaxonIdentifier taxon){
+	vector<TaxonIdentifier>::iterator i=lower_bound(m_taxons.begin(),m_taxons.end(),taxon);
+
+	if(i==m_taxons.end() || *i!=taxon)
+		return TAXON_INDEX_NONE;
+
+	return i-m_taxons.begin();
+}
+
+TaxonIdentifier TaxonomyIndex::getTaxon(TaxonIndex index){
+	#ifdef ASSERT
+	assert(index>=0 && index<size());
+	#endif
+
+	return m_taxons[index];
+}
+
+TaxonIndex TaxonomyIndex::getParent(TaxonIndex index){
+	#ifdef ASSERT
+	assert(index>=0 && index<size());
+	#endif
+
+	return m_parents[index];
+}
+
+TaxonIndex TaxonomyIndex::getTaxonOfGenome(GenomeIdentifier genome){
+	vector<GenomeIdentifier>::iterator i=lower_bound(m_genomes.begin(),m_genomes.end(),genome);
+
+	if(i==m_genomes.end() || *i!=genome)
+		return TAXON_INDEX_NONE;
+
+	return m_genomeTaxons[i-m_genomes.begin()];
+}
+
+int TaxonomyIndex::getNumberOfGenomes(){
+	return m_genomes.size();
+}
+
+TaxonIndex TaxonomyIndex::getLowestCommonAncestor(TaxonIndex first,TaxonIndex second){
+	#ifdef ASSERT
+	assert(first>=0 && first<size());
+	assert(second>=0 && second<size());
+	#endif
+
+	if(m_trees[first]==-1 || m_trees[first]!=m_trees[second])
+		return TAXON_INDEX_NONE;
+
+	int left=m_firstOccurrences[first];
+	int right=m_firstOccurrences[second];
+
+	if(right<left){
+		int swap=left;
+		left=right;
+		right=swap;
+	}
+
+	return m_euler[getShallowestPosition(left,right)];
+}
+
+void TaxonomyIndex::computeRecursiveCounts(vector<LargeCount>*selfCounts,vector<LargeCount>*recursiveCounts){
+	#ifdef ASSERT
+	assert((int)selfCounts->size()==size());
+	#endif
+
+	*recursiveCounts=*selfCounts;
+
+	// children come after their parent in the preorder
+	for(int i=(int)m_preorder.size()-1;i>=0;i--){
+		TaxonIndex taxon=m_preorder[i];
+		TaxonIndex parent=m_parents[taxon];
+
+		if(parent!=TAXON_INDEX_NONE)
+			(*recursiveCounts)[parent]+=(*recursiveCounts)[taxon];
+	}
+}
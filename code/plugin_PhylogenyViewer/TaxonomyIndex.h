@@ -0,0 +1,106 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _TaxonomyIndex_h
+#define _TaxonomyIndex_h
+
+#include <application_core/constants.h>
+#include <plugin_PhylogenyViewer/types.h>
+
+#include <vector>
+#include <map>
+#include <set>
+#include <stdint.h>
+using namespace std;
+
+/** taxons are numbered 0, 1, 2, ... in the index **/
+typedef int TaxonIndex;
+
+#define TAXON_INDEX_NONE -1
+
+/** the Euler tour is split in blocks for the LCA queries **/
+#define TAXONOMY_INDEX_BLOCK_SIZE 32
+
+/**
+ * A read-only view of the loaded taxonomy.
+ *
+ * Taxons and genomes are in sorted vectors.
+ * The tree is stored with parent indices and an Euler tour, so
+ * lowest common ancestors are obtained without walking the tree,
+ * and recursive counts are computed in a single pass.
+ *
+ * The taxonomy can be a forest, taxons in different trees have
+ * no common ancestor.
+ *
+ * \author Sébastien Boisvert
+ */
+class TaxonomyIndex{
+
+/** sorted taxon identifiers, the position is the index **/
+	vector<TaxonIdentifier> m_taxons;
+	vector<TaxonIndex> m_parents;
+
+/** taxons in depth-first order, parents before children **/
+	vector<TaxonIndex> m_preorder;
+
+/** Euler tour of each tree, one after the other **/
+	vector<TaxonIndex> m_euler;
+	vector<int> m_eulerDepths;
+	vector<int> m_firstOccurrences;
+	vector<int> m_trees;
+
+/** m_blockMinimums[level][block] is the position in the Euler tour of
+ * the shallowest taxon in blocks block ... block+2^level-1 **/
+	vector<vector<int> > m_blockMinimums;
+
+/** sorted genome identifiers and their taxons **/
+	vector<GenomeIdentifier> m_genomes;
+	vector<TaxonIndex> m_genomeTaxons;
+
+	void buildEulerTour();
+	void buildBlockMinimums();
+	int getShallowestPosition(int first,int last);
+	int getShallowest(int first,int second);
+
+public:
+
+	void constructor();
+
+/** freeze the maps used while loading the taxonomy **/
+	void build(set<TaxonIdentifier>*taxons,map<TaxonIdentifier,TaxonIdentifier>*parents,
+		map<GenomeIdentifier,TaxonIdentifier>*genomeToTaxon);
+
+	int size();
+
+	TaxonIndex getIndex(TaxonIdentifier taxon);
+	TaxonIdentifier getTaxon(TaxonIndex index);
+	TaxonIndex getParent(TaxonIndex index);
+
+	TaxonIndex getTaxonOfGenome(GenomeIdentifier genome);
+	int getNumberOfGenomes();
+
+/** TAXON_INDEX_NONE if the taxons are not in the same tree **/
+	TaxonIndex getLowestCommonAncestor(TaxonIndex first,TaxonIndex second);
+
+/** recursiveCounts[i] is the sum of selfCounts over the subtree of i **/
+	void computeRecursiveCounts(vector<LargeCount>*selfCounts,vector<LargeCount>*recursiveCounts);
+};
+
+#endif
@@ -46,6 +46,9 @@ __CreatePlugin(Scaffolder);
 __CreateMasterModeAdapter(Scaffolder,RAY_MASTER_MODE_WRITE_SCAFFOLDS); /**/
  /**/
 __CreateSlaveModeAdapter(Scaffolder,RAY_SLAVE_MODE_SCAFFOLDER); /**/
+__CreateSlaveModeAdapter(Scaffolder,RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES); /**/
+ /**/
+__CreateMessageTagAdapter(Scaffolder,RAY_MPI_TAG_SCAFFOLD_PIECES); /**/
  /**/
  /**/
 
@@ -363,6 +366,7 @@ void Scaffolder::constructor(StaticVector*outbox,StaticVector*inbox,RingAllocato
 	m_outboxAllocator=outboxAllocator;
 	m_parameters=parameters;
 	m_initialised=false;
+	m_localPiecesInitialised=false;
 	m_workerId=0;
 }
 
@@ -399,7 +403,7 @@ void Scaffolder::call_RAY_SLAVE_MODE_SCAFFOLDER(){
 	}
 }
 
-void Scaffolder::setContigPaths(vector<PathHandle>*names,vector<vector<Kmer> >*paths){
+void Scaffolder::setContigPaths(vector<PathHandle>*names,vector<ContigPath>*paths){
 	m_contigNames=names;
 	m_contigs=paths;
 }
@@ -465,7 +469,7 @@ void Scaffolder::performSummary(){
 
 	#ifdef ASSERT
 	assert(m_contigId < (int)m_contigs->size());
-	assert(m_vertexCoverageValues.size() == (*m_contigs)[m_contigId].size());
+	assert((int)m_vertexCoverageValues.size() == (*m_contigs)[m_contigId].size());
 	#endif
 
 	LargeCount sum=0;
@@ -551,7 +555,7 @@ void Scaffolder::performSummary(){
 		fp<<vertices<<" vertices"<<endl;
 		fp<<"#Index	Vertex	Coverage"<<endl;
 		for(int i=0;i<vertices;i++){
-			Kmer kmer=(*m_contigs)[m_contigId][i];
+			Kmer kmer=(*m_contigs)[m_contigId].at(i);
 			int coverage=m_vertexCoverageValues[i];
 
 			fp<<i<<"	"<<kmer.idToWord(m_parameters->getWordSize(),m_parameters->getColorSpaceMode())<<"	"<<coverage<<endl;
@@ -562,57 +566,53 @@ void Scaffolder::performSummary(){
 
 	m_summary.clear();
 	m_summaryIterator=0;
-	for(map<PathHandle,map<Strand,map<PathHandle,map<Strand,vector<ScaffoldingLink> > > > >::iterator i=
-		m_scaffoldingSummary.begin();i!=m_scaffoldingSummary.end();i++){
 
-		PathHandle leftContig=i->first;
-		for(map<Strand,map<PathHandle,map<Strand,vector<ScaffoldingLink> > > >::iterator j=i->second.begin();
-			j!=i->second.end();j++){
-			Strand leftStrand=j->first;
-			for(map<PathHandle,map<Strand,vector<ScaffoldingLink> > >::iterator k=j->second.begin();
-				k!=j->second.end();k++){
-				PathHandle rightContig=k->first;
-				for(map<char,vector<ScaffoldingLink> >::iterator l=k->second.begin();
-					l!=k->second.end();l++){
-					char rightStrand=l->first;
+	/* links between the same contigs are now consecutive */
+	sort(m_scaffoldingLinks.begin(),m_scaffoldingLinks.end());
 
-					vector<int> veryRawDistances;
+	int first=0;
+	vector<int> veryRawDistances;
 
-					for(vector<ScaffoldingLink>::iterator m=l->second.begin();m!=l->second.end();m++){
-						int distance=(*m).getDistance();
-						int coverage1=(*m).getCoverage1();
-						int coverage2=(*m).getCoverage2();
+	while(first<(int)m_scaffoldingLinks.size()){
+		ScaffoldingLink*link=&(m_scaffoldingLinks[first]);
+		int last=first+1;
 
-						int numberOfStandardDeviations=1;
+		while(last<(int)m_scaffoldingLinks.size() && m_scaffoldingLinks[last].hasSameContigs(link))
+			last++;
 
-						/* only pick up things that are not repeated */
-						if((mean-numberOfStandardDeviations*standardDeviation) <= coverage1 && coverage1 <= (mean+numberOfStandardDeviations*standardDeviation)
-						  && (mean-numberOfStandardDeviations*standardDeviation) <= coverage2 && coverage2 <= (mean+numberOfStandardDeviations*standardDeviation)){
-							veryRawDistances.push_back(distance);
-						}
-/*
-						if(coverage1 < repeatCoverage && coverage2 < repeatCoverage){
-							veryRawDistances.push_back(distance);
-						}
-*/
-					}
+		veryRawDistances.clear();
 
-					int count=veryRawDistances.size();
+		for(int m=first;m<last;m++){
+			int distance=m_scaffoldingLinks[m].getDistance();
+			int coverage1=m_scaffoldingLinks[m].getCoverage1();
+			int coverage2=m_scaffoldingLinks[m].getCoverage2();
 
-					/* no links are valid */
-					if(count == 0){
-						continue;
-					}
+			int numberOfStandardDeviations=1;
 
-					int averageValue=(int)getAverage(&veryRawDistances);
-					int standardDeviationValue=(int)getStandardDeviation(&veryRawDistances);
-					/* this summary information will be sent to MASTER later */
-					SummarizedLink entry(leftContig,leftStrand,rightContig,rightStrand,averageValue,count,standardDeviationValue);
-					m_summary.push_back(entry);
-				}
+			/* only pick up things that are not repeated */
+			if((mean-numberOfStandardDeviations*standardDeviation) <= coverage1 && coverage1 <= (mean+numberOfStandardDeviations*standardDeviation)
+			  && (mean-numberOfStandardDeviations*standardDeviation) <= coverage2 && coverage2 <= (mean+numberOfStandardDeviations*standardDeviation)){
+				veryRawDistances.push_back(distance);
 			}
 		}
+
+		first=last;
+
+		int count=veryRawDistances.size();
+
+		/* no links are valid */
+		if(count == 0){
+			continue;
+		}
+
+		int averageValue=(int)getAverage(&veryRawDistances);
+		int standardDeviationValue=(int)getStandardDeviation(&veryRawDistances);
+		/* this summary information will be sent to MASTER later */
+		SummarizedLink entry(link->getLeftContig(),link->getLeftStrand(),link->getRightContig(),link->getRightStrand(),
+			averageValue,count,standardDeviationValue);
+		m_summary.push_back(entry);
 	}
+
 	m_summaryPerformed=true;
 	m_summarySent=false;
 	m_entrySent=false;
@@ -624,7 +624,7 @@ void Scaffolder::processContigPosition(){
 	assert(m_positionOnContig<(int)(*m_contigs)[m_contigId].size());
 	#endif
 
-	Kmer vertex=(*m_contigs)[m_contigId][m_positionOnContig];
+	Kmer vertex=(*m_contigs)[m_contigId].at(m_positionOnContig);
 	#ifdef ASSERT
 	assert(m_parameters!=NULL);
 	#endif
@@ -673,7 +673,7 @@ void Scaffolder::processVertex(Kmer*vertex){
 		m_coverageRequested=true;
 		m_coverageReceived=false;
 		if(m_positionOnContig==0){
-			m_scaffoldingSummary.clear();
+			m_scaffoldingLinks.clear();
 			m_summaryPerformed=false;
 		
 			m_vertexCoverageValues.clear();
@@ -1001,8 +1001,8 @@ Case 6. (allowed)
 			int distance=range-distanceIn1-distanceIn2;
 			if(distance>0){
 				ScaffoldingLink hit;
-				hit.constructor(distance,m_receivedCoverage,m_pairedForwardMarkerCoverage);
-				m_scaffoldingSummary[(*m_contigNames)[m_contigId]]['F'][m_pairedForwardDirectionName]['R'].push_back(hit);
+				hit.constructor((*m_contigNames)[m_contigId],'F',m_pairedForwardDirectionName,'R',distance,m_receivedCoverage,m_pairedForwardMarkerCoverage);
+				m_scaffoldingLinks.push_back(hit);
 				if(m_parameters->hasOption("-debug-scaffolder")){
 					cout<<"LINK06 "<<(*m_contigNames)[m_contigId]<<",F,"<<m_pairedForwardDirectionName<<",R,"<<distance<<endl;
 				}
@@ -1023,8 +1023,8 @@ Case 1. (allowed)
 					cout<<"LINK01 "<<(*m_contigNames)[m_contigId]<<",R,"<<m_pairedForwardDirectionName<<",F,"<<distance<<endl;
 				}
 				ScaffoldingLink hit;
-				hit.constructor(distance,m_receivedCoverage,m_pairedForwardMarkerCoverage);
-				m_scaffoldingSummary[(*m_contigNames)[m_contigId]]['R'][m_pairedForwardDirectionName]['F'].push_back(hit);
+				hit.constructor((*m_contigNames)[m_contigId],'R',m_pairedForwardDirectionName,'F',distance,m_receivedCoverage,m_pairedForwardMarkerCoverage);
+				m_scaffoldingLinks.push_back(hit);
 			}
 /*
 Case 10. (allowed)
@@ -1045,8 +1045,8 @@ Case 10. (allowed)
 					cout<<"LINK10 "<<(*m_contigNames)[m_contigId]<<",R,"<<m_pairedForwardDirectionName<<",R,"<<distance<<endl;
 				}
 				ScaffoldingLink hit;
-				hit.constructor(distance,m_receivedCoverage,m_pairedForwardMarkerCoverage);
-				m_scaffoldingSummary[(*m_contigNames)[m_contigId]]['R'][m_pairedForwardDirectionName]['R'].push_back(hit);
+				hit.constructor((*m_contigNames)[m_contigId],'R',m_pairedForwardDirectionName,'R',distance,m_receivedCoverage,m_pairedForwardMarkerCoverage);
+				m_scaffoldingLinks.push_back(hit);
 			}
 
 /*
@@ -1066,8 +1066,8 @@ Case 13. (allowed)
 				}
 
 				ScaffoldingLink hit;
-				hit.constructor(distance,m_receivedCoverage,m_pairedForwardMarkerCoverage);
-				m_scaffoldingSummary[(*m_contigNames)[m_contigId]]['F'][m_pairedForwardDirectionName]['F'].push_back(hit);
+				hit.constructor((*m_contigNames)[m_contigId],'F',m_pairedForwardDirectionName,'F',distance,m_receivedCoverage,m_pairedForwardMarkerCoverage);
+				m_scaffoldingLinks.push_back(hit);
 			}
 		}
 
@@ -1219,8 +1219,8 @@ Case 4. (allowed)
 					cout<<"LINK04 "<<(*m_contigNames)[m_contigId]<<",R,"<<m_pairedReverseDirectionName<<",R,"<<distance<<endl;
 				}
 				ScaffoldingLink hit;
-				hit.constructor(distance,m_receivedCoverage,m_pairedReverseMarkerCoverage);
-				m_scaffoldingSummary[(*m_contigNames)[m_contigId]]['R'][m_pairedReverseDirectionName]['R'].push_back(hit);
+				hit.constructor((*m_contigNames)[m_contigId],'R',m_pairedReverseDirectionName,'R',distance,m_receivedCoverage,m_pairedReverseMarkerCoverage);
+				m_scaffoldingLinks.push_back(hit);
 			}
 		
 
@@ -1240,8 +1240,8 @@ Case 7. (allowed)
 					cout<<"LINK07 "<<(*m_contigNames)[m_contigId]<<",F,"<<m_pairedReverseDirectionName<<",F,"<<distance<<endl;
 				}
 				ScaffoldingLink hit;
-				hit.constructor(distance,m_receivedCoverage,m_pairedReverseMarkerCoverage);
-				m_scaffoldingSummary[(*m_contigNames)[m_contigId]]['F'][m_pairedReverseDirectionName]['F'].push_back(hit);
+				hit.constructor((*m_contigNames)[m_contigId],'F',m_pairedReverseDirectionName,'F',distance,m_receivedCoverage,m_pairedReverseMarkerCoverage);
+				m_scaffoldingLinks.push_back(hit);
 			}
 	
 
@@ -1261,8 +1261,8 @@ Case 11. (allowed)
 					cout<<"LINK11 "<<(*m_contigNames)[m_contigId]<<",R,"<<m_pairedReverseDirectionName<<",F,"<<distance<<endl;
 				}
 				ScaffoldingLink hit;
-				hit.constructor(distance,m_receivedCoverage,m_pairedReverseMarkerCoverage);
-				m_scaffoldingSummary[(*m_contigNames)[m_contigId]]['R'][m_pairedReverseDirectionName]['F'].push_back(hit);
+				hit.constructor((*m_contigNames)[m_contigId],'R',m_pairedReverseDirectionName,'F',distance,m_receivedCoverage,m_pairedReverseMarkerCoverage);
+				m_scaffoldingLinks.push_back(hit);
 			}
 
 /*
@@ -1281,8 +1281,8 @@ Case 16. (allowed)
 					cout<<"LINK16 "<<(*m_contigNames)[m_contigId]<<",F,"<<m_pairedReverseDirectionName<<",R,"<<distance<<endl;
 				}
 				ScaffoldingLink hit;
-				hit.constructor(distance,m_receivedCoverage,m_pairedReverseMarkerCoverage);
-				m_scaffoldingSummary[(*m_contigNames)[m_contigId]]['F'][m_pairedReverseDirectionName]['R'].push_back(hit);
+				hit.constructor((*m_contigNames)[m_contigId],'F',m_pairedReverseDirectionName,'R',distance,m_receivedCoverage,m_pairedReverseMarkerCoverage);
+				m_scaffoldingLinks.push_back(hit);
 			}
 		}
 	}else if(!m_reverseDirectionLengthReceived){
@@ -1294,157 +1294,236 @@ Case 16. (allowed)
 	}
 }
 
-void Scaffolder::getContigSequence(PathHandle id){
-	if(!m_hasContigSequence_Initialised){
-		m_hasContigSequence_Initialised=true;
-		m_rankIdForContig=getRankFromPathUniqueId(id);
-		m_theLength=m_contigLengths[id];
-		m_position=0;
-		m_contigPath.clear();
-		m_requestedContigChunk=false;
-	}
-	
-	if(m_position<m_theLength){
-		if(!m_requestedContigChunk){
-			m_requestedContigChunk=true;
-			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
-			message[0]=id;
-			message[1]=m_position;
-			Message aMessage(message,2,
-				m_rankIdForContig,RAY_MPI_TAG_GET_CONTIG_CHUNK,m_parameters->getRank());
-			m_virtualCommunicator->pushMessage(m_workerId,&aMessage);
-		}else if(m_virtualCommunicator->isMessageProcessed(m_workerId)){
-			vector<MessageUnit> data;
-			m_virtualCommunicator->getMessageResponseElements(m_workerId,&data);
-			/* the position in the message buffer */
-			int pos=0;
-			/* the first element is the number of Kmer */
-			int count=data[pos++];
-			int kmerIterator=0;
-			while(kmerIterator<count){
-				Kmer a;
-				a.unpack(&data,&pos);
-				m_contigPath.push_back(a);
-				kmerIterator++;
-			}
-			m_position+=count;
-			m_requestedContigChunk=false;
+void Scaffolder::computeScaffoldPieces(){
+	string file=m_parameters->getScaffoldFile();
+
+	/* create the file, the ranks will write their pieces in it */
+	m_fp.open(file.c_str(),ios_base::out|ios_base::app);
+	m_fp.seekp(0,ios_base::end);
+	LargeCount offset=m_fp.tellp();
+	m_fp.close();
+
+	int columns=m_parameters->getColumns();
+	int wordSize=m_parameters->getWordSize();
+
+	m_scaffoldPieces.clear();
+	m_scaffoldPieces.resize(m_parameters->getSize());
+
+	LargeCount numberOfPieces=0;
+
+	for(int scaffold=0;scaffold<(int)m_scaffoldContigs.size();scaffold++){
+		ostringstream header;
+		header<<">scaffold-"<<scaffold<<endl;
+		offset+=header.str().length();
+
+		LargeCount bodyOffset=offset;
+		LargeCount positionOnScaffold=0;
+		int numberOfContigs=m_scaffoldContigs[scaffold].size();
+
+		for(int i=0;i<numberOfContigs;i++){
+			PathHandle contig=m_scaffoldContigs[scaffold][i];
+			int length=m_contigLengths[contig]+wordSize-1;
+			int gap=0;
+
+			if(i<numberOfContigs-1 && m_scaffoldGaps[scaffold][i]>0)
+				gap=m_scaffoldGaps[scaffold][i];
+
+			int flags=0;
+			if(i==0)
+				flags|=SCAFFOLD_PIECE_FIRST;
+			if(i==numberOfContigs-1)
+				flags|=SCAFFOLD_PIECE_LAST;
+
+			vector<MessageUnit>*pieces=&(m_scaffoldPieces[getRankFromPathUniqueId(contig)]);
+			pieces->push_back(contig);
+			pieces->push_back(m_scaffoldStrands[scaffold][i]);
+			pieces->push_back(bodyOffset);
+			pieces->push_back(positionOnScaffold);
+			pieces->push_back(gap);
+			pieces->push_back(scaffold);
+			pieces->push_back(flags);
+
+			positionOnScaffold+=length+gap;
+			numberOfPieces++;
 		}
-	}else{
-		/* we should receive a correct number of vertices */
-		#ifdef ASSERT
-		assert((int)m_contigPath.size()==m_theLength);
-		#endif
 
-		m_contigSequence=convertToString(&m_contigPath,m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
-		m_hasContigSequence=true;
+		/* a new line is added after each full line and at the end */
+		offset+=positionOnScaffold+positionOnScaffold/columns+1;
 	}
+
+	cout<<"Rank "<<m_parameters->getRank()<<" assigned "<<numberOfPieces<<" scaffold pieces to "<<m_parameters->getSize();
+	cout<<" ranks, "<<file<<" will have "<<offset<<" bytes"<<endl;
 }
 
 void Scaffolder::call_RAY_MASTER_MODE_WRITE_SCAFFOLDS(){
 	if(!m_initialised){
 		m_initialised=true;
-		m_scaffoldId=0;
-		m_contigId=0;
-		/* actually it is a position on the scaffold */
-		m_positionOnScaffold=0;
-		m_hasContigSequence=false;
-		m_hasContigSequence_Initialised=false;
-		string file=m_parameters->getScaffoldFile();
 
-		m_fp.open(file.c_str(),ios_base::out|ios_base::app);
-	}
+		computeScaffoldPieces();
 
-	m_virtualCommunicator->forceFlush();
-	m_virtualCommunicator->processInbox(&m_activeWorkers);
-	m_activeWorkers.clear();
+		m_pieceRank=0;
+		m_pieceIterator=0;
+		m_piecesRequested=false;
+		m_piecesSent=false;
+		m_numberOfRanksWithWrittenPieces=0;
 
-	if(m_scaffoldId<(int)m_scaffoldContigs.size()){
-		if(m_contigId<(int)m_scaffoldContigs[m_scaffoldId].size()){
-			PathHandle contigNumber=m_scaffoldContigs[m_scaffoldId][m_contigId];
-			if(!m_hasContigSequence){
-		
-				// This sends messages
-				getContigSequence(contigNumber);
+	}else if(!m_piecesSent){
 
-			}else{ /* at this point, m_contigSequence is filled. */
-				if(m_contigId==0){
+		if(m_piecesRequested){
+			if(m_inbox->size()>0 && m_inbox->at(0)->getTag()==RAY_MPI_TAG_SCAFFOLD_PIECES_REPLY)
+				m_piecesRequested=false;
 
-					m_operationBuffer<<">scaffold-"<<m_scaffoldId<<endl;
-					m_positionOnScaffold=0;
-				}
-
-				int contigPosition=0;
-				char strand=m_scaffoldStrands[m_scaffoldId][m_contigId];
-				if(strand=='R'){
-					m_contigSequence=reverseComplement(&m_contigSequence);
-				}
+		}else if(m_pieceRank==m_parameters->getSize()){
+			/* everyone has its pieces, the file can be written */
+			for(int i=0;i<m_parameters->getSize();i++){
+				Message aMessage(NULL,0,i,RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES,m_parameters->getRank());
+				m_outbox->push_back(aMessage);
+			}
 
-				int length=m_contigSequence.length();
-
-				#ifdef ASSERT
-				int theLength=m_contigLengths[contigNumber]+m_parameters->getWordSize()-1;
-				assert(length==theLength);
-				#endif
-
-				int columns=m_parameters->getColumns();
-				ostringstream outputBuffer;
-				while(contigPosition<length){
-					char nucleotide=m_contigSequence[contigPosition];
-					outputBuffer<<nucleotide;
-					contigPosition++;
-					m_positionOnScaffold++;
-					if(m_positionOnScaffold%columns==0){
-						outputBuffer<<"\n";
-					}
-				}
-				
-				m_operationBuffer<<outputBuffer.str().c_str();
-
-				if(m_contigId<(int)m_scaffoldContigs[m_scaffoldId].size()-1){
-					int gapSize=m_scaffoldGaps[m_scaffoldId][m_contigId];
-					int i=0;
-					int columns=m_parameters->getColumns();
-					ostringstream outputBuffer2;
-					while(i<gapSize){
-						outputBuffer2<<"N";
-						i++;
-						m_positionOnScaffold++;
-						if(m_positionOnScaffold%columns==0){
-							outputBuffer2<<"\n";
-						}
-					}
+			m_piecesSent=true;
 
-					m_operationBuffer<<outputBuffer2.str().c_str();
-				}
-				m_contigId++;
-				m_hasContigSequence=false;
-				m_hasContigSequence_Initialised=false;
-			}
+		}else if(m_pieceIterator==(int)m_scaffoldPieces[m_pieceRank].size()){
+			m_scaffoldPieces[m_pieceRank].clear();
+			m_pieceRank++;
+			m_pieceIterator=0;
 		}else{
-			m_operationBuffer<<endl;
+			vector<MessageUnit>*pieces=&(m_scaffoldPieces[m_pieceRank]);
 
-			m_scaffoldId++;
-			m_contigId=0;
-			m_positionOnScaffold=0;
-			m_hasContigSequence=false;
-			m_hasContigSequence_Initialised=false;
-		}
+			int maximumUnits=MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit);
+			maximumUnits-=maximumUnits%SCAFFOLD_PIECE_SIZE;
 
+			int count=pieces->size()-m_pieceIterator;
+			if(count>maximumUnits)
+				count=maximumUnits;
 
-		flushFileOperationBuffer(false,&m_operationBuffer,&m_fp,CONFIG_FILE_IO_BUFFER_SIZE);
-	}else{
+			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
 
-		flushFileOperationBuffer(true,&m_operationBuffer,&m_fp,CONFIG_FILE_IO_BUFFER_SIZE);
-	
-		m_fp.close();
+			for(int i=0;i<count;i++)
+				message[i]=(*pieces)[m_pieceIterator++];
+
+			Message aMessage(message,count,m_pieceRank,RAY_MPI_TAG_SCAFFOLD_PIECES,m_parameters->getRank());
+			m_outbox->push_back(aMessage);
+
+			m_piecesRequested=true;
+		}
+
+	}else if(m_numberOfRanksWithWrittenPieces<m_parameters->getSize()){
+
+		for(int i=0;i<(int)m_inbox->size();i++){
+			if(m_inbox->at(i)->getTag()==RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES_REPLY)
+				m_numberOfRanksWithWrittenPieces++;
+		}
 
+	}else{
 		m_switchMan->closeMasterMode();
 
 		m_timePrinter->printElapsedTime("Scaffolding of contigs");
 	}
 }
 
+void Scaffolder::call_RAY_MPI_TAG_SCAFFOLD_PIECES(Message*message){
+	MessageUnit*buffer=message->getBuffer();
+	int count=message->getCount();
+
+	for(int i=0;i<count;i++)
+		m_localScaffoldPieces.push_back(buffer[i]);
+
+	Message aMessage(NULL,0,message->getSource(),RAY_MPI_TAG_SCAFFOLD_PIECES_REPLY,m_parameters->getRank());
+	m_outbox->push_back(aMessage);
+}
+
+void Scaffolder::call_RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES(){
+	if(!m_localPiecesInitialised){
+		m_localPiecesInitialised=true;
+		m_localPieceIterator=0;
+
+		m_contigIndices.clear();
+		for(int i=0;i<(int)m_contigNames->size();i++)
+			m_contigIndices[(*m_contigNames)[i]]=i;
+
+		string file=m_parameters->getScaffoldFile();
+		m_scaffoldFile.open(file.c_str(),ios_base::in|ios_base::out|ios_base::binary);
+	}
+
+	/* one piece per call */
+	if(m_localPieceIterator<(int)m_localScaffoldPieces.size()){
+		writeScaffoldPiece(&(m_localScaffoldPieces[m_localPieceIterator]));
+		m_localPieceIterator+=SCAFFOLD_PIECE_SIZE;
+	}else{
+		m_scaffoldFile.close();
+
+		cout<<"Rank "<<m_parameters->getRank()<<" wrote "<<m_localScaffoldPieces.size()/SCAFFOLD_PIECE_SIZE;
+		cout<<" scaffold pieces"<<endl;
+
+		m_localScaffoldPieces.clear();
+		m_contigIndices.clear();
+		m_localPiecesInitialised=false;
+
+		Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES_REPLY,m_parameters->getRank());
+		m_outbox->push_back(aMessage);
+
+		m_switchMan->setSlaveMode(RAY_SLAVE_MODE_DO_NOTHING);
+	}
+}
+
+void Scaffolder::writeScaffoldPiece(MessageUnit*piece){
+	PathHandle contig=piece[0];
+	char strand=piece[1];
+	LargeCount bodyOffset=piece[2];
+	LargeCount positionOnScaffold=piece[3];
+	int gapSize=piece[4];
+	int scaffold=piece[5];
+	int flags=piece[6];
+
+	int columns=m_parameters->getColumns();
+	ostringstream outputBuffer;
+
+	/* lines are broken at the same positions as when the scaffold is written in one pass */
+	if(flags & SCAFFOLD_PIECE_FIRST){
+		ostringstream header;
+		header<<">scaffold-"<<scaffold<<endl;
+		outputBuffer<<header.str();
+		m_scaffoldFile.seekp(bodyOffset-header.str().length());
+	}else{
+		m_scaffoldFile.seekp(bodyOffset+positionOnScaffold+positionOnScaffold/columns);
+	}
+
+	#ifdef ASSERT
+	assert(m_contigIndices.count(contig)>0);
+	#endif
+
+	ContigPath*path=&((*m_contigs)[m_contigIndices[contig]]);
+	string sequence=convertToString(path,m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+
+	if(strand=='R'){
+		sequence=reverseComplement(&sequence);
+	}
+
+	int length=sequence.length();
+	for(int i=0;i<length;i++){
+		outputBuffer<<sequence[i];
+		positionOnScaffold++;
+		if(positionOnScaffold%columns==0){
+			outputBuffer<<"\n";
+		}
+	}
+
+	for(int i=0;i<gapSize;i++){
+		outputBuffer<<"N";
+		positionOnScaffold++;
+		if(positionOnScaffold%columns==0){
+			outputBuffer<<"\n";
+		}
+	}
+
+	if(flags & SCAFFOLD_PIECE_LAST){
+		outputBuffer<<endl;
+	}
+
+	string text=outputBuffer.str();
+	m_scaffoldFile.write(text.c_str(),text.length());
+}
+
 void Scaffolder::setTimePrinter(TimePrinter*a){
 	m_timePrinter=a;
 }
@@ -1463,6 +1542,10 @@ void Scaffolder::registerPlugin(ComputeCore*core){
 	core->setSlaveModeObjectHandler(plugin,RAY_SLAVE_MODE_SCAFFOLDER, __GetAdapter(Scaffolder,RAY_SLAVE_MODE_SCAFFOLDER));
 	core->setSlaveModeSymbol(plugin,RAY_SLAVE_MODE_SCAFFOLDER,"RAY_SLAVE_MODE_SCAFFOLDER");
 
+	RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES=core->allocateSlaveModeHandle(plugin);
+	core->setSlaveModeObjectHandler(plugin,RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES, __GetAdapter(Scaffolder,RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES));
+	core->setSlaveModeSymbol(plugin,RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES,"RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES");
+
 	RAY_MASTER_MODE_WRITE_SCAFFOLDS=core->allocateMasterModeHandle(plugin);
 	core->setMasterModeObjectHandler(plugin,RAY_MASTER_MODE_WRITE_SCAFFOLDS, __GetAdapter(Scaffolder,RAY_MASTER_MODE_WRITE_SCAFFOLDS));
 	core->setMasterModeSymbol(plugin,RAY_MASTER_MODE_WRITE_SCAFFOLDS,"RAY_MASTER_MODE_WRITE_SCAFFOLDS");
@@ -1472,18 +1555,31 @@ void Scaffolder::registerPlugin(ComputeCore*core){
 
 	RAY_MPI_TAG_START_SCAFFOLDER=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_START_SCAFFOLDER,"RAY_MPI_TAG_START_SCAFFOLDER");
+
+	RAY_MPI_TAG_SCAFFOLD_PIECES=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_SCAFFOLD_PIECES,__GetAdapter(Scaffolder,RAY_MPI_TAG_SCAFFOLD_PIECES));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_SCAFFOLD_PIECES,"RAY_MPI_TAG_SCAFFOLD_PIECES");
+
+	RAY_MPI_TAG_SCAFFOLD_PIECES_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_SCAFFOLD_PIECES_REPLY,"RAY_MPI_TAG_SCAFFOLD_PIECES_REPLY");
+
+	RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES,"RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES");
+
+	RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES_REPLY,"RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES_REPLY");
 }
 
 void Scaffolder::resolveSymbols(ComputeCore*core){
 	RAY_SLAVE_MODE_SCAFFOLDER=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_SCAFFOLDER");
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
+	RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES");
 
 	RAY_MASTER_MODE_WRITE_SCAFFOLDS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_WRITE_SCAFFOLDS");
 	RAY_MASTER_MODE_CONTIG_BIOLOGICAL_ABUNDANCES=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_CONTIG_BIOLOGICAL_ABUNDANCES");
 	RAY_MASTER_MODE_COUNT_SEARCH_ELEMENTS=core->getMasterModeFromSymbol(m_plugin,"RAY_MASTER_MODE_COUNT_SEARCH_ELEMENTS");
 
 	RAY_MPI_TAG_CONTIG_INFO=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_CONTIG_INFO");
-	RAY_MPI_TAG_GET_CONTIG_CHUNK=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_CONTIG_CHUNK");
 	RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION");
 	RAY_MPI_TAG_GET_PATH_LENGTH=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_PATH_LENGTH");
 	RAY_MPI_TAG_GET_READ_MARKERS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_READ_MARKERS");
@@ -1497,8 +1593,13 @@ void Scaffolder::resolveSymbols(ComputeCore*core){
 
 	RAY_MPI_TAG_SCAFFOLDING_LINKS_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_SCAFFOLDING_LINKS_REPLY");
 	RAY_MPI_TAG_START_SCAFFOLDER=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_START_SCAFFOLDER");
+	RAY_MPI_TAG_SCAFFOLD_PIECES=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_SCAFFOLD_PIECES");
+	RAY_MPI_TAG_SCAFFOLD_PIECES_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_SCAFFOLD_PIECES_REPLY");
+	RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES");
+	RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES_REPLY");
 
 	core->setMessageTagToSlaveModeSwitch(m_plugin, RAY_MPI_TAG_START_SCAFFOLDER,             RAY_SLAVE_MODE_SCAFFOLDER );
+	core->setMessageTagToSlaveModeSwitch(m_plugin, RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES,        RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES );
 
 	core->setMasterModeNextMasterMode(m_plugin,RAY_MASTER_MODE_WRITE_SCAFFOLDS, RAY_MASTER_MODE_COUNT_SEARCH_ELEMENTS);
 
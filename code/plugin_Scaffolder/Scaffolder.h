@@ -37,11 +37,20 @@
 
 #include <handlers/SlaveModeHandler.h>
 #include <handlers/MasterModeHandler.h>
+#include <handlers/MessageTagHandler.h>
 #include <plugins/CorePlugin.h>
 
-
+#include <fstream>
 using namespace std;
 
+/** a scaffold piece is a contig and the gap after it:
+ * contig, strand, body offset of the scaffold in the file, position on the scaffold,
+ * gap length, scaffold, flags **/
+#define SCAFFOLD_PIECE_SIZE 7
+
+#define SCAFFOLD_PIECE_FIRST 1
+#define SCAFFOLD_PIECE_LAST 2
+
 
 /**
  * Scaffolder class, it uses MPI through the virtual communicator.
@@ -54,10 +63,13 @@ class Scaffolder :  public CorePlugin{
 
 	MessageTag RAY_MPI_TAG_SCAFFOLDING_LINKS_REPLY;
 	MessageTag RAY_MPI_TAG_START_SCAFFOLDER;
+	MessageTag RAY_MPI_TAG_SCAFFOLD_PIECES;
+	MessageTag RAY_MPI_TAG_SCAFFOLD_PIECES_REPLY;
+	MessageTag RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES;
+	MessageTag RAY_MPI_TAG_WRITE_SCAFFOLD_PIECES_REPLY;
 
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_READS;
 	MessageTag RAY_MPI_TAG_CONTIG_INFO;
-	MessageTag RAY_MPI_TAG_GET_CONTIG_CHUNK;
 	MessageTag RAY_MPI_TAG_GET_COVERAGE_AND_DIRECTION;
 	MessageTag RAY_MPI_TAG_GET_PATH_LENGTH;
 	MessageTag RAY_MPI_TAG_GET_READ_MARKERS;
@@ -73,6 +85,7 @@ class Scaffolder :  public CorePlugin{
 
 	SlaveMode RAY_SLAVE_MODE_DO_NOTHING;
 	SlaveMode RAY_SLAVE_MODE_SCAFFOLDER;
+	SlaveMode RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES;
 
 
 	SwitchMan*m_switchMan;
@@ -81,16 +94,23 @@ class Scaffolder :  public CorePlugin{
 
 	bool m_hasPairedReads;    //Added to skip scaffolding in case of unpaired reads
 
-	int m_rankIdForContig;
-	bool m_hasContigSequence_Initialised;
 	ofstream m_fp;
-	bool m_hasContigSequence;
-	string m_contigSequence;
 	map<PathHandle,int> m_contigLengths;
-	int m_position;
-	int m_theLength;
-	vector<Kmer> m_contigPath;
-	bool m_requestedContigChunk;
+
+	/* pieces of Scaffolds.fasta for each rank, on the master */
+	vector<vector<MessageUnit> > m_scaffoldPieces;
+	int m_pieceRank;
+	int m_pieceIterator;
+	bool m_piecesRequested;
+	bool m_piecesSent;
+	int m_numberOfRanksWithWrittenPieces;
+
+	/* pieces to write on this rank */
+	vector<MessageUnit> m_localScaffoldPieces;
+	int m_localPieceIterator;
+	bool m_localPiecesInitialised;
+	map<PathHandle,int> m_contigIndices;
+	fstream m_scaffoldFile;
 
 	vector<int> m_allScaffoldLengths;
 	vector<int> m_allContigLengths;
@@ -98,8 +118,6 @@ class Scaffolder :  public CorePlugin{
 	/* coverage values for the current path */
 	vector<int> m_vertexCoverageValues;
 
-	int m_scaffoldId;
-	int m_positionOnScaffold;
 	bool m_writeContigRequested;
 
 	vector<vector<PathHandle> > m_scaffoldContigs;
@@ -116,7 +134,7 @@ class Scaffolder :  public CorePlugin{
 	vector<SummarizedLink>m_summary;
 	bool m_summaryPerformed;
 	bool m_entrySent;
-	map<PathHandle,map<char,map<PathHandle,map<char,vector<ScaffoldingLink> > > > > m_scaffoldingSummary;
+	vector<ScaffoldingLink> m_scaffoldingLinks;
 	bool m_reverseDirectionsReceived;
 	bool m_reverseDirectionLengthReceived;
 	PathHandle m_pairedReverseDirectionName;
@@ -166,7 +184,7 @@ class Scaffolder :  public CorePlugin{
 	bool m_forwardDone;
 	int m_contigId;
 	int m_positionOnContig;
-	vector<vector<Kmer> >*m_contigs;
+	vector<ContigPath>*m_contigs;
 	vector<PathHandle>*m_contigNames;
 
 	Parameters*m_parameters;
@@ -176,9 +194,10 @@ class Scaffolder :  public CorePlugin{
 	bool m_ready;
 
 	/**
- *	gets a contig sequence by receiving several MPI messages
+ *	computes where each contig goes in the scaffold file
  */
-	void getContigSequence(PathHandle id);
+	void computeScaffoldPieces();
+	void writeScaffoldPiece(MessageUnit*piece);
 	void processContig();
 	void processContigPosition();
 	void processVertex(Kmer*vertex);
@@ -210,11 +229,13 @@ public:
 	void constructor(StaticVector*outbox,StaticVector*inbox,RingAllocator*outboxAllocator,Parameters*parameters,
 		VirtualCommunicator*vc,SwitchMan*switchMan);
 	void call_RAY_SLAVE_MODE_SCAFFOLDER();
-	void setContigPaths(vector<PathHandle>*names,vector<vector<Kmer> >*paths);
+	void setContigPaths(vector<PathHandle>*names,vector<ContigPath>*paths);
 	void addMasterLink(SummarizedLink*link);
 	void solve();
 	void addMasterContig(PathHandle name,int length);
 	void call_RAY_MASTER_MODE_WRITE_SCAFFOLDS();
+	void call_RAY_SLAVE_MODE_WRITE_SCAFFOLD_PIECES();
+	void call_RAY_MPI_TAG_SCAFFOLD_PIECES(Message*message);
 	void printFinalMessage();
 
 	void setTimePrinter(TimePrinter*a);
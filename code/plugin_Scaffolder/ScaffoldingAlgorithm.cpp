@@ -19,7 +19,7 @@
 */
 
 #include <plugin_Scaffolder/ScaffoldingAlgorithm.h>
-#include <queue>
+#include <algorithm>
 #include <iostream>
 #include <set>
 #include <vector>
@@ -27,6 +27,16 @@
 #include <map>
 using namespace std;
 
+/** sorts edge indices by decreasing priority **/
+class EdgePriorityComparator{
+public:
+	vector<ScaffoldingEdge>*m_edges;
+
+	bool operator()(int a,int b){
+		return (*m_edges)[b].getPriority()<(*m_edges)[a].getPriority();
+	}
+};
+
 ScaffoldingAlgorithm::ScaffoldingAlgorithm(){
 }
 
@@ -65,27 +75,45 @@ void ScaffoldingAlgorithm::solve(
 
 	cout<<large<<" contigs >= "<<threshold<<endl;
 
-	priority_queue<ScaffoldingEdge> bagOfChoices;
+	indexEdges();
 
+	/* edges with the highest priority are considered first */
+	vector<int> edges;
 	for(int i=0;i<(int)m_edges->size();i++){
-		bagOfChoices.push((*m_edges)[i]);
+		edges.push_back(i);
 	}
 
-	m_numberOfEdges=0;
+	EdgePriorityComparator comparator;
+	comparator.m_edges=m_edges;
+	stable_sort(edges.begin(),edges.end(),comparator);
 
-	while(!bagOfChoices.empty()){
-		ScaffoldingEdge edge=bagOfChoices.top();
-		
-		//cout<<"Want to add"<<endl;
-		//edge.print();
+	/* split the edges by component, in the same order */
+	map<int,int> componentIndices;
+	vector<vector<int> > components;
 
-		if(!hasConflict(&edge)){
-			addEdge(&edge);
-		}else{
-			/* solve conflict */
+	for(int i=0;i<(int)edges.size();i++){
+		int component=getComponent(m_leftEnds[edges[i]]/2);
+
+		if(componentIndices.count(component)==0){
+			componentIndices[component]=components.size();
+			components.push_back(vector<int>());
 		}
 
-		bagOfChoices.pop();
+		components[componentIndices[component]].push_back(edges[i]);
+	}
+
+	int largestComponent=0;
+	for(int i=0;i<(int)components.size();i++){
+		if((int)components[i].size()>largestComponent)
+			largestComponent=components[i].size();
+	}
+
+	cout<<components.size()<<" connected components, the largest has "<<largestComponent<<" edges"<<endl;
+
+	m_numberOfEdges=0;
+
+	for(int i=0;i<(int)components.size();i++){
+		solveComponent(&(components[i]));
 	}
 
 	cout<<"Edges in solution: "<<m_numberOfEdges<<endl;
@@ -109,33 +137,24 @@ void ScaffoldingAlgorithm::solve(
 	/** filter edges with greedy algorithm */
 	/** populate megaLinks with accepted edges */
 
-	for(map<PathHandle,map<PathHandle,ScaffoldingEdge> >::iterator i=m_addedEdges.begin();i!=m_addedEdges.end();i++){
-		for(map<PathHandle,ScaffoldingEdge>::iterator j=i->second.begin();j!=i->second.end();j++){
-			PathHandle first=i->first;
-			PathHandle second=j->first;
-
-			if(second < first){
-				continue;
-			}
-
-			ScaffoldingEdge edge=j->second;
-		
-			vector<uint64_t> megaLink;
-			PathHandle leftContig=edge.getLeftContig();
-			megaLink.push_back(leftContig);
-			char leftStrand=edge.getLeftStrand();
-			megaLink.push_back(leftStrand);
-			PathHandle rightContig=edge.getRightContig();
-			megaLink.push_back(rightContig);
-			char rightStrand=edge.getRightStrand();
-			megaLink.push_back(rightStrand);
-			int average=edge.getGapSize();
-			megaLink.push_back(average);
-			megaLinks.push_back(megaLink);
-
-			validCounts[leftContig][rightContig]++;
-			validCounts[rightContig][leftContig]++;
-		}
+	for(int i=0;i<(int)m_acceptedEdges.size();i++){
+		ScaffoldingEdge edge=(*m_edges)[m_acceptedEdges[i]];
+
+		vector<uint64_t> megaLink;
+		PathHandle leftContig=edge.getLeftContig();
+		megaLink.push_back(leftContig);
+		char leftStrand=edge.getLeftStrand();
+		megaLink.push_back(leftStrand);
+		PathHandle rightContig=edge.getRightContig();
+		megaLink.push_back(rightContig);
+		char rightStrand=edge.getRightStrand();
+		megaLink.push_back(rightStrand);
+		int average=edge.getGapSize();
+		megaLink.push_back(average);
+		megaLinks.push_back(megaLink);
+
+		validCounts[leftContig][rightContig]++;
+		validCounts[rightContig][leftContig]++;
 	}
 
 	// create the graph
@@ -276,123 +295,140 @@ void ScaffoldingAlgorithm::solve(
 
 }
 
-void ScaffoldingAlgorithm::addEdge(ScaffoldingEdge*edge){
-	//cout<<"Adding edge "<<endl;
-	//edge->print();
-	PathHandle leftContig=edge->getLeftContig();
-	PathHandle rightContig=edge->getRightContig();
+int ScaffoldingAlgorithm::getContigIndex(PathHandle contig){
+	vector<PathHandle>::iterator i=lower_bound(m_contigs.begin(),m_contigs.end(),contig);
 
-	m_addedEdges[leftContig][rightContig]=*edge;
-	m_addedEdges[rightContig][leftContig]=*edge;
-	m_numberOfEdges++;
-}
-
-bool ScaffoldingAlgorithm::hasConflict(ScaffoldingEdge*edge){
-	PathHandle leftContig=edge->getLeftContig();
-	PathHandle rightContig=edge->getRightContig();
+	#ifdef ASSERT
+	assert(i!=m_contigs.end() && *i==contig);
+	#endif
 
-	if(hasConflictWithContig(edge,leftContig))
-		return true;
+	return i-m_contigs.begin();
+}
 
-	if(hasConflictWithContig(edge,rightContig))
-		return true;
+/**
+ * The left contig of an edge on the forward strand uses its right end,
+ * the right contig on the forward strand uses its left end, and the
+ * reverse strand swaps the ends.
+ */
+int ScaffoldingAlgorithm::getContigEnd(int contig,int side,char strand){
+	int end=side;
 
-	return false;
+	if(strand=='R')
+		end=1-end;
 
+	return 2*contig+end;
 }
 
-bool ScaffoldingAlgorithm::hasConflictWithContig(ScaffoldingEdge*edge,PathHandle contig){
-	/* the contig is now connected */
-	if(m_addedEdges.count(contig) == 0)
-		return false;
-
-	/* check if there is a conflit between existing edges */
-	for(map<PathHandle,ScaffoldingEdge>::iterator i=m_addedEdges[contig].begin();
-			i!=m_addedEdges[contig].end();i++){
-		ScaffoldingEdge otherEdge=i->second;
-		
-		if(hasConflictWithEdge(edge,&otherEdge))
-			return true;
+int ScaffoldingAlgorithm::getComponent(int contig){
+	int root=contig;
+	while(m_componentParents[root]!=root)
+		root=m_componentParents[root];
+
+	/* path compression */
+	while(m_componentParents[contig]!=root){
+		int parent=m_componentParents[contig];
+		m_componentParents[contig]=root;
+		contig=parent;
 	}
 
-	return false;
+	return root;
 }
 
-bool ScaffoldingAlgorithm::hasConflictWithEdge(ScaffoldingEdge*edgeToBeAdded,ScaffoldingEdge*alreadyAcceptedEdge){
-	PathHandle edge1LeftContig=edgeToBeAdded->getLeftContig();
-	PathHandle edge1RightContig=edgeToBeAdded->getRightContig();
-	PathHandle edge2LeftContig=alreadyAcceptedEdge->getLeftContig();
-	PathHandle edge2RightContig=alreadyAcceptedEdge->getRightContig();
+void ScaffoldingAlgorithm::indexEdges(){
+	m_contigs.clear();
 
-	if(edge1LeftContig == edge2LeftContig){
-		if(hasConflictWithEdgeAroundContig(edgeToBeAdded,alreadyAcceptedEdge,edge1LeftContig)){
-			return true;
-		}
-	}
+	for(int i=0;i<(int)m_vertices->size();i++)
+		m_contigs.push_back(m_vertices->at(i).getName());
 
-	if(edge1LeftContig == edge2RightContig){
-		if(hasConflictWithEdgeAroundContig(edgeToBeAdded,alreadyAcceptedEdge,edge1LeftContig)){
-			return true;
-		}
+	for(int i=0;i<(int)m_edges->size();i++){
+		m_contigs.push_back((*m_edges)[i].getLeftContig());
+		m_contigs.push_back((*m_edges)[i].getRightContig());
 	}
 
-	if(edge1RightContig== edge2LeftContig){
-		if(hasConflictWithEdgeAroundContig(edgeToBeAdded,alreadyAcceptedEdge,edge1RightContig)){
-			return true;
-		}
+	sort(m_contigs.begin(),m_contigs.end());
+	m_contigs.erase(unique(m_contigs.begin(),m_contigs.end()),m_contigs.end());
+
+	m_endEdges.assign(2*m_contigs.size(),SCAFFOLDING_NO_EDGE);
+
+	m_componentParents.resize(m_contigs.size());
+	for(int i=0;i<(int)m_contigs.size();i++)
+		m_componentParents[i]=i;
+
+	m_leftEnds.resize(m_edges->size());
+	m_rightEnds.resize(m_edges->size());
+
+	for(int i=0;i<(int)m_edges->size();i++){
+		ScaffoldingEdge*edge=&((*m_edges)[i]);
+
+		int leftContig=getContigIndex(edge->getLeftContig());
+		int rightContig=getContigIndex(edge->getRightContig());
+
+		m_leftEnds[i]=getContigEnd(leftContig,LEFT_SIDE,edge->getLeftStrand());
+
+		/* an edge from a contig to itself is seen from its left side only */
+		if(rightContig==leftContig)
+			m_rightEnds[i]=m_leftEnds[i];
+		else
+			m_rightEnds[i]=getContigEnd(rightContig,RIGHT_SIDE,edge->getRightStrand());
+
+		int leftComponent=getComponent(leftContig);
+		int rightComponent=getComponent(rightContig);
+
+		if(leftComponent!=rightComponent)
+			m_componentParents[rightComponent]=leftComponent;
 	}
+}
+
+void ScaffoldingAlgorithm::solveComponent(vector<int>*edges){
+	for(int i=0;i<(int)edges->size();i++){
+		int edge=(*edges)[i];
 
-	if(edge1RightContig== edge2RightContig){
-		if(hasConflictWithEdgeAroundContig(edgeToBeAdded,alreadyAcceptedEdge,edge1RightContig)){
-			return true;
+		if(!hasConflict(edge)){
+			addEdge(edge);
+		}else{
+			/* solve conflict */
 		}
 	}
-
-	return false;
 }
 
-bool ScaffoldingAlgorithm::hasConflictWithEdgeAroundContig(ScaffoldingEdge*edgeToBeAdded,ScaffoldingEdge*alreadyAcceptedEdge,PathHandle contigToCheck){
+void ScaffoldingAlgorithm::addEdge(int edge){
+	m_endEdges[m_leftEnds[edge]]=edge;
+	m_endEdges[m_rightEnds[edge]]=edge;
 
-	int edge1ContigSide=edgeToBeAdded->getSide(contigToCheck);
-	char edge1ContigStrand=edgeToBeAdded->getStrand(contigToCheck);
+	m_acceptedEdges.push_back(edge);
+	m_numberOfEdges++;
+}
 
-	int edge2ContigSide=alreadyAcceptedEdge->getSide(contigToCheck);
-	char edge2ContigStrand=alreadyAcceptedEdge->getStrand(contigToCheck);
+bool ScaffoldingAlgorithm::hasConflict(int edge){
+	int leftEnd=m_leftEnds[edge];
+	int rightEnd=m_rightEnds[edge];
 
-	if(edge1ContigStrand == edge2ContigStrand){
-		if(edge1ContigSide == edge2ContigSide){
-			cout<<"Conflict for contig "<<contigToCheck<<" Length= "<<m_lengths[contigToCheck]<<endl;
-			cout<<"Edge to be added:"<<endl;
-			edgeToBeAdded->print();
-			cout<<"Already added edge:"<<endl;
-			alreadyAcceptedEdge->print();
-			m_conflicts[edgeToBeAdded->getPriority()][alreadyAcceptedEdge->getPriority()]++;
-			return true;
-		}
-	}else{
-		ScaffoldingEdge reverseEdge=alreadyAcceptedEdge->getReverseEdge();
+	if(m_endEdges[leftEnd]!=SCAFFOLDING_NO_EDGE){
+		printConflict(edge,m_endEdges[leftEnd],leftEnd);
+		return true;
+	}
 
-		int edge2ContigSideReverse=reverseEdge.getSide(contigToCheck);
-	
-		#ifdef ASSERT
-		char edge2ContigStrandReverse=reverseEdge.getStrand(contigToCheck);
-		assert(edge2ContigStrandReverse == edge1ContigStrand);
-		#endif
-
-		if(edge1ContigSide == edge2ContigSideReverse){
-			cout<<"Conflict (reverse) for contig "<<contigToCheck<<" Length= "<<m_lengths[contigToCheck]<<endl;
-			cout<<"Edge to be added:"<<endl;
-			edgeToBeAdded->print();
-			cout<<"Already added edge:"<<endl;
-			alreadyAcceptedEdge->print();
-			m_conflicts[edgeToBeAdded->getPriority()][alreadyAcceptedEdge->getPriority()]++;
-			return true;
-		}
+	if(m_endEdges[rightEnd]!=SCAFFOLDING_NO_EDGE){
+		printConflict(edge,m_endEdges[rightEnd],rightEnd);
+		return true;
 	}
 
 	return false;
 }
 
+void ScaffoldingAlgorithm::printConflict(int edge,int otherEdge,int end){
+	ScaffoldingEdge*edgeToBeAdded=&((*m_edges)[edge]);
+	ScaffoldingEdge*alreadyAcceptedEdge=&((*m_edges)[otherEdge]);
+	PathHandle contigToCheck=m_contigs[end/2];
+
+	cout<<"Conflict for contig "<<contigToCheck<<" Length= "<<m_lengths[contigToCheck]<<endl;
+	cout<<"Edge to be added:"<<endl;
+	edgeToBeAdded->print();
+	cout<<"Already added edge:"<<endl;
+	alreadyAcceptedEdge->print();
+	m_conflicts[edgeToBeAdded->getPriority()][alreadyAcceptedEdge->getPriority()]++;
+}
+
 void ScaffoldingAlgorithm::extractScaffolds(char state,map<PathHandle,int>*colors,PathHandle vertex,
 	map<PathHandle,map<char,vector<vector<PathHandle> > > >*parents,
 	map<PathHandle,map<char,vector<vector<PathHandle> > > >*children,set<int>*completedColours,
@@ -28,26 +28,54 @@
 #include <plugin_Scaffolder/ScaffoldingVertex.h>
 using namespace std;
 
+#define SCAFFOLDING_NO_EDGE -1
+
+/**
+ * Greedy scaffolding: edges are accepted by decreasing priority
+ * unless an end of one of their contigs is already used.
+ *
+ * Contigs are numbered and each contig has 2 ends, so a conflict
+ * is checked with 2 lookups in m_endEdges.
+ * Edges that do not share a contig can not conflict, so the graph is split
+ * in connected components that are solved one after the other.
+ */
 class ScaffoldingAlgorithm{
 	vector<ScaffoldingVertex>*m_vertices;
 	vector<ScaffoldingEdge>*m_edges;
 
-	map<PathHandle,map<PathHandle,ScaffoldingEdge> > m_addedEdges;
+/** sorted contig names, the position is the index of the contig **/
+	vector<PathHandle> m_contigs;
+
+/** the end of each contig used by each edge, it is 2*contig+end **/
+	vector<int> m_leftEnds;
+	vector<int> m_rightEnds;
+
+/** the accepted edge at each contig end **/
+	vector<int> m_endEdges;
+
+/** union-find forest of contigs **/
+	vector<int> m_componentParents;
+
+	vector<int> m_acceptedEdges;
 	int m_numberOfEdges;
 
 	map<PathHandle,int> m_lengths;
 
 	map<int,map<int,int> > m_conflicts;
+
+	int getContigIndex(PathHandle contig);
+	int getContigEnd(int contig,int side,char strand);
+	int getComponent(int contig);
+	void indexEdges();
+	void solveComponent(vector<int>*edges);
+
+	void printConflict(int edge,int otherEdge,int end);
 public:
 	ScaffoldingAlgorithm();
 	void setVertices(vector<ScaffoldingVertex>*vertices);
 	void setEdges(vector<ScaffoldingEdge>*edges);
-	void addEdge(ScaffoldingEdge*edge);
-
-	bool hasConflictWithEdgeAroundContig(ScaffoldingEdge*edgeToBeAdded,ScaffoldingEdge*alreadyAcceptedEdge,PathHandle contigToCheck);
-	bool hasConflictWithEdge(ScaffoldingEdge*edgeToBeAdded,ScaffoldingEdge*alreadyAcceptedEdge);
-	bool hasConflictWithContig(ScaffoldingEdge*edge,PathHandle contig);
-	bool hasConflict(ScaffoldingEdge*edge);
+	void addEdge(int edge);
+	bool hasConflict(int edge);
 
 	void solve(
 
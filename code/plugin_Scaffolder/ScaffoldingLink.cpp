@@ -24,7 +24,12 @@
 ScaffoldingLink::ScaffoldingLink(){
 }
 
-void ScaffoldingLink::constructor(int distance,int coverage1,int coverage2){
+void ScaffoldingLink::constructor(PathHandle leftContig,Strand leftStrand,PathHandle rightContig,Strand rightStrand,
+	int distance,int coverage1,int coverage2){
+	m_leftContig=leftContig;
+	m_leftStrand=leftStrand;
+	m_rightContig=rightContig;
+	m_rightStrand=rightStrand;
 	m_distance=distance;
 	m_path1MarkerCoverage=coverage1;
 	m_path2MarkerCoverage=coverage2;
@@ -42,3 +47,37 @@ int ScaffoldingLink::getCoverage2(){
 	return m_path2MarkerCoverage;
 }
 
+
+PathHandle ScaffoldingLink::getLeftContig(){
+	return m_leftContig;
+}
+
+Strand ScaffoldingLink::getLeftStrand(){
+	return m_leftStrand;
+}
+
+PathHandle ScaffoldingLink::getRightContig(){
+	return m_rightContig;
+}
+
+Strand ScaffoldingLink::getRightStrand(){
+	return m_rightStrand;
+}
+
+bool ScaffoldingLink::hasSameContigs(ScaffoldingLink*other){
+	return m_leftContig==other->m_leftContig && m_leftStrand==other->m_leftStrand
+		&& m_rightContig==other->m_rightContig && m_rightStrand==other->m_rightStrand;
+}
+
+bool ScaffoldingLink::operator<(const ScaffoldingLink&other)const{
+	if(m_leftContig!=other.m_leftContig)
+		return m_leftContig<other.m_leftContig;
+
+	if(m_leftStrand!=other.m_leftStrand)
+		return m_leftStrand<other.m_leftStrand;
+
+	if(m_rightContig!=other.m_rightContig)
+		return m_rightContig<other.m_rightContig;
+
+	return m_rightStrand<other.m_rightStrand;
+}
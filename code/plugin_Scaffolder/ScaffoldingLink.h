@@ -22,11 +22,22 @@
 #ifndef _ScaffoldingLink_h
 #define _ScaffoldingLink_h
 
+#include <application_core/constants.h>
+#include <core/types.h>
+
 /**
  * A scaffolding link is a potentially useful link between two contigs
+ *
+ * Links are stored in a flat vector and sorted by contigs and strands, so
+ * the links between the same 2 contigs are next to each other.
  * \author Sébastien Boisvert
  */
 class ScaffoldingLink{
+	PathHandle m_leftContig;
+	PathHandle m_rightContig;
+	Strand m_leftStrand;
+	Strand m_rightStrand;
+
 	/* the distance between the 2 contigs */
 	int m_distance;
 
@@ -35,10 +46,20 @@ class ScaffoldingLink{
 	int m_path2MarkerCoverage;
 public:
 	ScaffoldingLink();
-	void constructor(int distance,int coverage1,int coverage2);
+	void constructor(PathHandle leftContig,Strand leftStrand,PathHandle rightContig,Strand rightStrand,
+		int distance,int coverage1,int coverage2);
+	PathHandle getLeftContig();
+	Strand getLeftStrand();
+	PathHandle getRightContig();
+	Strand getRightStrand();
 	int getDistance();
 	int getCoverage1();
 	int getCoverage2();
+
+/** true if both links join the same contigs with the same strands **/
+	bool hasSameContigs(ScaffoldingLink*other);
+
+	bool operator<(const ScaffoldingLink&other)const;
 };
 
 #endif
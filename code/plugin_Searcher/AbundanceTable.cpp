@@ -0,0 +1,234 @@
+/*
+ 	Ray
+    Copyright (C) 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include <plugin_Searcher/AbundanceTable.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
+#define ABUNDANCE_TABLE_VERSION 1
+#define ABUNDANCE_TABLE_ROW_GROUP_SIZE 65536
+
+AbundanceTable::AbundanceTable(){
+	m_enabled=false;
+	m_rows=0;
+	m_rowGroups=0;
+	m_table=0;
+	m_rank=0;
+	m_rowGroupSize=ABUNDANCE_TABLE_ROW_GROUP_SIZE;
+}
+
+void AbundanceTable::constructor(const char*file,int table,Rank rank,bool enabled){
+	m_file=file;
+	m_table=table;
+	m_rank=rank;
+	m_enabled=enabled;
+	m_rows=0;
+	m_rowGroups=0;
+
+	m_names.clear();
+	m_types.clear();
+	m_data.clear();
+	m_offsets.clear();
+}
+
+void AbundanceTable::addColumn(const char*name,int type){
+
+	#ifdef ASSERT
+	assert(m_rows==0);
+	#endif
+
+	m_names.push_back(name);
+	m_types.push_back(type);
+
+	vector<char> data;
+	m_data.push_back(data);
+
+	vector<uint32_t> offsets;
+
+	if(type==ABUNDANCE_COLUMN_TEXT)
+		offsets.push_back(0);
+
+	m_offsets.push_back(offsets);
+}
+
+void AbundanceTable::appendBytes(vector<char>*bytes,const void*data,int size){
+	const char*pointer=(const char*)data;
+
+	bytes->insert(bytes->end(),pointer,pointer+size);
+}
+
+void AbundanceTable::addInteger(int column,int64_t value){
+	if(!m_enabled)
+		return;
+
+	#ifdef ASSERT
+	assert(m_types[column]==ABUNDANCE_COLUMN_INTEGER);
+	#endif
+
+	appendBytes(&(m_data[column]),&value,sizeof(int64_t));
+}
+
+void AbundanceTable::addReal(int column,double value){
+	if(!m_enabled)
+		return;
+
+	#ifdef ASSERT
+	assert(m_types[column]==ABUNDANCE_COLUMN_REAL);
+	#endif
+
+	appendBytes(&(m_data[column]),&value,sizeof(double));
+}
+
+void AbundanceTable::addText(int column,const char*value){
+	if(!m_enabled)
+		return;
+
+	#ifdef ASSERT
+	assert(m_types[column]==ABUNDANCE_COLUMN_TEXT);
+	#endif
+
+	appendBytes(&(m_data[column]),value,strlen(value));
+
+	m_offsets[column].push_back(m_data[column].size());
+}
+
+void AbundanceTable::endRow(){
+	if(!m_enabled)
+		return;
+
+	m_rows++;
+
+	if((int)m_rows>=m_rowGroupSize)
+		flush();
+}
+
+void AbundanceTable::flush(){
+
+	if(!m_enabled || m_rows==0)
+		return;
+
+	// serialize the whole row group in memory so that it
+	// is appended with a single write
+	vector<char> rowGroup;
+
+	uint32_t version=ABUNDANCE_TABLE_VERSION;
+	uint32_t table=m_table;
+	uint32_t rank=m_rank;
+	uint64_t rows=m_rows;
+	uint32_t columns=m_names.size();
+
+	appendBytes(&rowGroup,"RCRG",4);
+	appendBytes(&rowGroup,&version,sizeof(uint32_t));
+	appendBytes(&rowGroup,&table,sizeof(uint32_t));
+	appendBytes(&rowGroup,&rank,sizeof(uint32_t));
+	appendBytes(&rowGroup,&rows,sizeof(uint64_t));
+	appendBytes(&rowGroup,&columns,sizeof(uint32_t));
+
+	for(int i=0;i<(int)m_names.size();i++){
+		uint32_t type=m_types[i];
+		uint32_t nameLength=m_names[i].length();
+
+		appendBytes(&rowGroup,&type,sizeof(uint32_t));
+		appendBytes(&rowGroup,&nameLength,sizeof(uint32_t));
+		appendBytes(&rowGroup,m_names[i].c_str(),nameLength);
+
+		uint64_t bytes=m_data[i].size();
+
+		if(m_types[i]==ABUNDANCE_COLUMN_TEXT)
+			bytes+=m_offsets[i].size()*sizeof(uint32_t);
+
+		appendBytes(&rowGroup,&bytes,sizeof(uint64_t));
+
+		if(m_types[i]==ABUNDANCE_COLUMN_TEXT){
+
+			#ifdef ASSERT
+			assert(m_offsets[i].size()==m_rows+1);
+			#endif
+
+			appendBytes(&rowGroup,&(m_offsets[i][0]),m_offsets[i].size()*sizeof(uint32_t));
+		}
+
+		#ifdef ASSERT
+		if(m_types[i]!=ABUNDANCE_COLUMN_TEXT)
+			assert(m_data[i].size()==m_rows*8);
+		#endif
+
+		if(m_data[i].size()>0)
+			appendBytes(&rowGroup,&(m_data[i][0]),m_data[i].size());
+	}
+
+	FILE*file=fopen(m_file.c_str(),"ab");
+
+	if(file==NULL){
+		cout<<"Error: can not open "<<m_file<<endl;
+		return;
+	}
+
+	// ranks append row groups at any time, so a lock is required
+	#ifndef _WIN32
+	struct flock lock;
+	memset(&lock,0,sizeof(lock));
+	lock.l_type=F_WRLCK;
+	lock.l_whence=SEEK_SET;
+	fcntl(fileno(file),F_SETLKW,&lock);
+	#endif
+
+	fwrite(&(rowGroup[0]),1,rowGroup.size(),file);
+	fflush(file);
+
+	#ifndef _WIN32
+	lock.l_type=F_UNLCK;
+	fcntl(fileno(file),F_SETLK,&lock);
+	#endif
+
+	fclose(file);
+
+	m_rowGroups++;
+
+	// reset the buffers
+	m_rows=0;
+
+	for(int i=0;i<(int)m_data.size();i++){
+		m_data[i].clear();
+		m_offsets[i].clear();
+
+		if(m_types[i]==ABUNDANCE_COLUMN_TEXT)
+			m_offsets[i].push_back(0);
+	}
+}
+
+bool AbundanceTable::isEnabled(){
+	return m_enabled;
+}
+
+LargeCount AbundanceTable::getNumberOfRowGroups(){
+	return m_rowGroups;
+}
@@ -0,0 +1,120 @@
+/*
+ 	Ray
+    Copyright (C) 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _AbundanceTable_h
+#define _AbundanceTable_h
+
+#include <application_core/constants.h>
+#include <core/types.h> /* for Rank */
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+/** table identifiers in the columnar file */
+#define ABUNDANCE_TABLE_SEQUENCES 0
+#define ABUNDANCE_TABLE_CONTIGS 1
+#define ABUNDANCE_TABLE_TAXONS 2
+
+/** column types */
+#define ABUNDANCE_COLUMN_INTEGER 0
+#define ABUNDANCE_COLUMN_REAL 1
+#define ABUNDANCE_COLUMN_TEXT 2
+
+/** the name of the columnar file in BiologicalAbundances/ */
+#define ABUNDANCE_TABLE_FILE "AbundanceTables.bin"
+
+/**
+ * Writes rows of an abundance table in a single columnar
+ * binary file shared by all ranks.
+ *
+ * Rows are buffered column by column and appended as a row group.
+ * Each row group is self-describing and is appended with one
+ * write under an exclusive lock, so any rank can append to the
+ * same file at any time.
+ *
+ * Row group layout (host byte order, little-endian on x86):
+ *
+ *  char[4] magic "RCRG"
+ *  uint32 version
+ *  uint32 table
+ *  uint32 rank
+ *  uint64 number of rows
+ *  uint32 number of columns
+ *  for each column:
+ *    uint32 type
+ *    uint32 name length, followed by the name
+ *    uint64 number of bytes, followed by the data
+ *
+ * INTEGER columns are int64 values, REAL columns are doubles,
+ * TEXT columns are (rows+1) uint32 offsets followed by the characters.
+ *
+ * scripts/read-abundance-tables.py dumps the tables as TSV.
+ *
+ * \author Sébastien Boisvert
+ */
+class AbundanceTable{
+
+	string m_file;
+	int m_table;
+	Rank m_rank;
+	bool m_enabled;
+
+	uint64_t m_rows;
+	int m_rowGroupSize;
+
+	vector<string> m_names;
+	vector<int> m_types;
+
+	/** data for each column, serialized as they are added */
+	vector<vector<char> > m_data;
+
+	/** text offsets for TEXT columns */
+	vector<vector<uint32_t> > m_offsets;
+
+	LargeCount m_rowGroups;
+
+	void appendBytes(vector<char>*bytes,const void*data,int size);
+
+public:
+
+	AbundanceTable();
+
+	/** set the file to use and the table written, does nothing if enabled is false */
+	void constructor(const char*file,int table,Rank rank,bool enabled);
+
+	void addColumn(const char*name,int type);
+
+	void addInteger(int column,int64_t value);
+	void addReal(int column,double value);
+	void addText(int column,const char*value);
+
+	/** the row is completed, a row group is appended when enough rows are buffered */
+	void endRow();
+
+	/** append buffered rows, if any */
+	void flush();
+
+	bool isEnabled();
+	LargeCount getNumberOfRowGroups();
+};
+
+#endif
@@ -614,3 +614,86 @@ void ColorSet::printPhysicalColors(set<PhysicalKmerColor>*colors3){
 	}
 	cout<<endl;
 }
+
+void ColorSet::save(ostream*f){
+	uint64_t virtualColors=getTotalNumberOfVirtualColors();
+	f->write((char*)&virtualColors,sizeof(uint64_t));
+
+	for(uint64_t i=0;i<virtualColors;i++){
+		VirtualKmerColor*virtualColor=getVirtualColor(i);
+		uint64_t hashValue=virtualColor->getCachedHashValue();
+		f->write((char*)&hashValue,sizeof(uint64_t));
+
+		set<PhysicalKmerColor>*colors=virtualColor->getPhysicalColors();
+		uint32_t physicalColors=colors->size();
+		f->write((char*)&physicalColors,sizeof(uint32_t));
+
+		for(set<PhysicalKmerColor>::iterator j=colors->begin();j!=colors->end();j++){
+			PhysicalKmerColor color=*j;
+			f->write((char*)&color,sizeof(PhysicalKmerColor));
+		}
+	}
+}
+
+void ColorSet::load(istream*f){
+	m_virtualColors.clear();
+	m_availableHandles.clear();
+	m_physicalColors.clear();
+	m_index.clear();
+
+	uint64_t virtualColors=0;
+	f->read((char*)&virtualColors,sizeof(uint64_t));
+
+	for(uint64_t i=0;i<virtualColors;i++){
+		VirtualKmerColorHandle handle=createVirtualColorHandleFromScratch();
+
+		#ifdef ASSERT
+		assert(handle==i);
+		#endif
+
+		VirtualKmerColor*virtualColor=getVirtualColor(handle);
+
+		uint64_t hashValue=0;
+		f->read((char*)&hashValue,sizeof(uint64_t));
+
+		uint32_t physicalColors=0;
+		f->read((char*)&physicalColors,sizeof(uint32_t));
+
+		for(uint32_t j=0;j<physicalColors;j++){
+			PhysicalKmerColor color=0;
+			f->read((char*)&color,sizeof(PhysicalKmerColor));
+			virtualColor->addPhysicalColor(color);
+			m_physicalColors.insert(color);
+		}
+
+		virtualColor->setHash(hashValue);
+
+		// the empty virtual color is never indexed
+		if(handle==0)
+			continue;
+
+		// a virtual color that was purged before the checkpoint
+		if(physicalColors==0){
+			m_availableHandles.insert(handle);
+			continue;
+		}
+
+		addVirtualColorToIndex(handle);
+	}
+
+	// a checkpoint always has the empty virtual color
+	if(getTotalNumberOfVirtualColors()==0)
+		createVirtualColorHandleFromScratch();
+}
+
+void ColorSet::purgeUnreferencedVirtualColors(){
+	for(VirtualKmerColorHandle handle=1;handle<getTotalNumberOfVirtualColors();handle++){
+		if(getNumberOfReferences(handle)>0)
+			continue;
+
+		if(m_availableHandles.count(handle)>0)
+			continue;
+
+		purgeVirtualColor(handle);
+	}
+}
@@ -28,6 +28,7 @@
 #include <vector>
 #include <map>
 #include <iostream>
+#include <fstream>
 using namespace std;
 
 // maximum value for a uint64_t:
@@ -140,6 +141,18 @@ public:
 	set<PhysicalKmerColor>*getPhysicalColors(VirtualKmerColorHandle handle);
 
 	bool virtualColorHasPhysicalColor(VirtualKmerColorHandle handle,PhysicalKmerColor color);
+
+/** write the virtual colors for the checkpoint ColoredGraph.
+ * references are not written, they are restored by the k-mers. **/
+	void save(ostream*f);
+
+/** read virtual colors written by save().
+ * All virtual colors have 0 references until incrementReferences()
+ * is called for each k-mer. Call purgeUnreferencedVirtualColors() after that. **/
+	void load(istream*f);
+
+/** purge virtual colors that were loaded but that no k-mer uses **/
+	void purgeUnreferencedVirtualColors();
 };
 
 #endif
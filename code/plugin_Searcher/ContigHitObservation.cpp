@@ -0,0 +1,96 @@
+/*
+ 	Ray
+    Copyright (C) 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#include <plugin_Searcher/ContigHitObservation.h>
+
+#include <algorithm>
+
+ContigHitObservation::ContigHitObservation(PathHandle contig,int contigPosition,Strand strand){
+	m_contig=contig;
+	m_contigPosition=contigPosition;
+	m_strand=strand;
+}
+
+PathHandle ContigHitObservation::getContig()const{
+	return m_contig;
+}
+
+int ContigHitObservation::getContigPosition()const{
+	return m_contigPosition;
+}
+
+Strand ContigHitObservation::getStrand()const{
+	return m_strand;
+}
+
+bool ContigHitObservation_compareContigPositions(const ContigHitObservation&a,const ContigHitObservation&b){
+	if(a.getContig()!=b.getContig())
+		return a.getContig()<b.getContig();
+
+	return a.getContigPosition()<b.getContigPosition();
+}
+
+bool ContigHitObservation_compareStrandContig(const ContigHitObservation&a,const ContigHitObservation&b){
+	if(a.getStrand()!=b.getStrand())
+		return a.getStrand()<b.getStrand();
+
+	return a.getContig()<b.getContig();
+}
+
+void ContigHitObservation_reduce(vector<ContigHitObservation>*observations,int sequence,vector<ContigHit>*hits){
+
+	if(observations->size()==0)
+		return;
+
+	// stable, so that the first observation of a contig position
+	// stays in front of the others
+	stable_sort(observations->begin(),observations->end(),ContigHitObservation_compareContigPositions);
+
+	// keep one observation per contig position
+	int kept=0;
+	for(int i=0;i<(int)observations->size();i++){
+		if(kept>0 && observations->at(kept-1).getContig()==observations->at(i).getContig()
+			&& observations->at(kept-1).getContigPosition()==observations->at(i).getContigPosition())
+			continue;
+
+		(*observations)[kept++]=observations->at(i);
+	}
+
+	observations->erase(observations->begin()+kept,observations->end());
+
+	// each contig position is now unique,
+	// count the run lengths for each (strand, contig)
+	sort(observations->begin(),observations->end(),ContigHitObservation_compareStrandContig);
+
+	int first=0;
+	while(first<(int)observations->size()){
+		int last=first;
+
+		while(last<(int)observations->size()
+			&& observations->at(last).getStrand()==observations->at(first).getStrand()
+			&& observations->at(last).getContig()==observations->at(first).getContig())
+			last++;
+
+		ContigHit hit(sequence,observations->at(first).getContig(),observations->at(first).getStrand(),last-first);
+		hits->push_back(hit);
+
+		first=last;
+	}
+}
@@ -0,0 +1,69 @@
+/*
+ 	Ray
+    Copyright (C) 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+*/
+
+#ifndef _ContigHitObservation_h
+#define _ContigHitObservation_h
+
+#include <application_core/constants.h>
+#include <core/types.h>
+#include <plugin_Searcher/ContigHit.h>
+
+#include <stdint.h>
+#include <vector>
+using namespace std;
+
+/**
+ * One observation of a contig position for a k-mer of a searched sequence.
+ * Observations are appended to a flat vector while replies arrive
+ * and reduced once the sequence is completed.
+ *
+ * \author Sébastien Boisvert
+ */
+class ContigHitObservation{
+
+	PathHandle m_contig;
+	int m_contigPosition;
+	Strand m_strand;
+
+public:
+
+	ContigHitObservation(PathHandle contig,int contigPosition,Strand strand);
+
+	PathHandle getContig()const;
+	int getContigPosition()const;
+	Strand getStrand()const;
+};
+
+/** order by contig, then by contig position **/
+bool ContigHitObservation_compareContigPositions(const ContigHitObservation&a,const ContigHitObservation&b);
+
+/** order by strand, then by contig **/
+bool ContigHitObservation_compareStrandContig(const ContigHitObservation&a,const ContigHitObservation&b);
+
+/**
+ * Reduce observations to hits.
+ * A contig position is utilised only once for the whole sequence,
+ * the first observation (in arrival order) wins the strand.
+ * Hits are appended strand 'F' first, then strand 'R', by contig.
+ * The content of observations is destroyed.
+ */
+void ContigHitObservation_reduce(vector<ContigHitObservation>*observations,int sequence,vector<ContigHit>*hits);
+
+#endif
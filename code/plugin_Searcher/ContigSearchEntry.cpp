@@ -73,3 +73,28 @@ void ContigSearchEntry::write(ofstream*file,LargeCount total,int kmerLength){
 	(*file)<<"	"<<getTotal()<<"	";
 	(*file)<<total<<"	"<<ratio<<endl;
 }
+
+/** same columns as write() **/
+void ContigSearchEntry::writeRow(AbundanceTable*table,LargeCount total,int kmerLength){
+	double ratio=getTotal();
+
+	if(total!=0)
+		ratio/=total;
+
+	double ratioColored=m_coloredKmers;
+	if(getLength()!=0){
+		ratioColored/=getLength();
+	}
+
+	int column=0;
+	table->addInteger(column++,getName());
+	table->addInteger(column++,kmerLength);
+	table->addInteger(column++,getLength());
+	table->addInteger(column++,m_coloredKmers);
+	table->addReal(column++,ratioColored);
+	table->addInteger(column++,getMode());
+	table->addInteger(column++,getTotal());
+	table->addInteger(column++,total);
+	table->addReal(column++,ratio);
+	table->endRow();
+}
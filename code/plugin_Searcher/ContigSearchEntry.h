@@ -25,6 +25,8 @@
 #include <fstream>
 using namespace std;
 
+#include <plugin_Searcher/AbundanceTable.h>
+
 #ifndef _ContigSearchEntry_h
 #define _ContigSearchEntry_h
 
@@ -45,6 +47,7 @@ public:
 	int getTotal();
 
 	void write(ofstream*f,LargeCount total,int kmerLength);
+	void writeRow(AbundanceTable*table,LargeCount total,int kmerLength);
 };
 
 #endif
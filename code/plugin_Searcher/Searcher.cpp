@@ -25,6 +25,7 @@
 #define DEBUG_GRAPH_COUNTS
 
 #include <plugin_Searcher/Searcher.h>
+#include <application_core/CheckpointFile.h>
 #include <plugin_VerticesExtractor/Vertex.h>
 #include <core/OperatingSystem.h>
 #include <core/ComputeCore.h>
@@ -107,6 +108,67 @@ GridTable*graph){
 	m_searchDirectories=NULL;
 
 	m_pendingMessages=0;
+	m_sentHits=0;
+
+	m_configuredAbundanceTables=false;
+	m_firstDirectoryToColor=0;
+}
+
+/** the tables are configured lazily because entries can
+ * arrive before the slave mode is started **/
+void Searcher::configureAbundanceTables(){
+
+	if(m_configuredAbundanceTables)
+		return;
+
+	ostringstream file;
+	file<<m_parameters->getPrefix()<<"/BiologicalAbundances/"<<ABUNDANCE_TABLE_FILE;
+
+	bool enabled=m_parameters->hasOption("-write-abundance-tables");
+
+	m_sequenceTable.constructor(file.str().c_str(),ABUNDANCE_TABLE_SEQUENCES,m_parameters->getRank(),enabled);
+
+	// same columns as SequenceAbundances.xml
+	m_sequenceTable.addColumn("searchDirectory",ABUNDANCE_COLUMN_TEXT);
+	m_sequenceTable.addColumn("file",ABUNDANCE_COLUMN_TEXT);
+	m_sequenceTable.addColumn("sequence",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("name",ABUNDANCE_COLUMN_TEXT);
+	m_sequenceTable.addColumn("kmerLength",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("lengthInKmers",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("kmerMatches",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("proportion",ABUNDANCE_COLUMN_REAL);
+	m_sequenceTable.addColumn("modeKmerCoverage",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("uniquelyColoredKmerMatches",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("uniquelyColoredProportion",ABUNDANCE_COLUMN_REAL);
+	m_sequenceTable.addColumn("uniquelyColoredModeKmerCoverage",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("assembledKmerMatches",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("assembledProportion",ABUNDANCE_COLUMN_REAL);
+	m_sequenceTable.addColumn("assembledModeKmerCoverage",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("uniquelyColoredAndAssembledKmerMatches",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("uniquelyColoredAndAssembledProportion",ABUNDANCE_COLUMN_REAL);
+	m_sequenceTable.addColumn("uniquelyColoredAndAssembledModeKmerCoverage",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("correlationColoredVsRaw",ABUNDANCE_COLUMN_REAL);
+	m_sequenceTable.addColumn("correlationAssembledVsRaw",ABUNDANCE_COLUMN_REAL);
+	m_sequenceTable.addColumn("correlationAssembledVsColored",ABUNDANCE_COLUMN_REAL);
+	m_sequenceTable.addColumn("hasPeak",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("hasHighFrequency",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("demultiplexedKmerObservations",ABUNDANCE_COLUMN_INTEGER);
+	m_sequenceTable.addColumn("demultiplexedProportion",ABUNDANCE_COLUMN_REAL);
+
+	m_contigTable.constructor(file.str().c_str(),ABUNDANCE_TABLE_CONTIGS,m_parameters->getRank(),enabled);
+
+	// same columns as _DeNovoAssembly/Contigs.tsv
+	m_contigTable.addColumn("contig",ABUNDANCE_COLUMN_INTEGER);
+	m_contigTable.addColumn("kmerLength",ABUNDANCE_COLUMN_INTEGER);
+	m_contigTable.addColumn("lengthInKmers",ABUNDANCE_COLUMN_INTEGER);
+	m_contigTable.addColumn("coloredKmers",ABUNDANCE_COLUMN_INTEGER);
+	m_contigTable.addColumn("coloredProportion",ABUNDANCE_COLUMN_REAL);
+	m_contigTable.addColumn("modeKmerCoverage",ABUNDANCE_COLUMN_INTEGER);
+	m_contigTable.addColumn("kmerObservations",ABUNDANCE_COLUMN_INTEGER);
+	m_contigTable.addColumn("total",ABUNDANCE_COLUMN_INTEGER);
+	m_contigTable.addColumn("proportion",ABUNDANCE_COLUMN_REAL);
+
+	m_configuredAbundanceTables=true;
 }
 
 void Searcher::call_RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE_AND_COLORS(Message*message){
@@ -699,11 +761,16 @@ void Searcher::call_RAY_MASTER_MODE_CONTIG_BIOLOGICAL_ABUNDANCES(){
 			m_contigLengths[m_listOfContigEntries[i].getName()]=m_listOfContigEntries[i].getLength();
 		}
 
+		configureAbundanceTables();
+
 		// write entries
 		for(int i=0;i<(int)m_listOfContigEntries.size();i++){
 			m_listOfContigEntries[i].write(&contigSummaryFile,total,m_parameters->getWordSize());
+			m_listOfContigEntries[i].writeRow(&m_contigTable,total,m_parameters->getWordSize());
 		}
 
+		m_contigTable.flush();
+
 		m_listOfContigEntries.clear();
 
 		contigSummaryFile.close();
@@ -837,7 +904,7 @@ void Searcher::call_RAY_SLAVE_MODE_CONTIG_BIOLOGICAL_ABUNDANCES(){
 		if(m_writeDetailedFiles){ /* now we write coverage frequencies */
 
 			#ifdef ASSERT
-			assert(m_coverageValues.size() == (*m_contigs)[m_contig].size());
+			assert((int)m_coverageValues.size() == (*m_contigs)[m_contig].size());
 			#endif
 
 			for(int i=0;i<(int)m_coverageValues.size();i++){
@@ -853,8 +920,8 @@ void Searcher::call_RAY_SLAVE_MODE_CONTIG_BIOLOGICAL_ABUNDANCES(){
 				// anyway the code path for getColorSpaceMode=true is not tested very well
 				bool coloredMode=m_parameters->getColorSpaceMode();
 
-				Kmer*kmer=&((*m_contigs)[m_contig][i]);
-				double gcRatio=kmer->getGuanineCytosineProportion(kmerLength,coloredMode);
+				Kmer kmer=(*m_contigs)[m_contig].at(i);
+				double gcRatio=kmer.getGuanineCytosineProportion(kmerLength,coloredMode);
 
 				#ifdef ASSERT
 				assert(coverage>=2);
@@ -1012,7 +1079,8 @@ void Searcher::call_RAY_SLAVE_MODE_CONTIG_BIOLOGICAL_ABUNDANCES(){
 			#endif
 
 			// get the kmer
-			Kmer*kmer=&((*m_contigs)[m_contig][m_contigPosition]);
+			Kmer kmerObject=(*m_contigs)[m_contig].at(m_contigPosition);
+			Kmer*kmer=&kmerObject;
 
 			int rankToFlush=m_parameters->_vertexRank(kmer);
 
@@ -1141,7 +1209,7 @@ void Searcher::call_RAY_SLAVE_MODE_CONTIG_BIOLOGICAL_ABUNDANCES(){
 	}
 }
 
-void Searcher::setContigs(vector<vector<Kmer> >*paths,vector<PathHandle>*names){
+void Searcher::setContigs(vector<ContigPath>*paths,vector<PathHandle>*names){
 	m_contigs=paths;
 	m_contigNames=names;
 }
@@ -1270,6 +1338,15 @@ void Searcher::call_RAY_SLAVE_MODE_SEARCHER_CLOSE(){
 	// close the distribution writer
 	m_writer.close();
 
+	// append the last row group
+	configureAbundanceTables();
+	m_sequenceTable.flush();
+
+	if(m_sequenceTable.getNumberOfRowGroups()>0){
+		cout<<"[IO] Rank "<<m_parameters->getRank()<<" appended "<<m_sequenceTable.getNumberOfRowGroups();
+		cout<<" row groups to "<<ABUNDANCE_TABLE_FILE<<endl;
+	}
+
 	m_switchMan->closeSlaveModeLocally(m_outbox,m_parameters->getRank());
 
 	cout<<"[IO] Input/output operations for sequence XML objects: "<<m_sequenceXMLflushOperations;
@@ -1445,7 +1522,8 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 			m_pendingMessages--;
 			
 			// next! ,please.
-			m_sortedHitsIterator++;
+			m_sortedHitsIterator+=m_sentHits;
+			m_sentHits=0;
 
 		// wait for a reply
 		}else if(m_pendingMessages>0){
@@ -1459,54 +1537,80 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 			assert(m_sortedHitsIterator!=m_sortedHits.end());
 			#endif
 
-			// here, m_contigCounts contains thing related to contig counts
+			// here, m_sortedHits contains thing related to contig counts
 			// seed a message to root with these information:
 			//
 			// directory
 			// file
 			// sequenceNumber
-			// sequenceName (possibly long) 
 			// <wordSize is known on the other end>
 			// sequenceLength
 			//
-			// number of contigs that have a hit
+			// number of contig hits in the message
 			//
 			//  for each contig hit:
 			//
 			// contigName
 			// <contig length is known on the other end>
+			// strand
 			// Matches on the contig in k-mers
-		
-			ContigHit hit=*m_sortedHitsIterator;
-			
-			PathHandle contig=hit.getContig();
-			int count=hit.getMatches();
-			char strand=hit.getStrand();
+			//
+			// sequenceName (possibly long) 
+			//
+			// as many hits as possible are packed in the same message
+
+			string sequenceName=m_searchDirectories[m_directoryIterator].getCurrentSequenceName();
 
 			MessageUnit*messageBuffer=(MessageUnit*)m_outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
 			int bufferPosition=0;
 
-			messageBuffer[bufferPosition++]=contig;
-			messageBuffer[bufferPosition++]=strand;
-			messageBuffer[bufferPosition++]=count;
 			messageBuffer[bufferPosition++]=m_directoryIterator;
 			messageBuffer[bufferPosition++]=m_fileIterator;
 			messageBuffer[bufferPosition++]=m_sequenceIterator;
 			messageBuffer[bufferPosition++]=m_numberOfKmers;
 
-			#ifdef ASSERT
-			if(count > m_numberOfKmers){
-				cout<<"Error before sending, count= "<<count<<" m_numberOfKmers= "<<m_numberOfKmers<<endl;
-				cout<<"m_sequenceIterator= "<<m_sequenceIterator<<endl;
-				cout<<"contig= "<<contig<<" strand= "<<strand<<endl;
-				cout<<"m_sortedHits.size()= "<<m_sortedHits.size()<<endl;
+			int positionForHits=bufferPosition++;
+
+			int unitsForName=(sequenceName.length()+1+sizeof(MessageUnit)-1)/sizeof(MessageUnit);
+			int availableUnits=MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit)-bufferPosition-unitsForName;
+			int maximumHits=availableUnits/3;
+
+			if(maximumHits<1)
+				maximumHits=1;
+
+			m_sentHits=0;
+
+			vector<ContigHit>::iterator hitIterator=m_sortedHitsIterator;
+
+			while(hitIterator!=m_sortedHits.end() && m_sentHits<maximumHits){
+
+				ContigHit hit=*hitIterator;
+			
+				PathHandle contig=hit.getContig();
+				int count=hit.getMatches();
+				char strand=hit.getStrand();
+
+				#ifdef ASSERT
+				if(count > m_numberOfKmers){
+					cout<<"Error before sending, count= "<<count<<" m_numberOfKmers= "<<m_numberOfKmers<<endl;
+					cout<<"m_sequenceIterator= "<<m_sequenceIterator<<endl;
+					cout<<"contig= "<<contig<<" strand= "<<strand<<endl;
+					cout<<"m_sortedHits.size()= "<<m_sortedHits.size()<<endl;
+				}
+				assert(count <= m_numberOfKmers);
+				#endif
+
+				messageBuffer[bufferPosition++]=contig;
+				messageBuffer[bufferPosition++]=strand;
+				messageBuffer[bufferPosition++]=count;
+
+				m_sentHits++;
+				hitIterator++;
 			}
-			assert(count <= m_numberOfKmers);
-			#endif
+
+			messageBuffer[positionForHits]=m_sentHits;
 
 			char*sequence=(char*) (messageBuffer+bufferPosition);
-			
-			string sequenceName=m_searchDirectories[m_directoryIterator].getCurrentSequenceName();
 
 			strcpy(sequence,sequenceName.c_str());
 
@@ -1608,7 +1712,7 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 		
 		m_currentLength=m_searchDirectories[m_directoryIterator].getCurrentSequenceLengthInKmers();
 
-		m_contigCounts.clear();
+		m_contigObservations.clear();
 
 		m_sortedHits.clear();
 		m_sortedHitsIterator=m_sortedHits.begin();
@@ -1744,38 +1848,15 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 				//cout<<"Adding hits for sequence "<<m_sequenceIterator<<endl;
 
 				// store the hits
-				// sort hits
-				for(map<PathHandle,set<int> >::iterator i=m_contigCounts['F'].begin();i!=m_contigCounts['F'].end();i++){
-					int matches=i->second.size();
-					PathHandle contig=i->first;
+				// the observations are sorted and reduced once for the whole sequence
+				ContigHitObservation_reduce(&m_contigObservations,m_sequenceIterator,&m_sortedHits);
 
-					ContigHit hit(m_sequenceIterator,contig,'F',matches);
-					m_sortedHits.push_back(hit);
-		
-					// the number of matches can not exceed the length
-					#ifdef ASSERT
-					assert(matches <= m_numberOfKmers);
-					#endif
-		
-					//cout<<"contig-"<<contig<<" has "<<matches<<" matches on strand 'F'"<<endl;
-					//cout.flush();
-				}
-		
-				for(map<PathHandle,set<int> >::iterator i=m_contigCounts['R'].begin();i!=m_contigCounts['R'].end();i++){
-					int matches=i->second.size();
-					PathHandle contig=i->first;
-		
-					ContigHit hit(m_sequenceIterator,contig,'R',matches);
-					m_sortedHits.push_back(hit);
-					
-					// the number of matches can not exceed the length
-					#ifdef ASSERT
-					assert(matches <= m_numberOfKmers);
-					#endif
-		
-					//cout<<"contig-"<<contig<<" has "<<matches<<" matches on strand 'R'"<<endl;
-					//cout.flush();
+				// the number of matches can not exceed the length
+				#ifdef ASSERT
+				for(int i=0;i<(int)m_sortedHits.size();i++){
+					assert(m_sortedHits[i].getMatches() <= m_numberOfKmers);
 				}
+				#endif
 		
 				// send a message to write the abundances
 
@@ -1927,8 +2008,10 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 			bool force=CONFIG_FORCE_VALUE_FOR_MAXIMUM_SPEED;
 
 			// pull k-mers from the sequence and fill buffers
-			// if one of the buffer if full,
-			// flush it and return and wait for a response
+			// full buffers are flushed as they fill up,
+			// and we stop when there are as many messages in flight
+			// as there are ranks -- the replies are then received in any order
+			int maximumPendingMessages=m_parameters->getSize();
 
 			bool gatheringKmers=true;
 
@@ -1988,14 +2071,16 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 					m_parameters->getRank(),force)){
 
 					m_pendingMessages++;
-					gatheringKmers=false;
+
+					if(m_pendingMessages>=maximumPendingMessages)
+						gatheringKmers=false;
 				}
 			}
 
-			// at this point, we flushed something
+			// at this point, we flushed enough things
 			// or we processed all k-mers
-			// if nothing was flushed, we force something now
-			if(m_pendingMessages==0){
+			// if all k-mers are processed, the half-full buffers are sent too
+			if(m_pendingMessages==0 || !m_searchDirectories[m_directoryIterator].hasNextKmer(m_kmerLength)){
 
 				m_pendingMessages+=m_bufferedData.flushAll(RAY_MPI_TAG_GET_COVERAGE_AND_PATHS,
 					m_outboxAllocator,
@@ -2034,7 +2119,7 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 			m_pendingMessages--;
 
 			#ifdef ASSERT
-			assert(m_pendingMessages==0);
+			assert(m_pendingMessages>=0);
 			#endif
 
 			// the size (number of MessageUnit) of things per vertex
@@ -2069,12 +2154,15 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 				// we will need it if it is repeated.
 				kmer.unpack(buffer,&bufferPosition);
 
-				int sequencePosition=buffer[bufferPosition++];
-	
+				// the sequence position is not needed here because
+				// the paths of a position are all in the same reply
 				#ifdef CONFIG_CONTIG_IDENTITY_VERBOSE
+				int sequencePosition=buffer[bufferPosition];
 				cout<<"sequence position "<<sequencePosition<<endl;
 				#endif
 
+				bufferPosition++; // skip the sequence position
+
 				// get the coverage.
 				int coverage=buffer[bufferPosition++];
 
@@ -2134,6 +2222,9 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 					//if(index < total)
 						//reply=true;
 
+					// the observations for this sequence position start here
+					int firstObservation=m_contigObservations.size();
+
 					for(int j=0;j<numberOfPaths;j++){
 						PathHandle contigPath=buffer[bufferPosition++];
 						int contigPosition=buffer[bufferPosition++];
@@ -2144,44 +2235,35 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 						#endif
 
 						// don't process the same item twice for the current position
-						if(m_observedPaths.count(sequencePosition)>0 
-							&& m_observedPaths[sequencePosition].count(contigPath)>0){  // a contig path can only be processed once per position<
-
-							#ifdef CONFIG_CONTIG_IDENTITY_VERBOSE
-							cout<<"Skipping because we already used "<<contigPath<<" for position "<<sequencePosition<<endl;
-							#endif
-
-							continue; // 
+						// a contig path can only be processed once per position,
+						// and there are only a few paths per position
+						bool observed=false;
+
+						for(int k=firstObservation;k<(int)m_contigObservations.size();k++){
+							if(m_contigObservations[k].getContig()==contigPath){
+								observed=true;
+								break;
+							}
 						}
 
-						// a contig position can only be utilised once
-						// for all the sequence queried
-						if((m_contigCounts['F'].count(contigPath)>0 && m_contigCounts['F'][contigPath].count(contigPosition)>0)
-							||(m_contigCounts['R'].count(contigPath)>0 && m_contigCounts['R'][contigPath].count(contigPosition)>0)){
+						if(observed){
 
 							#ifdef CONFIG_CONTIG_IDENTITY_VERBOSE
-							cout<<"Skipping because we already used contig "<<contigPosition<<" (contig position: "<<contigPosition<<" for current sequence"<<endl;
+							cout<<"Skipping because we already used "<<contigPath<<" for position "<<sequencePosition<<endl;
 							#endif
 
-							continue;  //
+							continue; // 
 						}
 
 						#ifdef CONFIG_CONTIG_IDENTITY_VERBOSE
 						cout<<"Adding contig "<<contigPath<<", position "<<contigPosition<<" for current sequence at position "<<sequencePosition<<endl;
 						#endif
 
-						int theContigPosition=contigPosition;
-
-						// add the contig position
-						m_contigCounts[strand][contigPath].insert(theContigPosition);
-
-						// the number of matches can not exceed the length
-						#ifdef ASSERT
-						assert((int)m_contigCounts[strand][contigPath].size()<= m_numberOfKmers);
-						#endif
-
-						// mark it as utilised for the current sequence position
-						m_observedPaths[sequencePosition].insert(contigPath);
+						// a contig position can only be utilised once
+						// for all the sequence queried, this is
+						// enforced when the observations are reduced
+						ContigHitObservation observation(contigPath,contigPosition,strand);
+						m_contigObservations.push_back(observation);
 	
 						// we don't care if the vertex is repeated
 						// for now.
@@ -2207,11 +2289,9 @@ void Searcher::call_RAY_SLAVE_MODE_SEQUENCE_BIOLOGICAL_ABUNDANCES(){
 				m_outbox->push_back(aMessage);
 				*/
 
-			}else{
+			}else if(m_pendingMessages==0){
+				// all the replies for this batch are in
 				m_requestedCoverage=false;
-		
-				// clear observed contigs for future sequence positions
-				m_observedPaths.clear();
 			}
 
 		// we processed all the k-mers
@@ -2793,6 +2873,166 @@ void Searcher::addColorToKmer(Vertex*node,PhysicalKmerColor color){
 
 }
 
+/**
+ * Load the checkpoint ColoredGraph.
+ *
+ * The colors of a sequence depend on its directory and on the number of
+ * sequences before it, so the checkpoint is only usable if the directories
+ * it contains are the first directories provided with -search, in the same order
+ * and with the same files.
+ *
+ * Returns the number of directories that are already colored.
+ */
+int Searcher::loadColoredGraph(){
+
+	if(!m_parameters->hasCheckpoint("ColoredGraph"))
+		return 0;
+
+	cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint ColoredGraph"<<endl;
+
+	CheckpointReader f(m_parameters,"ColoredGraph");
+
+	int directories=0;
+	f.read((char*)&directories,sizeof(int));
+
+	bool compatible=(directories<=m_searchDirectories_size);
+
+	for(int i=0;i<directories;i++){
+		int length=0;
+		f.read((char*)&length,sizeof(int));
+		string name(length,' ');
+		if(length>0)
+			f.read(&(name[0]),length);
+
+		int files=0;
+		f.read((char*)&files,sizeof(int));
+
+		if(compatible && (name!=*(m_searchDirectories[i].getDirectoryName())
+			|| files!=m_searchDirectories[i].getSize())){
+
+			cout<<"Rank "<<m_parameters->getRank()<<" Warning: directory "<<i<<" in checkpoint ColoredGraph is "<<name;
+			cout<<", but -search provided "<<*(m_searchDirectories[i].getDirectoryName())<<endl;
+			compatible=false;
+		}
+
+		for(int file=0;file<files;file++){
+			int count=0;
+			f.read((char*)&count,sizeof(int));
+
+			if(compatible && count!=m_searchDirectories[i].getCount(file)){
+				cout<<"Rank "<<m_parameters->getRank()<<" Warning: file "<<file<<" of "<<name;
+				cout<<" has changed since checkpoint ColoredGraph was written"<<endl;
+				compatible=false;
+			}
+		}
+	}
+
+	if(!compatible){
+		cout<<"Rank "<<m_parameters->getRank()<<" Warning: checkpoint ColoredGraph does not match -search, coloring all directories"<<endl;
+		f.close();
+		return 0;
+	}
+
+	m_colorSet.load(&f);
+
+	LargeCount n=0;
+	f.read((char*)&n,sizeof(LargeCount));
+
+	LargeCount missing=0;
+
+	for(LargeIndex i=0;i<n;i++){
+		Kmer kmer;
+		kmer.read(&f);
+		VirtualKmerColorHandle handle=0;
+		f.read((char*)&handle,sizeof(VirtualKmerColorHandle));
+
+		Vertex*node=m_subgraph->find(&kmer);
+
+		if(node==NULL){
+			missing++;
+			continue;
+		}
+
+		#ifdef ASSERT
+		assert(handle<m_colorSet.getTotalNumberOfVirtualColors());
+		assert(node->getVirtualColor()==0);
+		#endif
+
+		node->setVirtualColor(handle);
+		m_colorSet.incrementReferences(handle);
+	}
+
+	f.close();
+
+	m_colorSet.purgeUnreferencedVirtualColors();
+
+	cout<<"Rank "<<m_parameters->getRank()<<" loaded colors for "<<n-missing<<" vertices from checkpoint ColoredGraph ("<<directories<<" directories)"<<endl;
+
+	if(missing>0){
+		cout<<"Rank "<<m_parameters->getRank()<<" Warning: "<<missing<<" colored vertices from checkpoint ColoredGraph are not in the graph"<<endl;
+	}
+
+	return directories;
+}
+
+void Searcher::writeColoredGraph(){
+	cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint ColoredGraph"<<endl;
+	cout.flush();
+
+	CheckpointWriter f(m_parameters,"ColoredGraph");
+
+	f.write((char*)&m_searchDirectories_size,sizeof(int));
+
+	for(int i=0;i<m_searchDirectories_size;i++){
+		string*name=m_searchDirectories[i].getDirectoryName();
+		int length=name->length();
+		f.write((char*)&length,sizeof(int));
+		f.write(name->c_str(),length);
+
+		int files=m_searchDirectories[i].getSize();
+		f.write((char*)&files,sizeof(int));
+
+		for(int file=0;file<files;file++){
+			int count=m_searchDirectories[i].getCount(file);
+			f.write((char*)&count,sizeof(int));
+		}
+	}
+
+	m_colorSet.save(&f);
+
+	// only colored vertices are stored
+	LargeCount n=0;
+
+	GridTableIterator iterator;
+	iterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
+
+	while(iterator.hasNext()){
+		Vertex*node=iterator.next();
+		if(node->getVirtualColor()!=0)
+			n++;
+	}
+
+	f.write((char*)&n,sizeof(LargeCount));
+
+	iterator.constructor(m_subgraph,m_parameters->getWordSize(),m_parameters);
+
+	while(iterator.hasNext()){
+		Vertex*node=iterator.next();
+		Kmer key=*(iterator.getKey());
+		VirtualKmerColorHandle handle=node->getVirtualColor();
+
+		if(handle==0)
+			continue;
+
+		key.write(&f);
+		f.write((char*)&handle,sizeof(VirtualKmerColorHandle));
+	}
+
+	f.close();
+
+	cout<<"Rank "<<m_parameters->getRank()<<" wrote colors for "<<n<<" vertices in checkpoint ColoredGraph"<<endl;
+}
+
 void Searcher::call_RAY_MASTER_MODE_ADD_COLORS(){
 	if(!m_startedColors){
 		m_switchMan->openMasterMode(m_outbox,m_parameters->getRank());
@@ -2865,6 +3105,18 @@ void Searcher::call_RAY_SLAVE_MODE_ADD_COLORS(){
 		m_sequenceIterator=0;
 		m_globalSequenceIterator=0;
 
+		/* with the checkpoint ColoredGraph, only new directories are colored */
+		m_firstDirectoryToColor=loadColoredGraph();
+
+		for(int i=0;i<m_firstDirectoryToColor;i++){
+			for(int file=0;file<(int)m_searchDirectories[i].getSize();file++){
+				m_globalSequenceIterator+=m_searchDirectories[i].getCount(file);
+				m_globalFileIterator++;
+			}
+		}
+
+		m_directoryIterator=m_firstDirectoryToColor;
+
 		m_colorSequenceKmersSlaveStarted=true;
 		m_createdSequenceReader=false;
 
@@ -2902,7 +3154,7 @@ void Searcher::call_RAY_SLAVE_MODE_ADD_COLORS(){
 		int globalFile=0;
 		for(int i=0;i<m_searchDirectories_size;i++){
 			for(int file=0;file<(int)m_searchDirectories[i].getSize();file++){
-				if(isFileOwner(globalFile)){
+				if(i>=m_firstDirectoryToColor && isFileOwner(globalFile)){
 					m_filesToProcess++;
 					m_sequencesToProcess+= m_searchDirectories[i].getCount(file);
 				}
@@ -2957,6 +3209,15 @@ void Searcher::call_RAY_SLAVE_MODE_ADD_COLORS(){
 		m_locallyFinishedColoring=true;
 
 	}else if(m_inbox->hasMessage(RAY_MPI_TAG_GET_GRAPH_COUNTS)){
+
+		// all the ranks have finished coloring, so the colors of
+		// this part of the graph are final
+		if(m_parameters->writeCheckpoints() && (!m_parameters->hasCheckpoint("ColoredGraph")
+			|| m_firstDirectoryToColor<m_searchDirectories_size)){
+
+			writeColoredGraph();
+		}
+
 		// count the k-mer observations for the part of the graph
 
 		LargeCount localAssembledKmerObservations=0;
@@ -3523,6 +3784,39 @@ void Searcher::call_RAY_MPI_TAG_WRITE_SEQUENCE_ABUNDANCE_ENTRY(Message*message){
 			*(m_arrayOfFiles_tsv_Buffer[directoryIterator])<<m_fileNames[directoryIterator][fileIterator]<<"	"<<proportion<<endl;
 		}
 
+		// the same entry in the columnar file
+		configureAbundanceTables();
+
+		if(m_sequenceTable.isEnabled()){
+			int column=0;
+			m_sequenceTable.addText(column++,getDirectoryBaseName(directoryIterator).c_str());
+			m_sequenceTable.addText(column++,m_fileNames[directoryIterator][fileIterator].c_str());
+			m_sequenceTable.addInteger(column++,sequenceIterator);
+			m_sequenceTable.addText(column++,sequenceName.c_str());
+			m_sequenceTable.addInteger(column++,m_parameters->getWordSize());
+			m_sequenceTable.addInteger(column++,numberOfKmers);
+			m_sequenceTable.addInteger(column++,matches);
+			m_sequenceTable.addReal(column++,ratio);
+			m_sequenceTable.addInteger(column++,mode);
+			m_sequenceTable.addInteger(column++,coloredMatches);
+			m_sequenceTable.addReal(column++,coloredRatio);
+			m_sequenceTable.addInteger(column++,coloredMode);
+			m_sequenceTable.addInteger(column++,assembledMatches);
+			m_sequenceTable.addReal(column++,assembledRatio);
+			m_sequenceTable.addInteger(column++,assembledMode);
+			m_sequenceTable.addInteger(column++,coloredAssembledMatches);
+			m_sequenceTable.addReal(column++,coloredAssembledRatio);
+			m_sequenceTable.addInteger(column++,coloredAssembledMode);
+			m_sequenceTable.addReal(column++,qualityColoredVsAll);
+			m_sequenceTable.addReal(column++,qualityAssembledVsAll);
+			m_sequenceTable.addReal(column++,qualityAssembledVsColored);
+			m_sequenceTable.addInteger(column++,hasPeak);
+			m_sequenceTable.addInteger(column++,hasHighFrequency);
+			m_sequenceTable.addInteger(column++,demultiplexedObservations);
+			m_sequenceTable.addReal(column++,proportion);
+			m_sequenceTable.endRow();
+		}
+
 		flushSequenceAbundanceXMLBuffer(directoryIterator,false);
 
 	}
@@ -3536,13 +3830,42 @@ void Searcher::call_RAY_MPI_TAG_WRITE_SEQUENCE_ABUNDANCE_ENTRY(Message*message){
 
 void Searcher::call_RAY_MPI_TAG_CONTIG_IDENTIFICATION(Message*message){
 
-       	MessageUnit*messageBuffer=message->getBuffer();
+	MessageUnit*messageBuffer=message->getBuffer();
 
-       	// process the message
-       	int bufferPosition=0;
-       	PathHandle contig=messageBuffer[bufferPosition++];
+	// process the message
+	int bufferPosition=0;
 
-       	char strand=messageBuffer[bufferPosition++];
+	int directoryIterator=messageBuffer[bufferPosition++];
+	int fileIterator=messageBuffer[bufferPosition++];
+	int sequenceIterator=messageBuffer[bufferPosition++];
+	int numberOfKmers=messageBuffer[bufferPosition++];
+	int numberOfHits=messageBuffer[bufferPosition++];
+
+	#ifdef ASSERT
+	assert(directoryIterator<m_searchDirectories_size);
+	assert(fileIterator<m_searchDirectories[directoryIterator].getSize());
+	assert(numberOfHits>0);
+	#endif
+
+	// the sequence name is after the hits
+	char*sequenceName=(char*) (messageBuffer+bufferPosition+3*numberOfHits);
+
+	for(int i=0;i<numberOfHits;i++){
+		PathHandle contig=messageBuffer[bufferPosition++];
+		char strand=messageBuffer[bufferPosition++];
+		int count=messageBuffer[bufferPosition++];
+
+		writeContigIdentification(directoryIterator,fileIterator,sequenceIterator,numberOfKmers,
+			sequenceName,contig,strand,count);
+	}
+
+	// send a reply
+	m_switchMan->sendEmptyMessage(m_outbox,m_parameters->getRank(),
+		message->getSource(),RAY_MPI_TAG_CONTIG_IDENTIFICATION_REPLY);
+}
+
+void Searcher::writeContigIdentification(int directoryIterator,int fileIterator,int sequenceIterator,
+	int numberOfKmers,const char*sequenceName,PathHandle contig,char strand,int count){
 
        	#ifdef ASSERT
        	assert(m_contigLengths.count(contig)>0);
@@ -3550,7 +3873,6 @@ void Searcher::call_RAY_MPI_TAG_CONTIG_IDENTIFICATION(Message*message){
 
        	int kmerLength=m_parameters->getWordSize();
        	int contigLength=m_contigLengths[contig];
-       	int count=messageBuffer[bufferPosition++];
 
        	#ifdef ASSERT
        	assert(kmerLength>0);
@@ -3558,20 +3880,8 @@ void Searcher::call_RAY_MPI_TAG_CONTIG_IDENTIFICATION(Message*message){
        	assert(count>0);
        	#endif
 
-       	int directoryIterator=messageBuffer[bufferPosition++];
-       	int fileIterator=messageBuffer[bufferPosition++];
-
-       	#ifdef ASSERT
-       	assert(directoryIterator<m_searchDirectories_size);
-       	assert(fileIterator<m_searchDirectories[directoryIterator].getSize());
-       	#endif
-
        	string category=m_fileNames[directoryIterator][fileIterator];
 
-       	int sequenceIterator=messageBuffer[bufferPosition++];
-
-       	int numberOfKmers=messageBuffer[bufferPosition++];
-
        	// the number of matches can not be greater than
        	// the number of k-mers in the query sequence
        	// otherwise, it does not make sense
@@ -3583,8 +3893,6 @@ void Searcher::call_RAY_MPI_TAG_CONTIG_IDENTIFICATION(Message*message){
        	assert(count <= numberOfKmers);
        	#endif
 
-       	char*sequenceName=(char*) (messageBuffer+bufferPosition);
-
        	// contigLength can not be 0 anyway
        	double ratio=(0.0+count)/contigLength;
 
@@ -3641,10 +3949,6 @@ void Searcher::call_RAY_MPI_TAG_CONTIG_IDENTIFICATION(Message*message){
 
        		*(m_identificationFiles_Buffer[directoryIterator])<<line.str();
        	}
-
-	// send a reply
-	m_switchMan->sendEmptyMessage(m_outbox,m_parameters->getRank(),
-		message->getSource(),RAY_MPI_TAG_CONTIG_IDENTIFICATION_REPLY);
 }
 
 string Searcher::getDirectoryBaseName(int directoryIterator){
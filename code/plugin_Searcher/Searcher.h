@@ -46,10 +46,12 @@ using namespace std;
 #include <handlers/MasterModeHandler.h>
 #include <handlers/MessageTagHandler.h>
 #include <plugin_Searcher/ContigHit.h>
+#include <plugin_Searcher/ContigHitObservation.h>
 #include <plugin_Searcher/ColorSet.h>
 #include <plugins/CorePlugin.h>
 #include <plugin_Searcher/QualityCaller.h>
 #include <plugin_Searcher/DistributionWriter.h>
+#include <plugin_Searcher/AbundanceTable.h>
 #include <core/ComputeCore.h>
 
 
@@ -127,9 +129,21 @@ class Searcher :  public CorePlugin {
 	int m_finishedColoring;
 	bool m_locallyFinishedColoring;
 
+/** checkpoint ColoredGraph: directories before this one
+ * were already colored by a previous run */
+	int m_firstDirectoryToColor;
+	int loadColoredGraph();
+	void writeColoredGraph();
+
 /** an object that writes files */
 	DistributionWriter m_writer;
 
+/** optional columnar output (-write-abundance-tables) */
+	AbundanceTable m_sequenceTable;
+	AbundanceTable m_contigTable;
+	bool m_configuredAbundanceTables;
+	void configureAbundanceTables();
+
 	bool m_pumpedCounts;
 	void shareTotalGraphCounts();
 
@@ -187,14 +201,12 @@ class Searcher :  public CorePlugin {
 	RingAllocator*m_outboxAllocator;
 	TimePrinter*m_timePrinter;
 
-	/** counts for each contig for the current sequence
- * being processed
- *
- * map<char, map<contig, set<position > > > */
-	map<char, map<PathHandle,set<int> > > m_contigCounts;
+	/** contig positions observed for the current sequence
+ * being processed, reduced to hits once the sequence is done */
+	vector<ContigHitObservation> m_contigObservations;
 
-/** the set of observed paths for the current position */
-	map<int,set<PathHandle> > m_observedPaths;
+/** the number of hits packed in the pending identification message */
+	int m_sentHits;
 
 	// state of the machine
 	bool m_checkedHits;
@@ -235,7 +247,7 @@ class Searcher :  public CorePlugin {
 	bool m_writeDetailedFiles;
 
 	/** contig paths */
-	vector<vector<Kmer> >*m_contigs;
+	vector<ContigPath>*m_contigs;
 	vector<PathHandle>*m_contigNames;
 
 	// synchronization
@@ -287,6 +299,8 @@ class Searcher :  public CorePlugin {
 	map<int,ostringstream*> m_identificationFiles_Buffer;
 	int m_contigIdentificationflushOperations;
 	void flushContigIdentificationBuffer(int directory,bool force);
+	void writeContigIdentification(int directoryIterator,int fileIterator,int sequenceIterator,
+		int numberOfKmers,const char*sequenceName,PathHandle contig,char strand,int count);
 
 	// base names of directories
 	vector<string> m_directoryNames;
@@ -412,7 +426,7 @@ public:
 	VirtualCommunicator*m_vc,StaticVector*inbox,RingAllocator*outboxAllocator,
 		GridTable*graph);
 
-	void setContigs(vector<vector<Kmer> >*paths,vector<PathHandle>*names);
+	void setContigs(vector<ContigPath>*paths,vector<PathHandle>*names);
 
 	void call_RAY_MPI_TAG_GET_COVERAGE_AND_PATHS(Message*message);
 	void call_RAY_MPI_TAG_WRITE_SEQUENCE_ABUNDANCE_ENTRY(Message*message);
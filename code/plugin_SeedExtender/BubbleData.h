@@ -28,6 +28,7 @@
 #include<stdio.h>
 #include<stdlib.h>
 #include<set>
+#include<plugin_SeedExtender/KmerScratchTable.h>
 using namespace std;
 
 /*
@@ -39,11 +40,11 @@ class BubbleData{
 public:
 	// arcs with good coverage
 	std::vector<std::vector<Kmer> > m_BUBBLE_visitedVertices;
-	// all vertices.
-	std::vector<std::set<Kmer> > m_visitedVertices;
 	bool m_doChoice_bubbles_Detected;
 	bool m_doChoice_bubbles_Initiated;
-	map<Kmer,int> m_coverages;
+
+	// coverage of the vertices of all the trees
+	KmerScratchTable m_coverages;
 };
 
 #endif
@@ -28,16 +28,16 @@
 using namespace std;
 
 void BubbleTool::printStuff(Kmer root,vector<vector<Kmer> >*trees,
-map<Kmer,int>*coverages){
+KmerScratchTable*coverages){
 	int m_wordSize=m_parameters->getWordSize();
 	cout<<"Trees="<<trees->size()<<endl;
 	cout<<"root="<<root.idToWord(m_wordSize,m_parameters->getColorSpaceMode())<<endl;
 	cout<<"digraph{"<<endl;
 	map<Kmer,set<Kmer> > printedEdges;
 	
-	for(map<Kmer ,int>::iterator i=coverages->begin();i!=coverages->end();i++){
-		Kmer kmer=i->first;
-		cout<<kmer.idToWord(m_wordSize,m_parameters->getColorSpaceMode())<<" [label=\""<<kmer.idToWord(m_wordSize,m_parameters->getColorSpaceMode())<<" "<<i->second<<"\"]"<<endl;
+	for(int i=0;i<coverages->size();i++){
+		Kmer kmer=*(coverages->getKey(i));
+		cout<<kmer.idToWord(m_wordSize,m_parameters->getColorSpaceMode())<<" [label=\""<<kmer.idToWord(m_wordSize,m_parameters->getColorSpaceMode())<<" "<<coverages->getValue(i)<<"\"]"<<endl;
 	}
 	for(int j=0;j<(int)trees->size();j++){
 		for(int i=0;i<(int)trees->at(j).size();i+=2){
@@ -56,16 +56,30 @@ map<Kmer,int>*coverages){
 	cout<<"}"<<endl;
 }
 
+/** give a number to a vertex of the trees **/
+int BubbleTool::getVertex(Kmer*kmer){
+	int vertex=m_vertices.insert(kmer);
+
+	if(vertex==(int)m_coveringNumbers.size()){
+		m_coveringNumbers.push_back(0);
+		m_parents[0].push_back(KMER_SCRATCH_TABLE_NONE);
+		m_parents[1].push_back(KMER_SCRATCH_TABLE_NONE);
+		m_visitedInTree.push_back(KMER_SCRATCH_TABLE_NONE);
+	}
+
+	return vertex;
+}
+
 /**
  *
  */
 bool BubbleTool::isGenuineBubble(Kmer root,vector<vector<Kmer > >*trees,
-map<Kmer ,int>*coverages,int repeatCoverage){
+KmerScratchTable*coverages,int repeatCoverage){
 	#ifdef NO_BUBBLES
 	return false;
 	#endif
 
-	if((*coverages)[root]>= repeatCoverage){
+	if(coverages->get(&root)>= repeatCoverage){
 		return false;
 	}
 
@@ -96,64 +110,66 @@ map<Kmer ,int>*coverages,int repeatCoverage){
 	// substitution SNP is d=0
 	// del is 1, 2, or 3
 
-	map<Kmer ,int> coveringNumber;
+	m_vertices.clear();
+	m_coveringNumbers.clear();
+	m_parents[0].clear();
+	m_parents[1].clear();
+	m_visitedInTree.clear();
 
-	Kmer target;
-	bool foundTarget=false;
-	for(int j=0;j<(int)trees->size();j++){
+	int targetVertex=KMER_SCRATCH_TABLE_NONE;
+
+	for(int j=0;j<(int)trees->size() && targetVertex==KMER_SCRATCH_TABLE_NONE;j++){
 		for(int i=0;i<(int)trees->at(j).size();i+=2){
 			Kmer a=trees->at(j).at(i+1);
 			#ifdef ASSERT
-			if(coverages->count(a)==0){
+			if(!coverages->contains(&a)){
 				cout<<a.idToWord(m_parameters->getWordSize(),m_parameters->getColorSpaceMode())<<" has no coverage."<<endl;
 			}
-			assert(coverages->count(a)>0);
+			assert(coverages->contains(&a));
 			#endif
 
-			coveringNumber[a]++;
-			if(!foundTarget && coveringNumber[a]==2){
-				foundTarget=true;
-				target=a;
+			int vertex=getVertex(&a);
+			m_coveringNumbers[vertex]++;
+
+			if(m_coveringNumbers[vertex]==2){
+				targetVertex=vertex;
 				break;
 			}
 		}
 	}
 
-	if(!foundTarget){
+	if(targetVertex==KMER_SCRATCH_TABLE_NONE){
 		if(m_parameters->debugBubbles()){
 			cout<<"Target not found."<<endl;
 		}
 		return false;
 	}
 
-	if((*coverages)[target]>= repeatCoverage){
+	Kmer target=*(m_vertices.getKey(targetVertex));
+
+	if(coverages->get(&target)>= repeatCoverage){
 		return false;
 	}
 
 	#ifdef ASSERT
-	assert(coverages->count(root)>0);
-	assert(coverages->count(target)>0);
+	assert(coverages->contains(&root));
+	assert(coverages->contains(&target));
 	#endif
 	#ifdef ASSERT
-	int rootCoverage=(*coverages)[root];
-	int targetCoverage=(*coverages)[target];
+	int rootCoverage=coverages->get(&root);
+	int targetCoverage=coverages->get(&target);
 	assert(rootCoverage>0);
 	assert(targetCoverage>0);
 	#endif
 
-	vector<map<Kmer ,Kmer > > parents;
-
 	for(int j=0;j<(int)trees->size();j++){
-		map<Kmer ,Kmer > aVector;
-		parents.push_back(aVector);
 		for(int i=0;i<(int)trees->at(j).size();i+=2){
-			Kmer a=trees->at(j).at(i+0);
-			Kmer b=trees->at(j).at(i+1);
-			parents[j][b]=a;
+			int a=getVertex(&(trees->at(j).at(i+0)));
+			int b=getVertex(&(trees->at(j).at(i+1)));
+			m_parents[j][b]=a;
 		}
 	}
 
-	vector<vector<int> > observedValues;
 	/*
  *
  *  BUBBLE is below
@@ -166,58 +182,62 @@ map<Kmer ,int>*coverages,int repeatCoverage){
 	// accumulate observed values
 	// and stop when encountering
 	for(int j=0;j<(int)trees->size();j++){
-		vector<int> aVector;
-		observedValues.push_back(aVector);
-		set<Kmer > visited;
+		m_observedValues[j].clear();
 		
-		Kmer startingPoint=trees->at(j).at(0);
-		Kmer current=target;
+		int startingPoint=getVertex(&(trees->at(j).at(0)));
+		int current=targetVertex;
 
 		while(current!=startingPoint){
-			if(visited.count(current)>0){
+			if(m_visitedInTree[current]==j){
 				return false;
 			}
-			visited.insert(current);
-			Kmer theParent=parents[j][current];
-			int coverageValue=(*coverages)[theParent];
+			m_visitedInTree[current]=j;
+			int theParent=m_parents[j][current];
+
+			// the root can not be reached in this tree
+			if(theParent==KMER_SCRATCH_TABLE_NONE){
+				return false;
+			}
+
+			int coverageValue=coverages->get(m_vertices.getKey(theParent));
 
-			observedValues[j].push_back(coverageValue);
+			m_observedValues[j].push_back(coverageValue);
 			current=theParent;
 		}
 	}
 
 	if(m_parameters->debugBubbles()){
-		cout<<"O1="<<observedValues[0].size()<<" O2="<<observedValues[1].size()<<endl;
+		cout<<"O1="<<m_observedValues[0].size()<<" O2="<<m_observedValues[1].size()<<endl;
 	}
 
 	int sum1=0;
-	for(int i=0;i<(int)observedValues[0].size();i++){
-		sum1+=observedValues[0][i];
+	for(int i=0;i<(int)m_observedValues[0].size();i++){
+		sum1+=m_observedValues[0][i];
 	}
 
 	if(m_parameters->debugBubbles()){
 		cout<<"O1Values= ";
-		for(int i=0;i<(int)observedValues[0].size();i++){
-			cout<<observedValues[0][i]<<" ";
+		for(int i=0;i<(int)m_observedValues[0].size();i++){
+			cout<<m_observedValues[0][i]<<" ";
 		}
 		cout<<endl;
 	}
 
 	int sum2=0;
-	for(int i=0;i<(int)observedValues[1].size();i++){
-		sum2+=observedValues[1][i];
+	for(int i=0;i<(int)m_observedValues[1].size();i++){
+		sum2+=m_observedValues[1][i];
 	}
 	
 	if(m_parameters->debugBubbles()){
 		cout<<"O2Values= ";
-		for(int i=0;i<(int)observedValues[1].size();i++){
-			cout<<observedValues[1][i]<<" ";
+		for(int i=0;i<(int)m_observedValues[1].size();i++){
+			cout<<m_observedValues[1][i]<<" ";
 		}
 		cout<<endl;
 	}
 
-	if((int)observedValues[0].size()<2*m_parameters->getWordSize()
-	&& (int)observedValues[1].size()<2*m_parameters->getWordSize()){
+	if((int)m_observedValues[0].size()<2*m_parameters->getWordSize()
+	&& (int)m_observedValues[1].size()<2*m_parameters->getWordSize()){
 		if(sum1>sum2){
 			m_choice=trees->at(0).at(1);
 		}else if(sum2>sum1){
@@ -226,9 +246,9 @@ map<Kmer ,int>*coverages,int repeatCoverage){
 		// this will not happen often
 		}else if(sum1==sum2){
 			// take the shortest, if any
-			if(observedValues[0].size()<observedValues[1].size()){
+			if(m_observedValues[0].size()<m_observedValues[1].size()){
 				m_choice=trees->at(0).at(1);
-			}else if(observedValues[1].size()<observedValues[0].size()){
+			}else if(m_observedValues[1].size()<m_observedValues[0].size()){
 				m_choice=trees->at(1).at(1);
 			// same length and same sum, won't happen very often anyway
 			}else{
@@ -27,6 +27,7 @@
 #include <map>
 #include <plugin_KmerAcademyBuilder/Kmer.h>
 #include <application_core/Parameters.h>
+#include <plugin_SeedExtender/KmerScratchTable.h>
 using namespace std;
 
 /*
@@ -38,15 +39,26 @@ using namespace std;
 class BubbleTool{
 	Parameters*m_parameters;
 	Kmer m_choice;
+
+	// the vertices of the trees are numbered with this table
+	// and the arrays below are indexed by these numbers.
+	// Everything is re-used from one bubble to the next one.
+	KmerScratchTable m_vertices;
+	vector<int> m_coveringNumbers;
+	vector<int> m_parents[2];
+	vector<int> m_visitedInTree;
+	vector<int> m_observedValues[2];
+
+	int getVertex(Kmer*kmer);
 public:
 	bool isGenuineBubble(Kmer root, vector<vector<Kmer > >*trees,
-map<Kmer ,int>*coverages,int repeatCoverage);
+KmerScratchTable*coverages,int repeatCoverage);
 	void constructor(Parameters*p);
 
 	Kmer getTraversalStartingPoint();
 
 	void printStuff(Kmer root, vector<vector<Kmer > >*trees,
-map<Kmer ,int>*coverages);
+KmerScratchTable*coverages);
 };
 
 #endif
@@ -0,0 +1,166 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#include <plugin_SeedExtender/ChoiceTable.h>
+#include <plugin_SeedExtender/Chooser.h> // for IMPOSSIBLE_CHOICE
+
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
+void ChoiceTable::constructor(ExtensionData*ed){
+	m_choices=ed->m_enumerateChoices_outgoingEdges.size();
+
+	#ifdef ASSERT
+	assert(m_choices<=MAXIMUM_NUMBER_OF_CHOICES);
+	#endif
+
+	for(int i=0;i<m_choices;i++){
+		Kmer key=ed->m_enumerateChoices_outgoingEdges[i];
+
+		m_coverages[i]=ed->m_EXTENSION_coverages.at(i);
+
+		int count=0;
+		int sum=0;
+		int maximum=0;
+
+		map<Kmer,vector<int> >::iterator singleEnd=ed->m_EXTENSION_readPositionsForVertices.find(key);
+
+		if(singleEnd!=ed->m_EXTENSION_readPositionsForVertices.end()){
+			vector<int>*offsets=&(singleEnd->second);
+			count=offsets->size();
+
+			for(int j=0;j<count;j++){
+				int value=(*offsets)[j];
+				sum+=value;
+				if(value>maximum)
+					maximum=value;
+			}
+		}
+
+		m_singleEndCounts[i]=count;
+		m_singleEndSums[i]=sum;
+		m_singleEndMaximums[i]=maximum;
+
+		count=0;
+		maximum=0;
+
+		map<Kmer,vector<int> >::iterator paired=ed->m_EXTENSION_pairedReadPositionsForVertices.find(key);
+
+		if(paired!=ed->m_EXTENSION_pairedReadPositionsForVertices.end()){
+			vector<int>*offsets=&(paired->second);
+			count=offsets->size();
+
+			if(count>0)
+				maximum=(*offsets)[0];
+
+			for(int j=1;j<count;j++){
+				int value=(*offsets)[j];
+				if(value>maximum)
+					maximum=value;
+			}
+		}
+
+		m_pairedCounts[i]=count;
+		m_pairedMaximums[i]=maximum;
+	}
+
+	clearVictories();
+}
+
+int ChoiceTable::getNumberOfChoices(){
+	return m_choices;
+}
+
+int ChoiceTable::getCoverage(int choice){
+	return m_coverages[choice];
+}
+
+int ChoiceTable::getNumberOfSingleEndReads(int choice){
+	return m_singleEndCounts[choice];
+}
+
+int ChoiceTable::getNumberOfPairedReads(int choice){
+	return m_pairedCounts[choice];
+}
+
+void ChoiceTable::clearVictories(){
+	for(int i=0;i<MAXIMUM_NUMBER_OF_CHOICES;i++)
+		m_victories[i]=0;
+}
+
+int ChoiceTable::getWinner(){
+	for(int winner=0;winner<m_choices;winner++){
+		int wins=0;
+		for(int j=0;j<m_choices;j++)
+			wins+=(m_victories[winner]>>j)&1;
+
+		if(wins+1==m_choices)
+			return winner;
+	}
+	return IMPOSSIBLE_CHOICE;
+}
+
+void ChoiceTable::addCoverageVictories(int minimumCoverage){
+	for(int i=0;i<m_choices;i++){
+		// a coverage of at least 2*minimumCoverage is also at least minimumCoverage
+		if(m_coverages[i]<minimumCoverage)
+			continue;
+
+		for(int j=0;j<m_choices;j++){
+			if(i!=j && m_coverages[j]<=minimumCoverage/2)
+				m_victories[i]|=(1<<j);
+		}
+	}
+}
+
+void ChoiceTable::addPairedVictories(double multiplicator){
+	for(int i=0;i<m_choices;i++){
+		if(m_pairedCounts[i]==0)
+			continue;
+
+		for(int j=0;j<m_choices;j++){
+			if(m_pairedMaximums[i] > multiplicator*m_pairedMaximums[j]){
+				m_victories[i]|=(1<<j);
+
+			// same maximum, dodge sequencing errors
+			}else if(m_pairedMaximums[j] <= multiplicator*m_pairedMaximums[i]
+				&& m_pairedCounts[i]>20*m_pairedCounts[j]){
+				m_victories[i]|=(1<<j);
+			}
+		}
+	}
+}
+
+void ChoiceTable::addSingleEndVictories(double multiplicator){
+	for(int i=0;i<m_choices;i++){
+		if(m_singleEndMaximums[i]<5)
+			continue;
+
+		for(int j=0;j<m_choices;j++){
+			if((m_singleEndMaximums[i] > multiplicator*m_singleEndMaximums[j])
+				&& (m_singleEndSums[i] > multiplicator*m_singleEndSums[j])
+				&& (m_singleEndCounts[i] > multiplicator*m_singleEndCounts[j])){
+				m_victories[i]|=(1<<j);
+			}
+		}
+	}
+}
@@ -0,0 +1,74 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#ifndef _ChoiceTable_h
+#define _ChoiceTable_h
+
+#include <plugin_SeedExtender/ExtensionData.h>
+
+#include <stdint.h>
+
+/** a vertex has at most 4 children **/
+#define MAXIMUM_NUMBER_OF_CHOICES 4
+
+/**
+ * The read support of the choices at a branching point.
+ *
+ * The offsets of reads are summarized once for each choice in
+ * fixed arrays, and the duels between choices are bit masks:
+ * bit j of m_victories[i] is set when choice i wins against choice j.
+ *
+ * \author Sébastien Boisvert
+ */
+class ChoiceTable{
+	int m_choices;
+
+	int m_coverages[MAXIMUM_NUMBER_OF_CHOICES];
+
+	int m_singleEndCounts[MAXIMUM_NUMBER_OF_CHOICES];
+	int m_singleEndSums[MAXIMUM_NUMBER_OF_CHOICES];
+	int m_singleEndMaximums[MAXIMUM_NUMBER_OF_CHOICES];
+
+	int m_pairedCounts[MAXIMUM_NUMBER_OF_CHOICES];
+	int m_pairedMaximums[MAXIMUM_NUMBER_OF_CHOICES];
+
+	uint32_t m_victories[MAXIMUM_NUMBER_OF_CHOICES];
+
+public:
+
+	void constructor(ExtensionData*ed);
+
+	int getNumberOfChoices();
+	int getCoverage(int choice);
+	int getNumberOfSingleEndReads(int choice);
+	int getNumberOfPairedReads(int choice);
+
+	void clearVictories();
+
+/** the choice that wins against all others, or IMPOSSIBLE_CHOICE **/
+	int getWinner();
+
+	void addCoverageVictories(int minimumCoverage);
+	void addPairedVictories(double multiplicator);
+	void addSingleEndVictories(double multiplicator);
+};
+
+#endif
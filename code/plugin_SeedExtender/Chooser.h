@@ -27,6 +27,8 @@
 
 #define IMPOSSIBLE_CHOICE -1
 
+class ChoiceTable;
+
 /**
  * paired-end OpenAssembler chooser class
  * Given a seed, its last vertex can have children
@@ -35,8 +37,7 @@
  */
 class Chooser{
 public:
-	void chooseWithPairedReads(ExtensionData*m_ed,double m,
-		vector<set<int> >*battleVictories,Parameters*parameters);
+	void chooseWithPairedReads(ChoiceTable*table,double m);
 
 	void clear(int*a,int b);
 };
@@ -0,0 +1,272 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#include <plugin_SeedExtender/ContigPath.h>
+
+#include <algorithm>
+#include <deque>
+using namespace std;
+
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
+ContigPath::ContigPath(){
+	m_kmerLength=0;
+	clear();
+}
+
+void ContigPath::setKmerLength(int kmerLength){
+	m_kmerLength=kmerLength;
+}
+
+int ContigPath::getKmerLength(){
+	return m_kmerLength;
+}
+
+uint8_t ContigPath::getLastCode(Kmer*kmer){
+	int bitPosition=2*(m_kmerLength-1);
+
+	return (kmer->getU64(bitPosition/64)>>(bitPosition%64))&3;
+}
+
+/** same as Kmer::_getOutgoingEdges, for one edge **/
+void ContigPath::shiftForward(Kmer*kmer,uint8_t code){
+	int numberOfU64=kmer->getNumberOfU64();
+
+	for(int i=0;i<numberOfU64;i++){
+		uint64_t word=kmer->getU64(i)>>2;
+
+		if(i!=numberOfU64-1)
+			word|=(kmer->getU64(i+1)<<62);
+
+		kmer->setU64(i,word);
+	}
+
+	int bitPosition=2*(m_kmerLength-1);
+	int chunk=bitPosition/64;
+
+	kmer->setU64(chunk,kmer->getU64(chunk)|(((uint64_t)code)<<(bitPosition%64)));
+}
+
+void ContigPath::addCode(uint8_t code){
+	if(m_size%4==0)
+		m_codes.push_back(0);
+
+	m_codes[m_size/4]|=(code<<(2*(m_size%4)));
+	m_size++;
+}
+
+void ContigPath::push_back(Kmer*kmer){
+	#ifdef ASSERT
+	assert(m_kmerLength>0);
+	#endif
+
+	uint8_t code=getLastCode(kmer);
+
+	bool isAnchor=(m_size%CONTIG_PATH_ANCHOR_INTERVAL==0);
+
+	if(!isAnchor){
+		Kmer expected=m_last;
+		shiftForward(&expected,code);
+
+		isAnchor=(expected!=*kmer);
+	}
+
+	if(isAnchor){
+		m_anchorPositions.push_back(m_size);
+		m_anchors.push_back(*kmer);
+	}
+
+	m_last=*kmer;
+	addCode(code);
+}
+
+void ContigPath::extend(uint8_t code){
+	#ifdef ASSERT
+	assert(m_size>0);
+	#endif
+
+	Kmer kmer=m_last;
+	shiftForward(&kmer,code);
+	push_back(&kmer);
+}
+
+Kmer ContigPath::at(int position){
+	#ifdef ASSERT
+	assert(position>=0 && position<m_size);
+	#endif
+
+	int anchor=upper_bound(m_anchorPositions.begin(),m_anchorPositions.end(),position)-m_anchorPositions.begin()-1;
+	int start=m_anchorPositions[anchor];
+
+	Kmer kmer;
+
+	// continue from the previous call if it is on the way
+	if(m_cachedPosition>=start && m_cachedPosition<=position){
+		start=m_cachedPosition;
+		kmer=m_cachedKmer;
+	}else{
+		kmer=m_anchors[anchor];
+	}
+
+	for(int i=start+1;i<=position;i++)
+		shiftForward(&kmer,getCode(i));
+
+	m_cachedPosition=position;
+	m_cachedKmer=kmer;
+
+	return kmer;
+}
+
+uint8_t ContigPath::getCode(int position){
+	#ifdef ASSERT
+	assert(position>=0 && position<m_size);
+	#endif
+
+	return (m_codes[position/4]>>(2*(position%4)))&3;
+}
+
+int ContigPath::size(){
+	return m_size;
+}
+
+bool ContigPath::empty(){
+	return m_size==0;
+}
+
+void ContigPath::clear(){
+	m_size=0;
+	m_codes.clear();
+	m_anchorPositions.clear();
+	m_anchors.clear();
+	m_cachedPosition=-1;
+}
+
+void ContigPath::reserve(int numberOfKmers){
+	m_codes.reserve((numberOfKmers+3)/4);
+	m_anchorPositions.reserve(numberOfKmers/CONTIG_PATH_ANCHOR_INTERVAL+1);
+	m_anchors.reserve(numberOfKmers/CONTIG_PATH_ANCHOR_INTERVAL+1);
+}
+
+void ContigPath::getReverseComplement(bool colorSpace,ContigPath*output){
+	output->clear();
+	output->setKmerLength(m_kmerLength);
+	output->reserve(m_size);
+
+	vector<Kmer> block;
+
+	// the k-mers between two anchors are decoded together
+	for(int anchor=(int)m_anchorPositions.size()-1;anchor>=0;anchor--){
+		int first=m_anchorPositions[anchor];
+		int last=m_size-1;
+
+		if(anchor+1<(int)m_anchorPositions.size())
+			last=m_anchorPositions[anchor+1]-1;
+
+		block.clear();
+
+		Kmer kmer=m_anchors[anchor];
+		block.push_back(kmer);
+
+		for(int i=first+1;i<=last;i++){
+			shiftForward(&kmer,getCode(i));
+			block.push_back(kmer);
+		}
+
+		for(int i=(int)block.size()-1;i>=0;i--){
+			Kmer complement=block[i].complementVertex(m_kmerLength,colorSpace);
+			output->push_back(&complement);
+		}
+	}
+}
+
+void ContigPath::getMinimizerPositions(int window,vector<int>*positions){
+	positions->clear();
+
+	/* hash values that can still be the minimum of a window, in increasing order */
+	deque<pair<uint64_t,int> > candidates;
+
+	for(int i=0;i<m_size;i++){
+		Kmer kmer=at(i);
+		uint64_t hashValue=kmer.hash_function_2();
+
+		while(!candidates.empty() && candidates.back().first>hashValue)
+			candidates.pop_back();
+
+		candidates.push_back(pair<uint64_t,int>(hashValue,i));
+
+		if(candidates.front().second<=i-window)
+			candidates.pop_front();
+
+		if(i<window-1 && i!=m_size-1)
+			continue;
+
+		int minimizer=candidates.front().second;
+
+		if(positions->empty() || positions->back()!=minimizer)
+			positions->push_back(minimizer);
+	}
+}
+
+void ContigPath::write(ostream*f){
+	f->write((char*)&m_kmerLength,sizeof(int));
+	f->write((char*)&m_size,sizeof(int));
+
+	int anchors=m_anchors.size();
+	f->write((char*)&anchors,sizeof(int));
+
+	for(int i=0;i<anchors;i++){
+		f->write((char*)&(m_anchorPositions[i]),sizeof(int));
+		m_anchors[i].write(f);
+	}
+
+	if(!m_codes.empty())
+		f->write((char*)&(m_codes[0]),m_codes.size()*sizeof(uint8_t));
+}
+
+void ContigPath::read(istream*f){
+	clear();
+
+	f->read((char*)&m_kmerLength,sizeof(int));
+	f->read((char*)&m_size,sizeof(int));
+
+	int anchors=0;
+	f->read((char*)&anchors,sizeof(int));
+
+	for(int i=0;i<anchors;i++){
+		int position=0;
+		f->read((char*)&position,sizeof(int));
+		m_anchorPositions.push_back(position);
+
+		Kmer kmer;
+		kmer.read(f);
+		m_anchors.push_back(kmer);
+	}
+
+	m_codes.resize((m_size+3)/4);
+
+	if(!m_codes.empty())
+		f->read((char*)&(m_codes[0]),m_codes.size()*sizeof(uint8_t));
+
+	if(m_size>0)
+		m_last=at(m_size-1);
+}
@@ -0,0 +1,102 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#ifndef _ContigPath_h
+#define _ContigPath_h
+
+#include <plugin_KmerAcademyBuilder/Kmer.h>
+
+#include <stdint.h>
+#include <vector>
+#include <fstream>
+using namespace std;
+
+/** a full k-mer is stored every CONTIG_PATH_ANCHOR_INTERVAL positions **/
+#define CONTIG_PATH_ANCHOR_INTERVAL 64
+
+/**
+ * A path of k-mers in the de Bruijn graph, usually a contig.
+ *
+ * Two consecutive k-mers of a path overlap by k-1 nucleotides, so
+ * only the last nucleotide (2 bits) of each k-mer is stored, along with
+ * a full k-mer (an anchor) every CONTIG_PATH_ANCHOR_INTERVAL positions.
+ * A k-mer that does not overlap with the previous one is also stored as an anchor.
+ *
+ * at() rebuilds a k-mer from the nearest anchor before it, and the last k-mer
+ * obtained is kept so that reading a path in order costs one shift per k-mer.
+ *
+ * \author Sébastien Boisvert
+ */
+class ContigPath{
+
+	int m_kmerLength;
+	int m_size;
+
+/** 4 nucleotide codes per byte, the code of position i is the last nucleotide of its k-mer **/
+	vector<uint8_t> m_codes;
+
+	vector<int> m_anchorPositions;
+	vector<Kmer> m_anchors;
+
+/** the last k-mer of the path **/
+	Kmer m_last;
+
+/** the last k-mer returned by at() **/
+	int m_cachedPosition;
+	Kmer m_cachedKmer;
+
+	uint8_t getLastCode(Kmer*kmer);
+	void shiftForward(Kmer*kmer,uint8_t code);
+	void addCode(uint8_t code);
+
+public:
+
+	ContigPath();
+
+	void setKmerLength(int kmerLength);
+	int getKmerLength();
+
+	void push_back(Kmer*kmer);
+
+/** add the k-mer that follows the last k-mer with the nucleotide code **/
+	void extend(uint8_t code);
+
+	Kmer at(int position);
+
+/** the last nucleotide of the k-mer at position **/
+	uint8_t getCode(int position);
+
+	int size();
+	bool empty();
+	void clear();
+	void reserve(int numberOfKmers);
+
+	void getReverseComplement(bool colorSpace,ContigPath*output);
+
+/** the positions of the minimizers, every window of consecutive
+ * positions contains at least one of them **/
+	void getMinimizerPositions(int window,vector<int>*positions);
+
+	void write(ostream*f);
+	void read(istream*f);
+};
+
+#endif
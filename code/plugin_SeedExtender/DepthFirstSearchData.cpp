@@ -22,14 +22,24 @@
 #include <application_core/constants.h>
 #include <plugin_SeedExtender/DepthFirstSearchData.h>
 
+#include <algorithm>
+using namespace std;
+
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
 /*
  * do a depth first search with max depth of maxDepth;
+ *
+ * The vertices are visited by layers, so the number of round trips is the
+ * depth of the search instead of the number of vertices.
+ * One message is sent per call.
  */
 void DepthFirstSearchData::depthFirstSearch(Kmer root,Kmer a,int maxDepth,
-	bool*edgesRequested,bool*vertexCoverageRequested,bool*vertexCoverageReceived,
-	RingAllocator*outboxAllocator,int size,int theRank,StaticVector*outbox,
- int*receivedVertexCoverage,vector<Kmer>*receivedOutgoingEdges,
-		int minimumCoverage,bool*edgesReceived,int wordSize,Parameters*parameters){
+	bool*edgesRequested,bool*vertexCoverageRequested,
+	RingAllocator*outboxAllocator,int theRank,StaticVector*outbox,
+	SeedingData*seedingData,Parameters*parameters){
 	if(!m_doChoice_tips_dfs_initiated){
 		m_depthFirstSearchVisitedVertices.clear();
 		m_depthFirstSearchVisitedVertices_vector.clear();
@@ -39,109 +49,167 @@ void DepthFirstSearchData::depthFirstSearch(Kmer root,Kmer a,int maxDepth,
 		m_depthFirstSearchVisitedVertices_vector.push_back(a);
 
 		m_depthFirstSearchVisitedVertices_depths.clear();
-		while(m_depthFirstSearchVerticesToVisit.size()>0){
-			m_depthFirstSearchVerticesToVisit.pop();
-		}
-		while(m_depthFirstSearchDepths.size()>0){
-			m_depthFirstSearchDepths.pop();
-		}
+		m_frontier.clear();
+		m_frontier.push_back(a);
+		m_frontierDepth=0;
 		m_maxDepthReached=false;
-		m_depthFirstSearchVerticesToVisit.push(a);
-		m_depthFirstSearchVisitedVertices.insert(a);
-		m_depthFirstSearchDepths.push(0);
+		m_depthFirstSearchVisitedVertices.insert(&a);
 		m_depthFirstSearch_maxDepth=0;
 		m_doChoice_tips_dfs_initiated=true;
 		m_doChoice_tips_dfs_done=false;
 		m_coverages.clear();
 		(*edgesRequested)=false;
 		(*vertexCoverageRequested)=false;
+
+		startLayer(seedingData,parameters);
+
 		#ifdef SHOW_MINI_GRAPH
 		cout<<"<MiniGraph>"<<endl;
-		cout<<root->idToWord(wordSize,parameters->getColorSpaceMode())<<" -> "<<a->idToWord(wordSize,parameters->getColorSpaceMode())<<endl;
+		cout<<root.idToWord(parameters->getWordSize(),parameters->getColorSpaceMode())<<" -> "<<a.idToWord(parameters->getWordSize(),parameters->getColorSpaceMode())<<endl;
 		#endif
 	}
-	if(m_depthFirstSearchVerticesToVisit.size()>0){
-		Kmer vertexToVisit=m_depthFirstSearchVerticesToVisit.top();
-		if(!(*vertexCoverageRequested)){
-			(*vertexCoverageRequested)=true;
-			(*vertexCoverageReceived)=false;
-			
-			MessageUnit*message=(MessageUnit*)(*outboxAllocator).allocate(KMER_U64_ARRAY_SIZE*sizeof(MessageUnit));
-			int j=0;
-			vertexToVisit.pack(message,&j);
-			int dest=parameters->_vertexRank(&vertexToVisit);
-			
-			Message aMessage(message,j,dest,RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,theRank);
-			(*outbox).push_back(aMessage);
-		}else if((*vertexCoverageReceived)){
-			if(!(*edgesRequested)){
-				m_coverages[vertexToVisit]=(*receivedVertexCoverage);
-				m_depthFirstSearchVisitedVertices.insert(vertexToVisit);
-				int theDepth=m_depthFirstSearchDepths.top();
 
-				if(theDepth> m_depthFirstSearch_maxDepth){
-					m_depthFirstSearch_maxDepth=theDepth;
-				}
-			
-				// visit the vertex, and ask next edges.
-				MessageUnit*message=(MessageUnit*)(*outboxAllocator).allocate(1*sizeof(MessageUnit));
-				int bufferPosition=0;
-				vertexToVisit.pack(message,&bufferPosition);
-				int destination=parameters->_vertexRank(&vertexToVisit);
-				Message aMessage(message,bufferPosition,destination,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,theRank);
-				(*outbox).push_back(aMessage);
-				(*edgesRequested)=true;
-				(*edgesReceived)=false;
-			}else if((*edgesReceived)){
-				Kmer vertexToVisit=m_depthFirstSearchVerticesToVisit.top();
-				int theDepth=m_depthFirstSearchDepths.top();
-				#ifdef ASSERT
-				assert(theDepth>=0);
-				assert(theDepth<=maxDepth);
-				#endif
-				int newDepth=theDepth+1;
+	if(m_frontier.empty()){
+		m_doChoice_tips_dfs_done=true;
+		#ifdef SHOW_MINI_GRAPH
+		cout<<"</MiniGraph>"<<endl;
+		#endif
 
-				m_depthFirstSearchVerticesToVisit.pop();
-				m_depthFirstSearchDepths.pop();
+	}else if(m_sentQueries<(int)m_queries.size()){
+		sendLayerQuery(outboxAllocator,theRank,outbox);
 
-				for(int i=0;i<(int)(*receivedOutgoingEdges).size();i++){
-					Kmer nextVertex=(*receivedOutgoingEdges)[i];
-					if(m_depthFirstSearchVisitedVertices.count(nextVertex)>0){
-						continue;
-					}
-					if(newDepth>maxDepth){
-						m_maxDepthReached=true;
-						continue;
-					}
+	}else if(seedingData->m_SEEDING_receivedVertexReplies==m_sentMessages){
+		visitLayer(maxDepth,seedingData);
 
-					if(m_depthFirstSearchVisitedVertices.size()<MAX_VERTICES_TO_VISIT){
-						// add an arc
-						m_depthFirstSearchVisitedVertices_vector.push_back(vertexToVisit);
-						m_depthFirstSearchVisitedVertices_vector.push_back(nextVertex);
+		#ifdef SHOW_MINI_GRAPH
+		for(int i=0;i<(int)m_frontier.size();i++){
+			int arc=m_depthFirstSearchVisitedVertices_vector.size()-2*(m_frontier.size()-i);
+			Kmer parent=m_depthFirstSearchVisitedVertices_vector[arc];
+			cout<<parent.idToWord(parameters->getWordSize(),parameters->getColorSpaceMode())<<" -> "<<m_frontier[i].idToWord(parameters->getWordSize(),parameters->getColorSpaceMode())<<endl;
+		}
+		#endif
 
-						// add the depth for the vertex
-						m_depthFirstSearchVisitedVertices_depths.push_back(newDepth);
+		startLayer(seedingData,parameters);
+	}
+}
 
-						// stacks
-						m_depthFirstSearchVerticesToVisit.push(nextVertex);
-						m_depthFirstSearchDepths.push(newDepth);
-					}
+/**
+ * Sort the vertices of the layer by destination so that
+ * each rank receives one message.
+ */
+void DepthFirstSearchData::startLayer(SeedingData*seedingData,Parameters*parameters){
+	m_queries.clear();
 
+	for(int i=0;i<(int)m_frontier.size();i++){
+		int destination=parameters->_vertexRank(&(m_frontier[i]));
+		m_queries.push_back(pair<int,int>(destination,i));
+	}
 
-					#ifdef SHOW_MINI_GRAPH
-					cout<<vertexToVisit->idToWord(wordSize,parameters->getColorSpaceMode())<<" -> "<<nextVertex->idToWord(wordSize,parameters->getColorSpaceMode())<<endl;
-					#endif
-				}
-				(*edgesRequested)=false;
-				(*vertexCoverageRequested)=false;
+	sort(m_queries.begin(),m_queries.end());
+
+	m_sentQueries=0;
+	m_sentMessages=0;
+
+	seedingData->m_SEEDING_receivedVertexData.clear();
+	seedingData->m_SEEDING_receivedVertexReplies=0;
+}
+
+/**
+ * Send the vertices of the layer that go to the next destination.
+ */
+void DepthFirstSearchData::sendLayerQuery(RingAllocator*outboxAllocator,int theRank,StaticVector*outbox){
+	int destination=m_queries[m_sentQueries].first;
+
+	MessageUnit*message=(MessageUnit*)outboxAllocator->allocate(MAXIMUM_MESSAGE_SIZE_IN_BYTES);
+	int bufferPosition=0;
+	int vertices=0;
+
+	while(m_sentQueries<(int)m_queries.size() && m_queries[m_sentQueries].first==destination
+		&& vertices<DEPTH_FIRST_SEARCH_VERTICES_PER_QUERY){
+
+		m_frontier[m_queries[m_sentQueries].second].pack(message,&bufferPosition);
+
+		m_sentQueries++;
+		vertices++;
+	}
+
+	Message aMessage(message,bufferPosition,destination,RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES,theRank);
+	outbox->push_back(aMessage);
+
+	m_sentMessages++;
+}
+
+/**
+ * Visit the vertices of the layer in order, with the replies
+ * that arrived in any order.
+ */
+void DepthFirstSearchData::visitLayer(int maxDepth,SeedingData*seedingData){
+	vector<MessageUnit>*replies=&(seedingData->m_SEEDING_receivedVertexData);
+
+	m_replies.clear();
+
+	for(int i=0;i<(int)replies->size();i+=DEPTH_FIRST_SEARCH_REPLY_PERIOD){
+		Kmer vertex;
+		int bufferPosition=i;
+		vertex.unpack(replies,&bufferPosition);
+		m_replies.set(&vertex,bufferPosition);
+	}
+
+	#ifdef ASSERT
+	assert(m_replies.size()==(int)m_frontier.size());
+	assert(m_frontierDepth<=maxDepth);
+	#endif
+
+	if(m_frontierDepth> m_depthFirstSearch_maxDepth){
+		m_depthFirstSearch_maxDepth=m_frontierDepth;
+	}
+
+	int newDepth=m_frontierDepth+1;
+
+	m_nextFrontier.clear();
+
+	for(int i=0;i<(int)m_frontier.size();i++){
+		Kmer vertexToVisit=m_frontier[i];
+
+		#ifdef ASSERT
+		assert(m_replies.contains(&vertexToVisit));
+		#endif
+
+		int bufferPosition=m_replies.get(&vertexToVisit);
+
+		m_coverages.set(&vertexToVisit,(*replies)[bufferPosition++]);
+
+		int children=(*replies)[bufferPosition++];
+
+		for(int j=0;j<children;j++){
+			Kmer nextVertex;
+			nextVertex.unpack(replies,&bufferPosition);
+
+			if(m_depthFirstSearchVisitedVertices.contains(&nextVertex)){
+				continue;
+			}
+			if(newDepth>maxDepth){
+				m_maxDepthReached=true;
+				continue;
+			}
+
+			if(m_depthFirstSearchVisitedVertices.size()<MAX_VERTICES_TO_VISIT){
+				// add an arc
+				m_depthFirstSearchVisitedVertices_vector.push_back(vertexToVisit);
+				m_depthFirstSearchVisitedVertices_vector.push_back(nextVertex);
+
+				// add the depth for the vertex
+				m_depthFirstSearchVisitedVertices_depths.push_back(newDepth);
+
+				// a vertex is in only one layer
+				m_depthFirstSearchVisitedVertices.insert(&nextVertex);
+				m_nextFrontier.push_back(nextVertex);
 			}
 		}
-	}else{
-		m_doChoice_tips_dfs_done=true;
-		#ifdef SHOW_MINI_GRAPH
-		cout<<"</MiniGraph>"<<endl;
-		#endif
 	}
+
+	m_frontier.swap(m_nextFrontier);
+	m_frontierDepth=newDepth;
 }
 
 void DepthFirstSearchData::depthFirstSearchBidirectional(Kmer a,int maxDepth,
@@ -182,7 +250,7 @@ void DepthFirstSearchData::depthFirstSearchBidirectional(Kmer a,int maxDepth,
 
 		if(!(*vertexCoverageRequested)){
 
-			if(m_depthFirstSearchVisitedVertices.count(vertexToVisit)>0){
+			if(m_depthFirstSearchVisitedVertices.contains(&vertexToVisit)){
 				m_depthFirstSearchVerticesToVisit.pop();
 				m_depthFirstSearchDepths.pop();
 				return;
@@ -199,18 +267,18 @@ void DepthFirstSearchData::depthFirstSearchBidirectional(Kmer a,int maxDepth,
 			(*outbox).push_back(aMessage);
 		}else if((*vertexCoverageReceived)){
 			if(!(*edgesRequested)){
-				m_coverages[vertexToVisit]=(*receivedVertexCoverage);
+				m_coverages.set(&vertexToVisit,*receivedVertexCoverage);
 
 				#ifdef ASSERT
-				if(m_depthFirstSearchVisitedVertices.count(vertexToVisit)>0){
+				if(m_depthFirstSearchVisitedVertices.contains(&vertexToVisit)){
 					cout<<"Already visited: "<<vertexToVisit.idToWord(wordSize,parameters->getColorSpaceMode())<<" root is "<<a.idToWord(wordSize,parameters->getColorSpaceMode())<<endl;
 				}
-				assert(m_depthFirstSearchVisitedVertices.count(vertexToVisit)==0);
+				assert(!m_depthFirstSearchVisitedVertices.contains(&vertexToVisit));
 				assert(*receivedVertexCoverage>0);
 				#endif
 
 				if((*receivedVertexCoverage)>0){
-					m_depthFirstSearchVisitedVertices.insert(vertexToVisit);
+					m_depthFirstSearchVisitedVertices.insert(&vertexToVisit);
 				}else{
 					#ifdef ASSERT
 					assert(false);
@@ -267,7 +335,7 @@ void DepthFirstSearchData::depthFirstSearchBidirectional(Kmer a,int maxDepth,
 					if(m_depthFirstSearchVisitedVertices.size()>=MAX_VERTICES_TO_VISIT){
 						continue;
 					}
-					if(m_depthFirstSearchVisitedVertices.count(nextVertex)>0){
+					if(m_depthFirstSearchVisitedVertices.contains(&nextVertex)){
 						continue;
 					}
 					if(newDepth>maxDepth){
@@ -299,7 +367,7 @@ void DepthFirstSearchData::depthFirstSearchBidirectional(Kmer a,int maxDepth,
 					if(m_depthFirstSearchVisitedVertices.size()>=MAX_VERTICES_TO_VISIT){
 						continue;
 					}
-					if(m_depthFirstSearchVisitedVertices.count(nextVertex)>0){
+					if(m_depthFirstSearchVisitedVertices.contains(&nextVertex)){
 						continue;
 					}
 					if(newDepth>maxDepth){
@@ -344,10 +412,12 @@ map<Kmer,vector<Kmer> >*DepthFirstSearchData::getOutgoingEdges(){
 
 void DepthFirstSearchData::setTags(	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_EDGES,
-	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,
+	MessageTag RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES
 ){
 	this->RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES=RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES;
 	this->RAY_MPI_TAG_REQUEST_VERTEX_EDGES=RAY_MPI_TAG_REQUEST_VERTEX_EDGES;
 	this->RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE=RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
+	this->RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES=RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES;
 }
 
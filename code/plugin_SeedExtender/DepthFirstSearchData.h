@@ -31,11 +31,23 @@
 #include <memory/RingAllocator.h>
 #include <structures/StaticVector.h>
 #include <application_core/common_functions.h>
+#include <plugin_SeedExtender/KmerScratchTable.h>
 using namespace std;
 
+/** for each k-mer of a reply: the k-mer, its coverage, its number of
+ * children and room for 4 children **/
+#define DEPTH_FIRST_SEARCH_REPLY_PERIOD (2+5*KMER_U64_ARRAY_SIZE)
+
+/** k-mers in a query so that its reply fits in one message **/
+#define DEPTH_FIRST_SEARCH_VERTICES_PER_QUERY ((int)(MAXIMUM_MESSAGE_SIZE_IN_BYTES/sizeof(MessageUnit)/DEPTH_FIRST_SEARCH_REPLY_PERIOD))
+
 /*
  * Data for depth first search.
  *
+ * depthFirstSearch explores the graph one layer (depth) at a time:
+ * the vertices of a layer are queried with one message per rank
+ * and the next layer is started when all the replies are there.
+ *
  * \author Sébastien Boisvert
  */
 class DepthFirstSearchData{
@@ -43,9 +55,27 @@ class DepthFirstSearchData{
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_EDGES;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES;
+	MessageTag RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES;
 
 	bool m_outgoingEdgesDone;
 
+	// the layer being explored and the next one
+	vector<Kmer> m_frontier;
+	vector<Kmer> m_nextFrontier;
+	int m_frontierDepth;
+
+	// destination and position in the layer of each vertex, sorted by destination
+	vector<pair<int,int> > m_queries;
+	int m_sentQueries;
+	int m_sentMessages;
+
+	// position of each vertex in the replies
+	KmerScratchTable m_replies;
+
+	void startLayer(SeedingData*seedingData,Parameters*parameters);
+	void sendLayerQuery(RingAllocator*outboxAllocator,int theRank,StaticVector*outbox);
+	void visitLayer(int maxDepth,SeedingData*seedingData);
+
 	map<Kmer,vector<Kmer> > m_outgoingEdges;
 	map<Kmer,vector<Kmer> > m_ingoingEdges;
 
@@ -53,7 +83,8 @@ public:
 	void setTags(
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_EDGES,
-	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,
+	MessageTag RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES
 );
 
 	bool m_maxDepthReached;
@@ -67,18 +98,19 @@ public:
 	MyStack<int> m_depthFirstSearchDepths;
 	int m_doChoice_tips_i;
 	vector<int> m_doChoice_tips_newEdges;
-	set<Kmer> m_depthFirstSearchVisitedVertices;
+	KmerScratchTable m_depthFirstSearchVisitedVertices;
 	MyStack<Kmer> m_depthFirstSearchVerticesToVisit;
 	vector<Kmer> m_depthFirstSearchVisitedVertices_vector;
 	vector<int> m_depthFirstSearchVisitedVertices_depths;
-	map<Kmer,int> m_coverages;
+
+	/** coverage of each visited vertex **/
+	KmerScratchTable m_coverages;
 
 
 	void depthFirstSearch(Kmer root,Kmer a,int maxDepth,
-	bool*edgesRequested,bool*vertexCoverageRequested,bool*vertexCoverageReceived,
-	RingAllocator*outboxAllocator,int size,int theRank,StaticVector*outbox,
- int*receivedVertexCoverage,vector<Kmer>*receivedOutgoingEdges,
-		int minimumCoverage,bool*edgesReceived,int wordSize,Parameters*parameters);
+	bool*edgesRequested,bool*vertexCoverageRequested,
+	RingAllocator*outboxAllocator,int theRank,StaticVector*outbox,
+	SeedingData*seedingData,Parameters*parameters);
 
 	void depthFirstSearchBidirectional(Kmer a,int maxDepth,
 	bool*edgesRequested,bool*vertexCoverageRequested,bool*vertexCoverageReceived,
@@ -26,6 +26,7 @@
 #include <plugin_SequencesLoader/Read.h>
 #include <application_core/Parameters.h>
 #include <plugin_SeedExtender/ExtensionElement.h>
+#include <plugin_SeedExtender/ContigPath.h>
 #include <plugin_SeedingData/AssemblySeed.h>
 #include <profiling/Profiler.h>
 #include <plugin_SequencesIndexer/ReadAnnotation.h>
@@ -81,7 +82,7 @@ public:
 	AssemblySeed m_EXTENSION_currentSeed;
 
 	int m_EXTENSION_numberOfRanksDone;
-	vector<vector<Kmer > > m_EXTENSION_contigs;
+	vector<ContigPath> m_EXTENSION_contigs;
 	bool m_EXTENSION_checkedIfCurrentVertexIsAssembled;
 	bool m_EXTENSION_VertexMarkAssembled_requested;
 	bool m_EXTENSION_reverseComplement_requested;
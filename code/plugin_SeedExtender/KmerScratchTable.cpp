@@ -0,0 +1,158 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#include <plugin_SeedExtender/KmerScratchTable.h>
+
+#ifdef ASSERT
+#include <assert.h>
+#endif
+
+KmerScratchTable::KmerScratchTable(){
+	m_buckets.resize(KMER_SCRATCH_TABLE_INITIAL_BUCKETS,KMER_SCRATCH_TABLE_NONE);
+	m_generations.resize(KMER_SCRATCH_TABLE_INITIAL_BUCKETS,0);
+	m_generation=1;
+}
+
+void KmerScratchTable::clear(){
+	m_keys.clear();
+	m_values.clear();
+
+	m_generation++;
+
+	/* after a wrap-around, old generations could match again */
+	if(m_generation==0){
+		for(int i=0;i<(int)m_generations.size();i++)
+			m_generations[i]=0;
+
+		m_generation=1;
+	}
+}
+
+int KmerScratchTable::size(){
+	return m_keys.size();
+}
+
+int KmerScratchTable::findBucket(Kmer*key){
+
+	/* the size is a power of 2 */
+	uint64_t mask=m_buckets.size()-1;
+	uint64_t bucket=key->hash_function_1()&mask;
+
+	while(m_generations[bucket]==m_generation){
+		if(m_keys[m_buckets[bucket]]==*key)
+			return bucket;
+
+		bucket=(bucket+1)&mask;
+	}
+
+	return bucket;
+}
+
+int KmerScratchTable::find(Kmer*key){
+	int bucket=findBucket(key);
+
+	if(m_generations[bucket]!=m_generation)
+		return KMER_SCRATCH_TABLE_NONE;
+
+	return m_buckets[bucket];
+}
+
+bool KmerScratchTable::contains(Kmer*key){
+	return find(key)!=KMER_SCRATCH_TABLE_NONE;
+}
+
+int KmerScratchTable::insert(Kmer*key){
+	int bucket=findBucket(key);
+
+	if(m_generations[bucket]==m_generation)
+		return m_buckets[bucket];
+
+	if(2*(size()+1)>(int)m_buckets.size()){
+		grow();
+		bucket=findBucket(key);
+	}
+
+	int entry=size();
+
+	m_keys.push_back(*key);
+	m_values.push_back(0);
+
+	m_buckets[bucket]=entry;
+	m_generations[bucket]=m_generation;
+
+	return entry;
+}
+
+void KmerScratchTable::grow(){
+	int buckets=2*m_buckets.size();
+
+	m_buckets.assign(buckets,KMER_SCRATCH_TABLE_NONE);
+	m_generations.assign(buckets,0);
+	m_generation=1;
+
+	for(int entry=0;entry<size();entry++){
+		int bucket=findBucket(&(m_keys[entry]));
+
+		m_buckets[bucket]=entry;
+		m_generations[bucket]=m_generation;
+	}
+
+	#ifdef ASSERT
+	assert(2*size()<=(int)m_buckets.size());
+	#endif
+}
+
+void KmerScratchTable::set(Kmer*key,int value){
+	m_values[insert(key)]=value;
+}
+
+int KmerScratchTable::get(Kmer*key){
+	int entry=find(key);
+
+	if(entry==KMER_SCRATCH_TABLE_NONE)
+		return 0;
+
+	return m_values[entry];
+}
+
+Kmer*KmerScratchTable::getKey(int entry){
+	#ifdef ASSERT
+	assert(entry>=0 && entry<size());
+	#endif
+
+	return &(m_keys[entry]);
+}
+
+int KmerScratchTable::getValue(int entry){
+	#ifdef ASSERT
+	assert(entry>=0 && entry<size());
+	#endif
+
+	return m_values[entry];
+}
+
+void KmerScratchTable::setValue(int entry,int value){
+	#ifdef ASSERT
+	assert(entry>=0 && entry<size());
+	#endif
+
+	m_values[entry]=value;
+}
@@ -0,0 +1,89 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).  
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#ifndef _KmerScratchTable_h
+#define _KmerScratchTable_h
+
+#include <plugin_KmerAcademyBuilder/Kmer.h>
+
+#include <vector>
+#include <stdint.h> /** for uint32_t **/
+using namespace std;
+
+/** a search visits at most MAX_VERTICES_TO_VISIT vertices, so this
+ * keeps the load below 1/2 in most cases **/
+#define KMER_SCRATCH_TABLE_INITIAL_BUCKETS 1024
+
+#define KMER_SCRATCH_TABLE_NONE -1
+
+/**
+ * A small table from k-mers to integers that is re-used by every search.
+ *
+ * Buckets use open addressing with linear probing. A bucket is occupied
+ * only if its generation is the current generation, so clear() is O(1)
+ * and the memory is kept from one search to the next.
+ *
+ * Entries are numbered 0, 1, 2, ... in insertion order, and these
+ * numbers can be used as indices in other arrays.
+ *
+ * \author Sébastien Boisvert
+ */
+class KmerScratchTable{
+
+/** entry stored in each bucket **/
+	vector<int> m_buckets;
+	vector<uint32_t> m_generations;
+	uint32_t m_generation;
+
+/** entries in insertion order **/
+	vector<Kmer> m_keys;
+	vector<int> m_values;
+
+	int findBucket(Kmer*key);
+	void grow();
+
+public:
+
+	KmerScratchTable();
+
+/** forget every entry **/
+	void clear();
+
+	int size();
+
+/** returns the entry of the key or KMER_SCRATCH_TABLE_NONE **/
+	int find(Kmer*key);
+	bool contains(Kmer*key);
+
+/** returns the entry of the key, a new entry has the value 0 **/
+	int insert(Kmer*key);
+
+	void set(Kmer*key,int value);
+
+/** returns 0 if the key is not there **/
+	int get(Kmer*key);
+
+	Kmer*getKey(int entry);
+	int getValue(int entry);
+	void setValue(int entry,int value);
+};
+
+#endif
@@ -22,23 +22,103 @@
 #include <math.h>
 #include <plugin_SeedExtender/NovaEngine.h>
 #include <assert.h>
+#include <algorithm>
+#include <iostream>
+using namespace std;
+
+void NovaEngine::clear(int choices){
+	#ifdef ASSERT
+	assert(choices<=MAXIMUM_NUMBER_OF_CHOICES);
+	#endif
+
+	m_choices=choices;
+
+	for(int i=0;i<MAXIMUM_NUMBER_OF_CHOICES;i++)
+		m_distances[i].clear();
+}
+
+void NovaEngine::addDistance(int choice,int distance){
+	m_distances[choice].push_back(distance);
+}
+
+/** the distances are sorted */
+int NovaEngine::getNumberOfDistinctDistances(int choice){
+	vector<int>*distances=m_distances+choice;
+	int count=0;
+
+	for(int i=0;i<(int)distances->size();i++){
+		if(i==0 || (*distances)[i]!=(*distances)[i-1])
+			count++;
+	}
+
+	return count;
+}
+
+int NovaEngine::getNumberOfBins(int choice,int step){
+	vector<int>*distances=m_distances+choice;
+	int count=0;
+
+	for(int i=0;i<(int)distances->size();i++){
+		if(i==0 || (*distances)[i]/step!=(*distances)[i-1]/step)
+			count++;
+	}
+
+	return count;
+}
+
+void NovaEngine::showDistances(int choice){
+	vector<int>*distances=m_distances+choice;
+
+	// largest distances first, with their number of reads
+	int i=distances->size()-1;
+	while(i>=0){
+		int distance=(*distances)[i];
+		int weight=0;
+		while(i>=0 && (*distances)[i]==distance){
+			weight++;
+			i--;
+		}
+		cout<<" "<<distance<<" "<<weight<<"";
+	}
+	cout<<endl;
+}
 
 /**
  * The implementation of this method is test-driven.
  * It tries to generalize a lot of cases
  */
-int NovaEngine::choose(vector<map<int,int> >*distances,set<int>*invalidChoices,bool show){
-	vector<double> novaScores;
-	int choices=distances->size();
+int NovaEngine::choose(uint32_t invalidChoices,bool show){
+	int choices=m_choices;
+
+	int entries[MAXIMUM_NUMBER_OF_CHOICES];
+	int maximumValues[MAXIMUM_NUMBER_OF_CHOICES];
+	int novaScores[MAXIMUM_NUMBER_OF_CHOICES];
 
 	int withElements=0;
 	int initialChoice=0;
+	int theMaximum=0;
+	bool allHaveAtLeast2=true;
+
 	for(int i=0;i<choices;i++){
-		int n=distances->at(i).size();
-		if(n>0){
+		sort(m_distances[i].begin(),m_distances[i].end());
+
+		entries[i]=getNumberOfDistinctDistances(i);
+
+		if(entries[i]>0){
 			withElements++;
 			initialChoice=i;
 		}
+
+		if(entries[i] < 2)
+			allHaveAtLeast2=false;
+
+		int maximumValue=0;
+		if(entries[i]>0 && m_distances[i].back()>maximumValue)
+			maximumValue=m_distances[i].back();
+
+		maximumValues[i]=maximumValue;
+		if(maximumValue>theMaximum)
+			theMaximum=maximumValue;
 	}
 	
 	if(withElements==1)
@@ -52,45 +132,22 @@ int NovaEngine::choose(vector<map<int,int> >*distances,set<int>*invalidChoices,b
 		cout<<"Choices: "<<choices<<endl;
 	}
 
-	vector<int> maximumValues;
-	int theMaximum=0;
-	for(int i=0;i<choices;i++){
-		int maximumValue=0;
-		for(map<int,int>::iterator j=distances->at(i).begin();j!=distances->at(i).end();j++){
-			int distance=j->first;
-			if(distance>maximumValue)
-				maximumValue=distance;
-		}
-		maximumValues.push_back(maximumValue);
-		if(maximumValue>theMaximum)
-			theMaximum=maximumValue;
-	}
-
-	bool allHaveAtLeast2=true;
-
-	for(int i=0;i<choices;i++){
-		int numberOfEntriesForI=distances->at(i).size();
-	
-		if(numberOfEntriesForI < 2)
-			allHaveAtLeast2=false;
-	}
-
 	/** choose with the maximum value, if possible */
 	double multiplicator=1.4;
 	for(int i=0;i<choices;i++){
 		bool win=true;
 
-		int numberOfEntriesForI=distances->at(i).size();
+		int numberOfEntriesForI=entries[i];
 	
 		/* an invalid choice can not win */
-		if(invalidChoices->count(i)>0)
+		if(invalidChoices&(1<<i))
 			continue;
 
 		for(int j=0;j<choices;j++){
 			if(i==j)
 				continue;
 
-			int numberOfEntriesForJ=distances->at(j).size();
+			int numberOfEntriesForJ=entries[j];
 
 			/* probably a sequencing error */
 			if((numberOfEntriesForJ >= numberOfEntriesForI && numberOfEntriesForI == 1)
@@ -100,7 +157,7 @@ int NovaEngine::choose(vector<map<int,int> >*distances,set<int>*invalidChoices,b
 			}
 
 			/* an invalid choice does not need to be tested against */
-			if(invalidChoices->count(j)>0)
+			if(invalidChoices&(1<<j))
 				continue;
 
 			if(multiplicator*maximumValues[j] >= maximumValues[i]){
@@ -112,68 +169,43 @@ int NovaEngine::choose(vector<map<int,int> >*distances,set<int>*invalidChoices,b
 			return i;
 	}
 
-	for(int i=0;i<choices;i++){
-		int n=distances->at(i).size();
-		vector<int> observedDistances;
-		vector<int> weights;
-		int totalWeight=0;
-		for(map<int,int>::reverse_iterator j=distances->at(i).rbegin(); j!=distances->at(i).rend();j++){
-			observedDistances.push_back(j->first);
-			weights.push_back(j->second);
-			totalWeight+=j->second;
-		}
-
-		double score=0;
-		map<int,int> coverage;
+	/** change the number of bins depending on the range of values */
+	int step=32;
 
-		/** change the number of bins depending on the range of values */
-		int step=32;
+	if(allHaveAtLeast2)
+		step=128;
 
-		if(allHaveAtLeast2)
-			step=128;
+	if(theMaximum> 2048 && allHaveAtLeast2)
+		step=256;
 
-		if(theMaximum> 2048 && allHaveAtLeast2)
-			step=256;
+	if(theMaximum>8192 && allHaveAtLeast2)
+		step=512;
 
-		if(theMaximum>8192 && allHaveAtLeast2)
-			step=512;
-
-		for(int j=0;j<n;j++){
-			int distance=observedDistances[j];
-			int weight=weights[j];
-			coverage[distance/step]+=weight;
-		}
-
-		for(map<int,int>::iterator j=coverage.begin();j!=coverage.end();j++){
-			score++;
-		}
+	for(int i=0;i<choices;i++){
+		novaScores[i]=getNumberOfBins(i,step);
 
 		if(show){
 			cout<<"step= "<<step<<endl;
 		
 			cout<<"Choice: "<<i+1<<endl;
-			cout<<" DataPoints: "<<n<<endl;
-			for(int j=0;j<n;j++){
-				cout<<" "<<observedDistances[j]<<" "<<weights[j]<<"";
-			}
-			cout<<endl;
-			cout<<" NovaScore: "<<score<<endl;
+			cout<<" DataPoints: "<<entries[i]<<endl;
+			showDistances(i);
+			cout<<" NovaScore: "<<novaScores[i]<<endl;
 		}
-		novaScores.push_back(score);
 	}
 
 	int selection=IMPOSSIBLE_CHOICE;
 	for(int i=0;i<choices;i++){
 		bool winner=true;
 		
-		if(invalidChoices->count(i) > 0)
+		if(invalidChoices&(1<<i))
 			continue;
 
 		for(int j=0;j<choices;j++){
 			if(i==j)
 				continue;
 
-			if(invalidChoices->count(j)>0)
+			if(invalidChoices&(1<<j))
 				continue;
 
 			if(maximumValues[i]>=maximumValues[j]*100)
@@ -201,4 +233,3 @@ int NovaEngine::choose(vector<map<int,int> >*distances,set<int>*invalidChoices,b
 
 	return selection;
 }
-
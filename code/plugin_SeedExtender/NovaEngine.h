@@ -24,18 +24,33 @@
 
 #include <vector>
 #include <plugin_SeedExtender/Chooser.h>
-#include <map>
-#include <set>
+#include <plugin_SeedExtender/ChoiceTable.h>
+#include <stdint.h>
 using namespace std;
 
 /** This the new Ray NovaEngine(*) 
  *NovaEngine decides where to go in the k-mer graph
+ *
+ * The distances of each choice are in a flat array that is sorted
+ * once, so the number of distinct distances, the maximum distance
+ * and the number of occupied bins are obtained by scanning it.
+ * The arrays are kept between calls so that choosing allocates
+ * no memory once they are large enough.
  * \author Sébastien Boisvert
  */
 class NovaEngine{
+	vector<int> m_distances[MAXIMUM_NUMBER_OF_CHOICES];
+	int m_choices;
+
+	int getNumberOfDistinctDistances(int choice);
+	int getNumberOfBins(int choice,int step);
+	void showDistances(int choice);
 public:
-	/** choose where to go */
-	int choose(vector<map<int,int> >*distances,set<int>*invalidChoices,bool show);
+	void clear(int choices);
+	void addDistance(int choice,int distance);
+
+	/** choose where to go, bit i of invalidChoices is set if choice i is invalid */
+	int choose(uint32_t invalidChoices,bool show);
 };
 
 #endif
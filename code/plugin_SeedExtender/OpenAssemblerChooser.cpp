@@ -34,146 +34,96 @@ void OpenAssemblerChooser::constructor(){
 int OpenAssemblerChooser::choose(ExtensionData*ed,Chooser*m_c,int minimumCoverage,
 Parameters*parameters){
 
-	/** filter invalid choices */
-	set<int> invalidChoices;
-	for(int i=0;i<(int)ed->m_enumerateChoices_outgoingEdges.size();i++){
-		int coverageForI=ed->m_EXTENSION_coverages.at(i);
-		Kmer key=ed->m_enumerateChoices_outgoingEdges[i];
+	ChoiceTable table;
+	table.constructor(ed);
+
+	int choices=table.getNumberOfChoices();
+
+	/** filter invalid choices, bit i is set if choice i is invalid */
+	uint32_t invalidChoices=0;
+	for(int i=0;i<choices;i++){
+		int coverageForI=table.getCoverage(i);
 
 		/** an invalid choice must not have paired reads */
 		/** an invalid choice must not have single reads */
-		if(ed->m_EXTENSION_pairedReadPositionsForVertices[key].size()==0 && ed->m_EXTENSION_readPositionsForVertices[key].size()==0){
-			invalidChoices.insert(i);
+		if(table.getNumberOfPairedReads(i)==0 && table.getNumberOfSingleEndReads(i)==0){
+			invalidChoices|=(1<<i);
 			continue;
 		}
 
-		/* invalid if < minCoverage and all others >= 2*minCoverage */
-
-		if(coverageForI<minimumCoverage){
-			bool invalid=true;
-			for(int j=0;j<(int)ed->m_enumerateChoices_outgoingEdges.size();j++){
-				if(i==j)
-					continue;
-				int coverageForJ=ed->m_EXTENSION_coverages.at(j);
-				if(coverageForJ<2*minimumCoverage){
-					invalid=false;
-					break;
-				}
-			}
-			if(invalid){
-				invalidChoices.insert(i);
+		/** the lowest coverage among the other choices */
+		int lowestOtherCoverage=0;
+		bool hasOther=false;
+		for(int j=0;j<choices;j++){
+			if(i==j)
 				continue;
-			}
+			if(!hasOther || table.getCoverage(j)<lowestOtherCoverage)
+				lowestOtherCoverage=table.getCoverage(j);
+			hasOther=true;
+		}
+
+		/* invalid if < minCoverage and all others >= 2*minCoverage */
+		if(coverageForI<minimumCoverage && (!hasOther || lowestOtherCoverage>=2*minimumCoverage)){
+			invalidChoices|=(1<<i);
+			continue;
 		}
 
 		/* invalid if < minCoverage/2 and all others >= minCoverage */
-		if(coverageForI<minimumCoverage/2){
-			bool invalid=true;
-			for(int j=0;j<(int)ed->m_enumerateChoices_outgoingEdges.size();j++){
-				if(i==j)
-					continue;
-				int coverageForJ=ed->m_EXTENSION_coverages.at(j);
-				if(coverageForJ<minimumCoverage){
-					invalid=false;
-					break;
-				}
-			}
-			if(invalid){
-				invalidChoices.insert(i);
-				continue;
-			}
+		if(coverageForI<minimumCoverage/2 && (!hasOther || lowestOtherCoverage>=minimumCoverage)){
+			invalidChoices|=(1<<i);
+			continue;
 		}
 
 		/* invalid if == 2 and all other are >= 10 */
-		if(coverageForI == 2){
-			bool invalid=true;
-			for(int j=0;j<(int)ed->m_enumerateChoices_outgoingEdges.size();j++){
-				if(i==j)
-					continue;
-				int coverageForJ=ed->m_EXTENSION_coverages.at(j);
-				if(coverageForJ<10){
-					invalid=false;
-					break;
-				}
-			}
-			if(invalid){
-				invalidChoices.insert(i);
-				continue;
-			}
+		if(coverageForI == 2 && (!hasOther || lowestOtherCoverage>=10)){
+			invalidChoices|=(1<<i);
+			continue;
 		}
-
-
-	}
-
-	/** make a list of battle victories for each choice */
-
-	vector<set<int> > battleVictories;
-
-	for(int i=0;i<(int)ed->m_enumerateChoices_outgoingEdges.size();i++){
-		set<int> victories;
-		battleVictories.push_back(victories);
 	}
 
-	chooseWithCoverage(ed,minimumCoverage,&battleVictories);
+	table.addCoverageVictories(minimumCoverage);
 
-	int coverageWinner=getWinner(&battleVictories,ed->m_enumerateChoices_outgoingEdges.size());
+	int coverageWinner=table.getWinner();
 
-	if(coverageWinner!=IMPOSSIBLE_CHOICE && invalidChoices.count(coverageWinner) == 0)
+	if(coverageWinner!=IMPOSSIBLE_CHOICE && !(invalidChoices&(1<<coverageWinner)))
 		return coverageWinner;
 
 		
 	int withPairedInformation=0;
-	/** prepare data for the NovaEngine */
-	vector<map<int,int> > novaData;
-	for(int i=0;i<(int)ed->m_enumerateChoices_outgoingEdges.size();i++){
-		Kmer key=ed->m_enumerateChoices_outgoingEdges[i];
-		map<int,int> data;
-
-		/** load single-end data */
-/*
-		if(ed->m_EXTENSION_readPositionsForVertices.count(key)>0){
-			for(vector<int>::iterator j=ed->m_EXTENSION_readPositionsForVertices[key].begin();
-				j!=ed->m_EXTENSION_readPositionsForVertices[key].end();j++){
-				int val=*j;
-				data[val]++;
-			}
-		}
-*/
-		/** load paired-end data and mate-pair data */
-		if(ed->m_EXTENSION_pairedReadPositionsForVertices.count(key)>0){
-			for(int j=0;j<(int)ed->m_EXTENSION_pairedReadPositionsForVertices[key].size();j++){
-				if(j==0)
-					withPairedInformation++;
-				int value=ed->m_EXTENSION_pairedReadPositionsForVertices[key][j];
-				data[value]++;
-			}
-		}
-
-		novaData.push_back(data);
+	for(int i=0;i<choices;i++){
+		if(table.getNumberOfPairedReads(i)>0)
+			withPairedInformation++;
 	}
 
-	int novaChoice=IMPOSSIBLE_CHOICE;
 	/** this is the powerful NovaEngine -- an assembly engine to surf de Bruijn DNA graphs */
 	if(parameters->hasOption("-use-NovaEngine") && withPairedInformation>0){
+
+		/** load paired-end data and mate-pair data */
+		m_novaEngine.clear(choices);
+		for(int i=0;i<choices;i++){
+			Kmer key=ed->m_enumerateChoices_outgoingEdges[i];
+			map<Kmer,vector<int> >::iterator paired=ed->m_EXTENSION_pairedReadPositionsForVertices.find(key);
+			if(paired==ed->m_EXTENSION_pairedReadPositionsForVertices.end())
+				continue;
+
+			for(int j=0;j<(int)paired->second.size();j++)
+				m_novaEngine.addDistance(i,paired->second[j]);
+		}
+
 		/** NovaData are ready, now call the NovaEngine */
 		bool showNovaAlgorithm=parameters->hasOption("-show-NovaEngine");
-		novaChoice=m_novaEngine.choose(&novaData,&invalidChoices,showNovaAlgorithm);
+		int novaChoice=m_novaEngine.choose(invalidChoices,showNovaAlgorithm);
 
 		if(novaChoice!=IMPOSSIBLE_CHOICE)
 			return novaChoice;
 	}
 
 
-	m_c->chooseWithPairedReads(ed,m_pairedEndMultiplicator,&battleVictories,parameters);
+	m_c->chooseWithPairedReads(&table,m_pairedEndMultiplicator);
 	
-	int pairedChoice=getWinner(&battleVictories,ed->m_enumerateChoices_outgoingEdges.size());
-
-	battleVictories.clear();
+	int pairedChoice=table.getWinner();
 
-	for(int i=0;i<(int)ed->m_enumerateChoices_outgoingEdges.size();i++){
-		set<int> victories;
-		battleVictories.push_back(victories);
-	}
+	table.clearVictories();
 
 	if(pairedChoice!=IMPOSSIBLE_CHOICE){
 		return pairedChoice;
@@ -186,101 +136,15 @@ Parameters*parameters){
 		}
 
 		// if both have paired reads and that is not enough for one of them to win, then abort
-		int withPairedReads=0;
-		
-		for(int j=0;j<(int)ed->m_enumerateChoices_outgoingEdges.size();j++){
-			Kmer key=ed->m_enumerateChoices_outgoingEdges[j];
-			if(ed->m_EXTENSION_pairedReadPositionsForVertices[key].size()>0){
-				withPairedReads++;
-			}
-		}
-		if(withPairedReads!=0){
-			return IMPOSSIBLE_CHOICE;
-		}
-	}
-
-	map<int,int> CHOOSER_theMaxs;
-	map<int,int> CHOOSER_theNumbers;
-	map<int,int> CHOOSER_theSums;
-
-	for(int i=0;i<(int)ed->m_enumerateChoices_outgoingEdges.size();i++){
-		Kmer key=ed->m_enumerateChoices_outgoingEdges[i];
-		int max=0;
-		int n=0;
-		int sum=0;
-		if(ed->m_EXTENSION_readPositionsForVertices.count(key)>0){
-			for(vector<int>::iterator j=ed->m_EXTENSION_readPositionsForVertices[key].begin();
-				j!=ed->m_EXTENSION_readPositionsForVertices[key].end();j++){
-				int val=*j;
-				if(val>max){
-					max=val;
-				}
-				n++;
-				sum+=val;
+		for(int j=0;j<choices;j++){
+			if(table.getNumberOfPairedReads(j)>0){
+				return IMPOSSIBLE_CHOICE;
 			}
 		}
-		CHOOSER_theSums[i]=sum;
-		CHOOSER_theNumbers[i]=n;
-		CHOOSER_theMaxs[i]=max;
 	}
 
 	// win or lose with single-end reads
-	for(int i=0;i<(int)ed->m_enumerateChoices_outgoingEdges.size();i++){
-		if(CHOOSER_theMaxs[i]<5){
-			continue;
-		}
-
-		for(int j=0;j<(int)ed->m_enumerateChoices_outgoingEdges.size();j++){
-			if((CHOOSER_theMaxs[i] > m_singleEndMultiplicator*CHOOSER_theMaxs[j]) 
-				&& (CHOOSER_theSums[i] > m_singleEndMultiplicator*CHOOSER_theSums[j]) 
-				&& (CHOOSER_theNumbers[i] > m_singleEndMultiplicator*CHOOSER_theNumbers[j])
-				){
-				battleVictories[i].insert(j);
-			}
-		}
-	}
-
-	int finalWinner=getWinner(&battleVictories,ed->m_enumerateChoices_outgoingEdges.size());
-
-	if(finalWinner!=IMPOSSIBLE_CHOICE){
-		return finalWinner;
-	}
+	table.addSingleEndVictories(m_singleEndMultiplicator);
 
-	return IMPOSSIBLE_CHOICE;
+	return table.getWinner();
 }
-
-
-int OpenAssemblerChooser::getWinner(vector<set<int> >*battleVictories,int choices){
-	for(int winner=0;winner<(int)battleVictories->size();winner++){
-		int wins=battleVictories->at(winner).size();
-		if(wins+1==choices){
-			return winner;
-		}
-	}
-	return IMPOSSIBLE_CHOICE;
-}
-
-void OpenAssemblerChooser::chooseWithCoverage(ExtensionData*ed,int minCoverage,vector<set<int> >*battleVictories){
-	for(int i=0;i<(int)ed->m_enumerateChoices_outgoingEdges.size();i++){
-
-		int coverageForI=ed->m_EXTENSION_coverages.at(i);
-		Kmer key=ed->m_enumerateChoices_outgoingEdges[i];
-
-		for(int j=0;j<(int)ed->m_enumerateChoices_outgoingEdges.size();j++){
-			if(i==j){
-				continue;
-			}
-			int coverageForJ=ed->m_EXTENSION_coverages.at(j);
-
-			if(coverageForI>=2*minCoverage && coverageForJ<=minCoverage/2){
-				(*battleVictories)[i].insert(j);
-			}
-
-			if(coverageForI>=minCoverage && coverageForJ<=minCoverage/2){
-				(*battleVictories)[i].insert(j);
-			}
-		}
-	}
-}
-
-
@@ -24,6 +24,7 @@
 
 #include <plugin_SeedExtender/Chooser.h> // for IMPOSSIBLE_CHOICE
 #include <plugin_SeedExtender/NovaEngine.h>
+#include <plugin_SeedExtender/ChoiceTable.h>
 
 /**
  * de Bruijn heuristic to choose extension direction in a graph, described in paper 
@@ -42,13 +43,6 @@ class OpenAssemblerChooser{
 	double m_singleEndMultiplicator;
 	double m_pairedEndMultiplicator;
 	void updateMultiplicators();
-
-	int getWinner(vector<set<int> >*battleVictories,int choices);
-	
-	/**
- * choose where to go based on coverage
- */
-	void chooseWithCoverage(ExtensionData*ed,int minCoverage,vector<set<int> >*battleVictories);
 public:
 	int choose(ExtensionData*m_ed,Chooser*m_c,int m_minimumCoverage,
 	Parameters*parameters);
@@ -0,0 +1,108 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#include <plugin_SeedExtender/PathScreener.h>
+#include <application_core/constants.h>
+
+void PathScreener::constructor(ContigPath*path,bool reverseStrand,WorkerHandle workerIdentifier,
+		VirtualCommunicator*virtualCommunicator,Parameters*parameters,RingAllocator*outboxAllocator,
+		MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE){
+
+	this->RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE=RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
+
+	m_path=path;
+	m_reverseStrand=reverseStrand;
+	m_workerIdentifier=workerIdentifier;
+	m_virtualCommunicator=virtualCommunicator;
+	m_parameters=parameters;
+	m_outboxAllocator=outboxAllocator;
+
+	m_iterator=0;
+	m_requested=false;
+	m_done=true;
+	m_sharesNoVertex=false;
+	m_sawOtherPaths=false;
+	m_positions.clear();
+
+	if(m_path->size()>=PATH_SCREENING_MINIMUM_LENGTH){
+		m_path->getMinimizerPositions(PATH_SCREENING_WINDOW,&m_positions);
+		m_done=false;
+	}
+}
+
+void PathScreener::work(){
+	if(m_done)
+		return;
+
+	if(m_iterator==(int)m_positions.size()){
+		m_done=true;
+		m_sharesNoVertex=true;
+
+	}else if(!m_requested){
+		Kmer kmer=m_path->at(m_positions[m_iterator]);
+
+		if(m_reverseStrand)
+			kmer=kmer.complementVertex(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
+
+		Rank destination=m_parameters->_vertexRank(&kmer);
+		int elementsPerQuery=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
+		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elementsPerQuery);
+		int outputPosition=0;
+		kmer.pack(message,&outputPosition);
+		Message aMessage(message,elementsPerQuery,destination,
+			RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE,m_parameters->getRank());
+		m_virtualCommunicator->pushMessage(m_workerIdentifier,&aMessage);
+
+		m_requested=true;
+
+	}else if(m_virtualCommunicator->isMessageProcessed(m_workerIdentifier)){
+		vector<MessageUnit> response;
+		m_virtualCommunicator->getMessageResponseElements(m_workerIdentifier,&response);
+		int numberOfPaths=response[0];
+
+		m_requested=false;
+		m_iterator++;
+
+		/* directions are stored by strand, so the path itself is
+ * counted only when its forward strand is queried */
+		int otherPaths=numberOfPaths;
+		if(!m_reverseStrand)
+			otherPaths--;
+
+		if(otherPaths>0)
+			m_sawOtherPaths=true;
+
+		if(otherPaths>0 && numberOfPaths<=MAXIMUM_PATHS_PER_FUSION_VERTEX)
+			m_done=true;
+	}
+}
+
+bool PathScreener::isDone(){
+	return m_done;
+}
+
+bool PathScreener::sharesNoVertex(){
+	return m_sharesNoVertex;
+}
+
+bool PathScreener::sawOtherPaths(){
+	return m_sawOtherPaths;
+}
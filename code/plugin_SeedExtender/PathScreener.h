@@ -0,0 +1,81 @@
+/*
+ 	Ray
+    Copyright (C) 2010, 2011, 2012 Sébastien Boisvert
+
+	http://DeNovoAssembler.SourceForge.Net/
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, version 3 of the License.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You have received a copy of the GNU General Public License
+    along with this program (gpl-3.0.txt).
+	see <http://www.gnu.org/licenses/>
+
+*/
+
+#ifndef _PathScreener_h
+#define _PathScreener_h
+
+#include <plugin_SeedExtender/ContigPath.h>
+#include <communication/VirtualCommunicator.h>
+#include <memory/RingAllocator.h>
+#include <application_core/Parameters.h>
+
+#include <vector>
+using namespace std;
+
+/**
+ * Query the number of paths at the minimizer positions of a path.
+ *
+ * Any run of PATH_SCREENING_WINDOW positions shared with another path
+ * contains one of them, so a path without such a position has nothing
+ * to fuse or join with and the walk on all its vertices can be skipped.
+ *
+ * Used by FusionWorker and JoinerWorker before their walks.
+ *
+ * \author Sébastien Boisvert
+ */
+class PathScreener{
+
+	MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE;
+
+	ContigPath*m_path;
+	bool m_reverseStrand;
+	WorkerHandle m_workerIdentifier;
+	VirtualCommunicator*m_virtualCommunicator;
+	Parameters*m_parameters;
+	RingAllocator*m_outboxAllocator;
+
+	vector<int> m_positions;
+	int m_iterator;
+	bool m_requested;
+	bool m_done;
+	bool m_sharesNoVertex;
+	bool m_sawOtherPaths;
+
+public:
+
+/** short paths are not screened, isDone() is then true right away **/
+	void constructor(ContigPath*path,bool reverseStrand,WorkerHandle workerIdentifier,
+		VirtualCommunicator*virtualCommunicator,Parameters*parameters,RingAllocator*outboxAllocator,
+		MessageTag RAY_MPI_TAG_ASK_VERTEX_PATHS_SIZE);
+
+/** send a query or receive its reply **/
+	void work();
+
+	bool isDone();
+
+/** no sampled vertex is on another path, the walk is not needed **/
+	bool sharesNoVertex();
+
+/** another path was seen at a queried vertex **/
+	bool sawOtherPaths();
+};
+
+#endif
@@ -29,6 +29,7 @@
 #define __PROGRESSION_PERIOD 1000
 
 #include <application_core/constants.h>
+#include <application_core/CheckpointFile.h>
 #include <string.h>
 #include <structures/StaticVector.h>
 #include <plugin_SeedExtender/TipWatchdog.h>
@@ -218,6 +219,13 @@ bool*vertexCoverageReceived,int size,int*receivedVertexCoverage,Chooser*chooser,
 				assert((CoverageDepth)(*receivedVertexCoverage)<=m_parameters->getMaximumAllowedCoverage());
 				#endif
 
+			}else if(!(*vertexCoverageRequested)
+				&&m_subgraph->isLocalQuery(m_parameters->_vertexRank(&kmer))){
+				// the vertex is on this rank, no message is needed
+				(*vertexCoverageRequested)=true;
+				(*vertexCoverageReceived)=true;
+				(*receivedVertexCoverage)=m_subgraph->getLocalCoverage(&kmer);
+
 			}else if(!(*vertexCoverageRequested)){
 				MessageUnit*message=(MessageUnit*)(*outboxAllocator).allocate(KMER_U64_ARRAY_SIZE*sizeof(MessageUnit));
 				int bufferPosition=0;
@@ -658,9 +666,8 @@ Presently, insertions or deletions up to 8 are supported.
 				m_dfsData->m_doChoice_tips_dfs_done=false;
 				m_dfsData->m_doChoice_tips_Initiated=true;
 				bubbleData->m_BUBBLE_visitedVertices.clear();
-				bubbleData->m_visitedVertices.clear();
 				bubbleData->m_coverages.clear();
-				bubbleData->m_coverages[(*currentVertex)]=ed->m_currentCoverage;
+				bubbleData->m_coverages.set(currentVertex,ed->m_currentCoverage);
 
 			}
 
@@ -672,9 +679,8 @@ Presently, insertions or deletions up to 8 are supported.
 					if(ed->m_enumerateChoices_outgoingEdges.size()==1){
 						m_dfsData->m_doChoice_tips_dfs_done=true;
 					}else{
-						m_dfsData->depthFirstSearch((*currentVertex),ed->m_enumerateChoices_outgoingEdges[m_dfsData->m_doChoice_tips_i],maxDepth,edgesRequested,vertexCoverageRequested,vertexCoverageReceived,outboxAllocator,
-size,theRank,outbox,receivedVertexCoverage,receivedOutgoingEdges,minimumCoverage,edgesReceived,wordSize,
-	m_parameters);
+						m_dfsData->depthFirstSearch((*currentVertex),ed->m_enumerateChoices_outgoingEdges[m_dfsData->m_doChoice_tips_i],maxDepth,edgesRequested,vertexCoverageRequested,outboxAllocator,
+theRank,outbox,m_seedingData,m_parameters);
 					}
 				}else{
 					#ifdef ASSERT
@@ -683,12 +689,11 @@ size,theRank,outbox,receivedVertexCoverage,receivedOutgoingEdges,minimumCoverage
 
 					// store visited vertices for bubble detection purposes.
 					bubbleData->m_BUBBLE_visitedVertices.push_back(m_dfsData->m_depthFirstSearchVisitedVertices_vector);
-					for(map<Kmer,int>::iterator i=m_dfsData->m_coverages.begin();
-						i!=m_dfsData->m_coverages.end();i++){
-						bubbleData->m_coverages[i->first]=i->second;
+					for(int i=0;i<m_dfsData->m_coverages.size();i++){
+						bubbleData->m_coverages.set(m_dfsData->m_coverages.getKey(i),
+							m_dfsData->m_coverages.getValue(i));
 					}
 
-					bubbleData->m_visitedVertices.push_back(m_dfsData->m_depthFirstSearchVisitedVertices);
 					// keep the edge if it is not a tip.
 					if(m_dfsData->m_depthFirstSearch_maxDepth>=TIP_LIMIT){
 						m_dfsData->m_doChoice_tips_newEdges.push_back(m_dfsData->m_doChoice_tips_i);
@@ -894,7 +899,7 @@ size,theRank,outbox,receivedVertexCoverage,receivedOutgoingEdges,minimumCoverage
 }
 
 void SeedExtender::printTree(Kmer root,
-map<Kmer,set<Kmer> >*arcs,map<Kmer,int>*coverages,int depth,set<Kmer>*visited){
+map<Kmer,set<Kmer> >*arcs,KmerScratchTable*coverages,int depth,set<Kmer>*visited){
 	if(arcs->count(root)==0)
 		return;
 	if(visited->count(root)>0)
@@ -907,15 +912,15 @@ map<Kmer,set<Kmer> >*arcs,map<Kmer,int>*coverages,int depth,set<Kmer>*visited){
 		Kmer child=*i;
 		string s=child.idToWord(m_parameters->getWordSize(),m_parameters->getColorSpaceMode());
 		#ifdef ASSERT
-		assert(coverages->count(*i)>0);
+		assert(coverages->contains(&child));
 		#endif
-		int coverage=(*coverages)[*i];
+		int coverage=coverages->get(&child);
 		#ifdef ASSERT
 		assert(coverages>0);
 		#endif
 		printf("%s coverage: %i depth: %i\n",s.c_str(),coverage,depth);
 
-		if(coverages->count(*i)==0||coverage==0){
+		if(!coverages->contains(&child)||coverage==0){
 			cout<<"Error: "<<child.idToWord(m_parameters->getWordSize(),m_parameters->getColorSpaceMode())<<" don't have a coverage value"<<endl;
 		}
 
@@ -938,7 +943,8 @@ Kmer *currentVertex,BubbleData*bubbleData){
 		if(!m_slicedComputationStarted){
 			m_slicedComputationStarted = true;
 			m_slicedProgression = 0;
-			vector<Kmer> emptyOne;
+			ContigPath emptyOne;
+			emptyOne.setKmerLength(m_parameters->getWordSize());
 			ed->m_EXTENSION_contigs.push_back(emptyOne);
 
 			MACRO_COLLECT_PROFILING_INFORMATION();
@@ -951,14 +957,14 @@ Kmer *currentVertex,BubbleData*bubbleData){
 
 		// this hunk needs to be time-sliced...
 		if(m_slicedProgression < (int) ed->m_EXTENSION_extension.size()){
-			ed->m_EXTENSION_contigs[ed->m_EXTENSION_contigs.size()-1].push_back(ed->m_EXTENSION_extension[m_slicedProgression]);
+			ed->m_EXTENSION_contigs[ed->m_EXTENSION_contigs.size()-1].push_back(&(ed->m_EXTENSION_extension[m_slicedProgression]));
 			m_slicedProgression++;
 			return;
 		}
 
 		// the transfer is not completed yet!
 		// return immediately to yield a good granularity !
-		if(ed->m_EXTENSION_contigs[ed->m_EXTENSION_contigs.size()-1].size() < ed->m_EXTENSION_extension.size()){
+		if(ed->m_EXTENSION_contigs[ed->m_EXTENSION_contigs.size()-1].size() < (int)ed->m_EXTENSION_extension.size()){
 
 			MACRO_COLLECT_PROFILING_INFORMATION();
 			return;
@@ -1126,7 +1132,8 @@ void SeedExtender::checkIfCurrentVertexIsAssembled(ExtensionData*ed,StaticVector
 			MACRO_COLLECT_PROFILING_INFORMATION();
 			delete m_dfsData;
 			m_dfsData=new DepthFirstSearchData;
-			m_dfsData->setTags(RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,	RAY_MPI_TAG_REQUEST_VERTEX_EDGES,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES);
+			m_dfsData->setTags(RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,	RAY_MPI_TAG_REQUEST_VERTEX_EDGES,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,
+		RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES);
 
 			m_receivedDirections.clear();
 			if(ed->m_EXTENSION_currentSeedIndex%10==0 && ed->m_EXTENSION_currentPosition==0 
@@ -1801,7 +1808,8 @@ Chooser*chooser,OpenAssemblerChooser*oa
 	m_inbox=inbox;
 	m_subgraph=subgraph;
 	m_dfsData=new DepthFirstSearchData;
-	m_dfsData->setTags(RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,	RAY_MPI_TAG_REQUEST_VERTEX_EDGES,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES);
+	m_dfsData->setTags(RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,	RAY_MPI_TAG_REQUEST_VERTEX_EDGES,RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES,
+		RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES);
 	m_cache.constructor();
 	m_ed=ed;
 	this->m_directionsAllocator=m_directionsAllocator;
@@ -2022,24 +2030,20 @@ void SeedExtender::printExtensionStatus(Kmer*currentVertex){
 
 void SeedExtender::writeCheckpoint(){
 	cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint Extensions"<<endl;
-	ofstream f(m_parameters->getCheckpointFile("Extensions").c_str());
+	CheckpointWriter f(m_parameters,"Extensions");
 
 	int count=m_ed->m_EXTENSION_contigs.size();
 	f.write((char*)&count,sizeof(int));
 
 	for(int i=0;i<count;i++){
-		int length=m_ed->m_EXTENSION_contigs[i].size();
-		f.write((char*)&length,sizeof(int));
-		for(int j=0;j<length;j++){
-			m_ed->m_EXTENSION_contigs[i][j].write(&f);
-		}
+		m_ed->m_EXTENSION_contigs[i].write(&f);
 	}
 	f.close();
 }
 
 void SeedExtender::readCheckpoint(FusionData*fusionData){
 	cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint Extensions"<<endl;
-	ifstream f(m_parameters->getCheckpointFile("Extensions").c_str());
+	CheckpointReader f(m_parameters,"Extensions");
 
 	#ifdef ASSERT
 	assert(m_ed->m_EXTENSION_contigs.size()==0);
@@ -2049,17 +2053,11 @@ void SeedExtender::readCheckpoint(FusionData*fusionData){
 	f.read((char*)&count,sizeof(int));
 
 	for(int i=0;i<count;i++){
-		int length=0;
-		f.read((char*)&length,sizeof(int));
+		ContigPath extension;
+		extension.read(&f);
 		#ifdef ASSERT
-		assert(length>0);
+		assert(extension.size()>0);
 		#endif
-		vector<Kmer> extension;
-		for(int j=0;j<length;j++){
-			Kmer kmer;
-			kmer.read(&f);
-			extension.push_back(kmer);
-		}
 		m_ed->m_EXTENSION_contigs.push_back(extension);
 
 		/* add the identifier */
@@ -2307,6 +2305,8 @@ void SeedExtender::finalizeExtensions(vector<AssemblySeed>*seeds,FusionData*fusi
 
 	printf("Rank %i extended %i seeds out of %i (%.2f%%)\n",m_parameters->getRank(),
 		m_extended,(int)seeds->size(),ratio);
+
+	m_subgraph->printLocalQueries("extending seeds");
 	fflush(stdout);
 
 	MACRO_COLLECT_PROFILING_INFORMATION();
@@ -2536,6 +2536,7 @@ void SeedExtender::resolveSymbols(ComputeCore*core){
 	RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE");
 	RAY_MPI_TAG_REQUEST_VERTEX_EDGES=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_EDGES");
 	RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES");
+	RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES");
 
 	RAY_MPI_TAG_VERTEX_INFO=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_VERTEX_INFO");
 	RAY_MPI_TAG_VERTEX_INFO_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_VERTEX_INFO_REPLY");
@@ -79,6 +79,7 @@ class SeedExtender: public CorePlugin  {
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_EDGES;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_OUTGOING_EDGES;
+	MessageTag RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES;
 	MessageTag RAY_MPI_TAG_VERTEX_INFO;
 	MessageTag RAY_MPI_TAG_VERTEX_INFO_REPLY;
 	MessageTag RAY_MPI_TAG_VERTEX_READS;
@@ -172,7 +173,7 @@ class SeedExtender: public CorePlugin  {
 	void printExtensionStatus(Kmer*currentVertex);
 
 	void printTree(Kmer root,
-map<Kmer,set<Kmer> >*arcs,map<Kmer,int>*coverages,int depth,set<Kmer>*visited);
+map<Kmer,set<Kmer> >*arcs,KmerScratchTable*coverages,int depth,set<Kmer>*visited);
 
 	void readCheckpoint(FusionData*fusionData);
 	void writeCheckpoint();
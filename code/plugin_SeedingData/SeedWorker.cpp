@@ -35,25 +35,45 @@ void SeedWorker::work(){
 	if(m_finished){
 		return;
 	}
-	// check that this node has 1 ingoing edge and 1 outgoing edge.
-	if(!m_SEEDING_firstVertexTestDone){
+
+	// before seeding, only store the outcome of the test
+	if(m_linkOnly){
 		if(!m_SEEDING_1_1_test_done){
 			do_1_1_test();
 		}else{
-			if(!m_SEEDING_1_1_test_result){
-				m_finished=true;
-			}else{
-				m_SEEDING_firstVertexParentTestDone=false;
-				m_SEEDING_firstVertexTestDone=true;
-				m_SEEDING_currentVertex=m_SEEDING_currentParentVertex;
-				m_SEEDING_testInitiated=false;
-				m_SEEDING_1_1_test_done=false;
-			}
+			Vertex*node=m_subgraph->find(&m_SEEDING_currentVertex);
+
+			#ifdef ASSERT
+			assert(node!=NULL);
+			#endif
+
+			node->setUnitigLink(&m_SEEDING_currentVertex,m_SEEDING_1_1_test_result,
+				&m_SEEDING_currentParentVertex,&m_SEEDING_currentChildVertex,
+				m_wordSize,m_parameters->getColorSpaceMode());
+			m_finished=true;
+		}
+		return;
+	}
+
+	// check that this node has 1 ingoing edge and 1 outgoing edge.
+	// the vertex is local, so its unitig link is read directly.
+	if(!m_SEEDING_firstVertexTestDone){
+		Vertex*node=m_subgraph->find(&m_SEEDING_currentVertex);
+
+		if(node==NULL||!node->getUnitigLink(&m_SEEDING_currentVertex,&m_SEEDING_currentParentVertex,
+			&m_firstChildVertex,m_wordSize,m_parameters->getColorSpaceMode())){
+			m_finished=true;
+		}else{
+			m_cache[m_SEEDING_first]=node->getCoverage(&m_SEEDING_first);
+			m_SEEDING_firstVertexParentTestDone=false;
+			m_SEEDING_firstVertexTestDone=true;
+			m_SEEDING_currentVertex=m_SEEDING_currentParentVertex;
+			m_SEEDING_1_1_test_done=false;
 		}
 	// check that the parent does not have 1 ingoing edge and 1 outgoing edge
 	}else if(!m_SEEDING_firstVertexParentTestDone){
 		if(!m_SEEDING_1_1_test_done){
-			do_1_1_test();
+			fetchUnitigLink();
 		}else{
 			if(m_SEEDING_1_1_test_result){
 				m_finished=true;
@@ -61,9 +81,13 @@ void SeedWorker::work(){
 				m_SEEDING_firstVertexParentTestDone=true;
 				m_SEEDING_vertices.clear();
 				m_SEEDING_seed.clear();
-				// restore original starter.
-				m_SEEDING_currentVertex=m_SEEDING_first;
-				m_SEEDING_testInitiated=false;
+
+				// the first vertex already passed the test
+				m_SEEDING_seed.push_back(m_SEEDING_first);
+				m_coverages.push_back(m_cache[m_SEEDING_first]);
+				m_SEEDING_vertices.insert(m_SEEDING_first);
+
+				m_SEEDING_currentVertex=m_firstChildVertex;
 				m_SEEDING_1_1_test_done=false;
 			}
 		}
@@ -71,7 +95,7 @@ void SeedWorker::work(){
 	}else{
 		// attempt to add m_SEEDING_currentVertex
 		if(!m_SEEDING_1_1_test_done){
-			do_1_1_test();
+			fetchUnitigLink();
 		}else{
 			if(m_SEEDING_vertices.count(m_SEEDING_currentVertex)>0){// avoid infinite loops.
 				m_SEEDING_1_1_test_result=false;
@@ -80,15 +104,7 @@ void SeedWorker::work(){
 				m_finished=true;
 
 				if(m_parameters->debugSeeds()){
-					printf("Rank %i next vertex: Coverage= %i, ingoing coverages:",m_rank,m_cache[m_SEEDING_currentVertex]);
-					for(int i=0;i<(int)m_ingoingCoverages.size();i++){
-						printf(" %i",m_ingoingCoverages[i]);
-					}
-					printf(" outgoing coverages:");
-					for(int i=0;i<(int)m_outgoingCoverages.size();i++){
-						printf(" %i",m_outgoingCoverages[i]);
-					}
-					printf("\n");
+					printf("Rank %i next vertex: Coverage= %i\n",m_rank,m_cache[m_SEEDING_currentVertex]);
 
 					int n=100;
 					if((int)m_coverages.size()<n){
@@ -110,7 +126,6 @@ void SeedWorker::work(){
 					m_coverages.push_back(m_cache[m_SEEDING_currentVertex]);
 					m_SEEDING_vertices.insert(m_SEEDING_currentVertex);
 					m_SEEDING_currentVertex=m_SEEDING_currentChildVertex;
-					m_SEEDING_testInitiated=false;
 					m_SEEDING_1_1_test_done=false;
 				}
 			}
@@ -123,13 +138,17 @@ bool SeedWorker::isDone(){
 }
 
 void SeedWorker::constructor(Kmer*key,Parameters*parameters,RingAllocator*outboxAllocator,
-		VirtualCommunicator*virtualCommunicator,WorkerHandle workerId,
+		VirtualCommunicator*virtualCommunicator,WorkerHandle workerId,GridTable*subgraph,bool linkOnly,
 
-	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
-	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,
+	MessageTag RAY_MPI_TAG_GET_UNITIG_LINK
 ){
 	this->RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE=RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
-	this->RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT=RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
+	this->RAY_MPI_TAG_GET_UNITIG_LINK=RAY_MPI_TAG_GET_UNITIG_LINK;
+
+	m_subgraph=subgraph;
+	m_linkOnly=linkOnly;
+	m_unitigLinkRequested=false;
 
 	m_workerIdentifier=workerId;
 	m_virtualCommunicator=virtualCommunicator;
@@ -180,29 +199,23 @@ void SeedWorker::do_1_1_test(){
 		m_SEEDING_InedgesRequested=false;
 	}else if(!m_SEEDING_ingoingEdgesDone){
 		if(!m_SEEDING_InedgesRequested){
-
-			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
-			int bufferPosition=0;
-			m_SEEDING_currentVertex.pack(message,&bufferPosition);
-			Message aMessage(message,m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT),
-			m_parameters->_vertexRank(&m_SEEDING_currentVertex),
-				RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,getRank());
-			m_virtualCommunicator->pushMessage(m_workerIdentifier,&aMessage);
 			m_SEEDING_numberOfIngoingEdgesWithSeedCoverage=0;
 			m_SEEDING_numberOfOutgoingEdgesWithSeedCoverage=0;
 			m_SEEDING_vertexCoverageRequested=false;
 			m_SEEDING_InedgesReceived=false;
 			m_SEEDING_InedgesRequested=true;
-			m_ingoingEdgesReceived=false;
-			m_SEEDING_ingoingEdgeIndex=0;
-		}else if(m_virtualCommunicator->isMessageProcessed(m_workerIdentifier)
-			&&!m_ingoingEdgesReceived){
 			m_ingoingEdgesReceived=true;
-			vector<MessageUnit> elements;
-			m_virtualCommunicator->getMessageResponseElements(m_workerIdentifier,&elements);
-			uint8_t edges=elements[0];
-			m_mainVertexCoverage=elements[1];
-			
+			m_SEEDING_ingoingEdgeIndex=0;
+
+			// the test is only done on local vertices
+			Vertex*node=m_subgraph->find(&m_SEEDING_currentVertex);
+
+			#ifdef ASSERT
+			assert(node!=NULL);
+			#endif
+
+			uint8_t edges=node->getEdges(&m_SEEDING_currentVertex);
+			m_mainVertexCoverage=node->getCoverage(&m_SEEDING_currentVertex);
 
 			m_cache[m_SEEDING_currentVertex]=m_mainVertexCoverage;
 
@@ -231,6 +244,12 @@ void SeedWorker::do_1_1_test(){
 					m_SEEDING_receivedVertexCoverage=m_cache[vertex];
 					m_SEEDING_ingoingEdgeIndex++;
 					m_ingoingCoverages.push_back(m_SEEDING_receivedVertexCoverage);
+				}else if(!m_SEEDING_vertexCoverageRequested
+					&&m_subgraph->isLocalQuery(m_parameters->_vertexRank(&vertex))){
+					m_SEEDING_receivedVertexCoverage=m_subgraph->getLocalCoverage(&vertex);
+					m_cache[vertex]=m_SEEDING_receivedVertexCoverage;
+					m_SEEDING_ingoingEdgeIndex++;
+					m_ingoingCoverages.push_back(m_SEEDING_receivedVertexCoverage);
 				}else if(!m_SEEDING_vertexCoverageRequested){
 					MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(KMER_U64_ARRAY_SIZE*sizeof(MessageUnit));
 					int bufferPosition=0;
@@ -256,6 +275,12 @@ void SeedWorker::do_1_1_test(){
 					m_SEEDING_receivedVertexCoverage=m_cache[vertex];
 					m_SEEDING_outgoingEdgeIndex++;
 					m_outgoingCoverages.push_back(m_SEEDING_receivedVertexCoverage);
+				}else if(!m_SEEDING_vertexCoverageRequested
+					&&m_subgraph->isLocalQuery(m_parameters->_vertexRank(&vertex))){
+					m_SEEDING_receivedVertexCoverage=m_subgraph->getLocalCoverage(&vertex);
+					m_cache[vertex]=m_SEEDING_receivedVertexCoverage;
+					m_SEEDING_outgoingEdgeIndex++;
+					m_outgoingCoverages.push_back(m_SEEDING_receivedVertexCoverage);
 				}else if(!m_SEEDING_vertexCoverageRequested){
 					MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(KMER_U64_ARRAY_SIZE*sizeof(MessageUnit));
 					int bufferPosition=0;
@@ -347,6 +372,59 @@ void SeedWorker::do_1_1_test(){
 	}
 }
 
+/*
+ * the owner of m_SEEDING_currentVertex replies with
+ *
+ * <--1-1 test--><--coverage--><--parent--><--child-->
+ *
+ * outputs:
+ *
+ *  m_SEEDING_1_1_test_done
+ *  m_SEEDING_1_1_test_result
+ *  m_SEEDING_currentParentVertex
+ *  m_SEEDING_currentChildVertex
+ */
+void SeedWorker::fetchUnitigLink(){
+	// the vertex is on this rank, read its link directly
+	if(!m_unitigLinkRequested
+		&&m_subgraph->isLocalQuery(m_parameters->_vertexRank(&m_SEEDING_currentVertex))){
+		Vertex*node=m_subgraph->find(&m_SEEDING_currentVertex);
+		m_SEEDING_1_1_test_result=false;
+		m_cache[m_SEEDING_currentVertex]=0;
+
+		if(node!=NULL){
+			m_SEEDING_1_1_test_result=node->getUnitigLink(&m_SEEDING_currentVertex,&m_SEEDING_currentParentVertex,
+				&m_SEEDING_currentChildVertex,m_wordSize,m_parameters->getColorSpaceMode());
+			m_cache[m_SEEDING_currentVertex]=node->getCoverage(&m_SEEDING_currentVertex);
+		}
+
+		m_SEEDING_1_1_test_done=true;
+
+	}else if(!m_unitigLinkRequested){
+		int elements=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_GET_UNITIG_LINK);
+		MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(elements*sizeof(MessageUnit));
+		int bufferPosition=0;
+		m_SEEDING_currentVertex.pack(message,&bufferPosition);
+		Message aMessage(message,elements,m_parameters->_vertexRank(&m_SEEDING_currentVertex),
+			RAY_MPI_TAG_GET_UNITIG_LINK,getRank());
+		m_virtualCommunicator->pushMessage(m_workerIdentifier,&aMessage);
+		m_unitigLinkRequested=true;
+
+	}else if(m_virtualCommunicator->isMessageProcessed(m_workerIdentifier)){
+		vector<MessageUnit> response;
+		m_virtualCommunicator->getMessageResponseElements(m_workerIdentifier,&response);
+
+		int bufferPosition=0;
+		m_SEEDING_1_1_test_result=response[bufferPosition++];
+		m_cache[m_SEEDING_currentVertex]=response[bufferPosition++];
+		m_SEEDING_currentParentVertex.unpack(&response,&bufferPosition);
+		m_SEEDING_currentChildVertex.unpack(&response,&bufferPosition);
+
+		m_unitigLinkRequested=false;
+		m_SEEDING_1_1_test_done=true;
+	}
+}
+
 int SeedWorker::getSize(){
 	return m_size;
 }
@@ -27,18 +27,31 @@
 #include <memory/RingAllocator.h>
 #include <communication/VirtualCommunicator.h>
 #include <scheduling/Worker.h>
+#include <plugin_VerticesExtractor/GridTable.h>
 #include <vector>
 using namespace std;
 
 /*
- * Given a Kmer, SeedWorker determines if it spawns a seed.
- * If yes, it computes the seed.
+ * SeedWorker has two jobs.
+ *
+ * Before seeding, given a local Kmer, it does the 1-1 test and stores
+ * the unique parent and child in the vertex (the unitig link).
+ *
+ * During seeding, given a Kmer, it determines if it spawns a seed.
+ * If yes, it computes the seed by following the unitig links, with one
+ * query per vertex.
  * \author Sébastien Boisvert
  */
 class SeedWorker : public Worker {
 
-	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
+	MessageTag RAY_MPI_TAG_GET_UNITIG_LINK;
+
+	GridTable*m_subgraph;
+	bool m_linkOnly;
+
+	bool m_unitigLinkRequested;
+	Kmer m_firstChildVertex;
 
 	int m_mainVertexCoverage;
 
@@ -91,10 +104,10 @@ class SeedWorker : public Worker {
 	VirtualCommunicator*m_virtualCommunicator;
 public:
 	void constructor(Kmer*vertex,Parameters*parameters,RingAllocator*outboxAllocator,
-		VirtualCommunicator*vc,WorkerHandle workerId,
+		VirtualCommunicator*vc,WorkerHandle workerId,GridTable*subgraph,bool linkOnly,
 
-	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
-	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE
+	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,
+	MessageTag RAY_MPI_TAG_GET_UNITIG_LINK
 );
 
 	vector<Kmer>*getSeed();
@@ -102,6 +115,9 @@ public:
 
 	void do_1_1_test();
 
+/** get the unitig link of m_SEEDING_currentVertex from its owner **/
+	void fetchUnitigLink();
+
 	/** work a little bit 
 	 * the class Worker provides no implementation for that 
 	*/
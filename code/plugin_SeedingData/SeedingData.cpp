@@ -20,6 +20,7 @@
 */
 
 #include <application_core/constants.h>
+#include <application_core/CheckpointFile.h>
 #include <communication/VirtualCommunicator.h>
 #include <core/OperatingSystem.h>
 #include <algorithm>
@@ -37,6 +38,8 @@ __CreatePlugin(SeedingData);
  /**/
 __CreateSlaveModeAdapter(SeedingData,RAY_SLAVE_MODE_START_SEEDING); /**/
 __CreateSlaveModeAdapter(SeedingData,RAY_SLAVE_MODE_SEND_SEED_LENGTHS); /**/
+__CreateMessageTagAdapter(SeedingData,RAY_MPI_TAG_GET_UNITIG_LINK); /**/
+__CreateMessageTagAdapter(SeedingData,RAY_MPI_TAG_UNITIG_LINKS_ARE_READY); /**/
  /**/
  /**/
 
@@ -49,10 +52,9 @@ void SeedingData::call_RAY_SLAVE_MODE_START_SEEDING(){
 	if(!m_initiatedIterator){
 		m_last=time(NULL);
 
-		m_SEEDING_i=0;
+		m_linkingUnitigs=true;
+		startSeedingRound();
 
-		m_activeWorkerIterator=m_activeWorkers.begin();
-		m_splayTreeIterator.constructor(m_subgraph,m_wordSize,m_parameters);
 		m_initiatedIterator=true;
 		m_maximumAliveWorkers=32768;
 
@@ -78,6 +80,11 @@ void SeedingData::call_RAY_SLAVE_MODE_START_SEEDING(){
 		m_checkedCheckpoint=true;
 	}
 
+	// seeds can only be built once every rank has its unitig links
+	if(!m_linkingUnitigs&&m_ranksWithUnitigLinks<m_size){
+		return;
+	}
+
 	m_virtualCommunicator->processInbox(&m_activeWorkersToRestore);
 
 	if(!m_virtualCommunicator->isReady()){
@@ -104,7 +111,9 @@ void SeedingData::call_RAY_SLAVE_MODE_START_SEEDING(){
 		if(m_virtualCommunicator->getLocalPushedMessageStatus()){
 			m_waitingWorkers.push_back(workerId);
 		}
-		if(m_aliveWorkers[workerId].isDone()){
+		if(m_aliveWorkers[workerId].isDone()&&m_linkingUnitigs){
+			m_workersDone.push_back(workerId);
+		}else if(m_aliveWorkers[workerId].isDone()){
 			m_workersDone.push_back(workerId);
 			vector<Kmer> seed=*(m_aliveWorkers[workerId].getSeed());
 			vector<int>*coverageValues=m_aliveWorkers[workerId].getCoverageVector();
@@ -170,9 +179,12 @@ void SeedingData::call_RAY_SLAVE_MODE_START_SEEDING(){
 			// there is at least one worker to start
 			// AND
 			// the number of alive workers is below the maximum
-			if(m_SEEDING_i<m_subgraph->size()&&(int)m_aliveWorkers.size()<m_maximumAliveWorkers){
-				if(m_SEEDING_i % 100000 ==0){
-					printf("Rank %i is creating seeds [%i/%i]\n",getRank(),(int)m_SEEDING_i+1,(int)m_subgraph->size());
+			if(m_SEEDING_i<m_numberOfJobs&&(int)m_aliveWorkers.size()<m_maximumAliveWorkers){
+				if(m_SEEDING_i % 100000 ==0 && m_linkingUnitigs){
+					printf("Rank %i is linking unitigs [%i/%i]\n",getRank(),(int)m_SEEDING_i+1,(int)m_numberOfJobs);
+					fflush(stdout);
+				}else if(m_SEEDING_i % 100000 ==0){
+					printf("Rank %i is creating seeds [%i/%i]\n",getRank(),(int)m_SEEDING_i+1,(int)m_numberOfJobs);
 					fflush(stdout);
 
 					if(m_parameters->showMemoryUsage()){
@@ -189,9 +201,15 @@ void SeedingData::call_RAY_SLAVE_MODE_START_SEEDING(){
 				m_splayTreeIterator.next();
 				Kmer vertexKey=*(m_splayTreeIterator.getKey());
 
+				// one link is stored for both k-mers of a vertex
+				if(m_linkingUnitigs){
+					m_splayTreeIterator.next();
+				}
+
 				m_aliveWorkers[m_SEEDING_i].constructor(&vertexKey,m_parameters,m_outboxAllocator,m_virtualCommunicator,m_SEEDING_i,
-RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT,
-RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE
+m_subgraph,m_linkingUnitigs,
+RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE,
+RAY_MPI_TAG_GET_UNITIG_LINK
 );
 				m_activeWorkers.insert(m_SEEDING_i);
 
@@ -216,14 +234,30 @@ RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE
 	assert((int)m_aliveWorkers.size()<=m_maximumAliveWorkers);
 	#endif
 
-	if((int)m_subgraph->size()==m_completedJobs){
+	if(m_linkingUnitigs&&m_numberOfJobs==(LargeCount)m_completedJobs){
+		printf("Rank %i is linking unitigs [%i/%i] (completed)\n",getRank(),(int)m_SEEDING_i,(int)m_numberOfJobs);
+		fflush(stdout);
+		m_virtualCommunicator->printStatistics();
+		m_subgraph->printLocalQueries("linking unitigs");
+
+		// tell everyone that the links of this rank can be queried
+		for(Rank i=0;i<m_size;i++){
+			Message aMessage(NULL,0,i,RAY_MPI_TAG_UNITIG_LINKS_ARE_READY,getRank());
+			m_outbox->push_back(aMessage);
+		}
+
+		m_linkingUnitigs=false;
+		startSeedingRound();
+
+	}else if(!m_linkingUnitigs&&m_numberOfJobs==(LargeCount)m_completedJobs){
 		printf("Rank %i has %i seeds\n",m_rank,(int)m_SEEDING_seeds.size());
 		fflush(stdout);
-		printf("Rank %i is creating seeds [%i/%i] (completed)\n",getRank(),(int)m_SEEDING_i,(int)m_subgraph->size());
+		printf("Rank %i is creating seeds [%i/%i] (completed)\n",getRank(),(int)m_SEEDING_i,(int)m_numberOfJobs);
 		fflush(stdout);
 		printf("Rank %i: peak number of workers: %i, maximum: %i\n",m_rank,m_maximumWorkers,m_maximumAliveWorkers);
 		fflush(stdout);
 		m_virtualCommunicator->printStatistics();
+		m_subgraph->printLocalQueries("creating seeds");
 
 		(*m_mode)=RAY_SLAVE_MODE_DO_NOTHING;
 		Message aMessage(NULL,0,MASTER_RANK,RAY_MPI_TAG_SEEDING_IS_OVER,getRank());
@@ -262,11 +296,34 @@ RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE
 	}
 }
 
+/** restart the worker pool on the local vertices **/
+void SeedingData::startSeedingRound(){
+	m_SEEDING_i=0;
+	m_completedJobs=0;
+
+	m_numberOfJobs=m_subgraph->size();
+
+	if(m_linkingUnitigs){
+		m_numberOfJobs/=2;
+	}
+
+	m_splayTreeIterator.constructor(m_subgraph,m_wordSize,m_parameters);
+	m_activeWorkerIterator=m_activeWorkers.begin();
+
+	#ifdef ASSERT
+	assert(m_aliveWorkers.size()==0);
+	assert(m_activeWorkers.size()==0);
+	#endif
+}
+
 void SeedingData::constructor(SeedExtender*seedExtender,int rank,int size,StaticVector*outbox,RingAllocator*outboxAllocator,
 int*mode,
 	Parameters*parameters,int*wordSize,GridTable*subgraph,StaticVector*inbox,
 	VirtualCommunicator*vc){
 	m_checkedCheckpoint=false;
+	m_linkingUnitigs=true;
+	m_ranksWithUnitigLinks=0;
+	m_numberOfJobs=0;
 	m_virtualCommunicator=vc;
 	m_seedExtender=seedExtender;
 	m_size=size;
@@ -374,6 +431,49 @@ void SeedingData::call_RAY_SLAVE_MODE_SEND_SEED_LENGTHS(){
 	m_outbox->push_back(aMessage);
 }
 
+/*
+ * <--vertex--> for each query
+ *
+ * reply: <--1-1 test--><--coverage--><--parent--><--child-->
+ */
+void SeedingData::call_RAY_MPI_TAG_GET_UNITIG_LINK(Message*message){
+	MessageUnit*incoming=(MessageUnit*)message->getBuffer();
+	int count=message->getCount();
+	int period=m_virtualCommunicator->getElementsPerQuery(RAY_MPI_TAG_GET_UNITIG_LINK);
+	MessageUnit*outgoingMessage=(MessageUnit*)m_outboxAllocator->allocate(count*sizeof(MessageUnit));
+
+	for(int i=0;i+period<=count;i+=period){
+		Kmer vertex;
+		int bufferPosition=i;
+		vertex.unpack(incoming,&bufferPosition);
+
+		Kmer parent;
+		Kmer child;
+		bool oneToOne=false;
+		CoverageDepth coverage=0;
+
+		Vertex*node=m_subgraph->find(&vertex);
+
+		if(node!=NULL){
+			oneToOne=node->getUnitigLink(&vertex,&parent,&child,m_wordSize,m_parameters->getColorSpaceMode());
+			coverage=node->getCoverage(&vertex);
+		}
+
+		int outputPosition=i;
+		outgoingMessage[outputPosition++]=oneToOne;
+		outgoingMessage[outputPosition++]=coverage;
+		parent.pack(outgoingMessage,&outputPosition);
+		child.pack(outgoingMessage,&outputPosition);
+	}
+
+	Message aMessage(outgoingMessage,count,message->getSource(),RAY_MPI_TAG_GET_UNITIG_LINK_REPLY,m_rank);
+	m_outbox->push_back(aMessage);
+}
+
+void SeedingData::call_RAY_MPI_TAG_UNITIG_LINKS_ARE_READY(Message*message){
+	m_ranksWithUnitigLinks++;
+}
+
 void SeedingData::writeSeedStatistics(){
 	ostringstream file;
 	file<<m_parameters->getPrefix();
@@ -391,7 +491,7 @@ void SeedingData::writeSeedStatistics(){
 void SeedingData::loadCheckpoint(){
 	cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint Seeds"<<endl;
 
-	ifstream f(m_parameters->getCheckpointFile("Seeds").c_str());
+	CheckpointReader f(m_parameters,"Seeds");
 	int n=0;
 	f.read((char*)&n,sizeof(int));
 	for(int i=0;i<n;i++){
@@ -429,6 +529,20 @@ void SeedingData::registerPlugin(ComputeCore*core){
 	RAY_MPI_TAG_SEND_SEED_LENGTHS_REPLY=core->allocateMessageTagHandle(plugin);
 	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_SEND_SEED_LENGTHS_REPLY,"RAY_MPI_TAG_SEND_SEED_LENGTHS_REPLY");
 
+	RAY_MPI_TAG_GET_UNITIG_LINK=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_GET_UNITIG_LINK,__GetAdapter(SeedingData,RAY_MPI_TAG_GET_UNITIG_LINK));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_GET_UNITIG_LINK,"RAY_MPI_TAG_GET_UNITIG_LINK");
+
+	RAY_MPI_TAG_GET_UNITIG_LINK_REPLY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_GET_UNITIG_LINK_REPLY,"RAY_MPI_TAG_GET_UNITIG_LINK_REPLY");
+
+	core->setMessageTagReplyMessageTag(plugin,RAY_MPI_TAG_GET_UNITIG_LINK,RAY_MPI_TAG_GET_UNITIG_LINK_REPLY);
+	core->setMessageTagSize(plugin,RAY_MPI_TAG_GET_UNITIG_LINK,2+2*KMER_U64_ARRAY_SIZE);
+
+	RAY_MPI_TAG_UNITIG_LINKS_ARE_READY=core->allocateMessageTagHandle(plugin);
+	core->setMessageTagObjectHandler(plugin,RAY_MPI_TAG_UNITIG_LINKS_ARE_READY,__GetAdapter(SeedingData,RAY_MPI_TAG_UNITIG_LINKS_ARE_READY));
+	core->setMessageTagSymbol(plugin,RAY_MPI_TAG_UNITIG_LINKS_ARE_READY,"RAY_MPI_TAG_UNITIG_LINKS_ARE_READY");
+
 }
 
 void SeedingData::resolveSymbols(ComputeCore*core){
@@ -436,8 +550,10 @@ void SeedingData::resolveSymbols(ComputeCore*core){
 	RAY_SLAVE_MODE_DO_NOTHING=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_DO_NOTHING");
 	RAY_SLAVE_MODE_SEND_SEED_LENGTHS=core->getSlaveModeFromSymbol(m_plugin,"RAY_SLAVE_MODE_SEND_SEED_LENGTHS");
 
-	RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT");
 	RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE");
+	RAY_MPI_TAG_GET_UNITIG_LINK=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_UNITIG_LINK");
+	RAY_MPI_TAG_GET_UNITIG_LINK_REPLY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_GET_UNITIG_LINK_REPLY");
+	RAY_MPI_TAG_UNITIG_LINKS_ARE_READY=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_UNITIG_LINKS_ARE_READY");
 
 	RAY_MPI_TAG_IS_DONE_SENDING_SEED_LENGTHS=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_IS_DONE_SENDING_SEED_LENGTHS");
 	RAY_MPI_TAG_SEEDING_IS_OVER=core->getMessageTagFromSymbol(m_plugin,"RAY_MPI_TAG_SEEDING_IS_OVER");
@@ -47,6 +47,10 @@ using namespace std;
  * this class. It is a pool of workers that does the job.
  * These workers push messages on the virtual
  * communicator and the later groups messages.
+ *
+ * Seeding has two rounds: first the unitig link of every local
+ * vertex is computed, then, once every rank has its links, seeds are
+ * built by following the links.
  * \author Sébastien Boisvert
  */
 class SeedingData : public CorePlugin{
@@ -56,8 +60,10 @@ class SeedingData : public CorePlugin{
 	MessageTag RAY_MPI_TAG_SEND_SEED_LENGTHS;
 	MessageTag RAY_MPI_TAG_SEND_SEED_LENGTHS_REPLY;
 
-	MessageTag RAY_MPI_TAG_GET_VERTEX_EDGES_COMPACT;
 	MessageTag RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE;
+	MessageTag RAY_MPI_TAG_GET_UNITIG_LINK;
+	MessageTag RAY_MPI_TAG_GET_UNITIG_LINK_REPLY;
+	MessageTag RAY_MPI_TAG_UNITIG_LINKS_ARE_READY;
 
 	SlaveMode RAY_SLAVE_MODE_DO_NOTHING;
 	SlaveMode RAY_SLAVE_MODE_START_SEEDING;
@@ -68,6 +74,11 @@ class SeedingData : public CorePlugin{
 	/** checkpointing */
 	bool m_checkedCheckpoint;
 
+	/** the first round computes the unitig links **/
+	bool m_linkingUnitigs;
+	int m_ranksWithUnitigLinks;
+	LargeCount m_numberOfJobs;
+
 	map<int,int>::iterator m_iterator;
 
 	bool m_flushAllMode;
@@ -97,6 +108,7 @@ class SeedingData : public CorePlugin{
 	time_t m_last;
 
 	void loadCheckpoint();
+	void startSeedingRound();
 public:
 
 	map<int,int> m_masterSeedLengths;
@@ -124,6 +136,10 @@ public:
 	bool m_SEEDING_passedParentsTest;
 	bool m_SEEDING_Extended;
 	bool m_SEEDING_edgesReceived;
+
+	// replies of RAY_MPI_TAG_REQUEST_VERTICES_COVERAGE_AND_EDGES
+	vector<MessageUnit> m_SEEDING_receivedVertexData;
+	int m_SEEDING_receivedVertexReplies;
 	LargeIndex m_SEEDING_i;
 
 	int m_SEEDING_outgoing_index;
@@ -147,6 +163,9 @@ public:
 
 	void call_RAY_SLAVE_MODE_SEND_SEED_LENGTHS();
 
+	void call_RAY_MPI_TAG_GET_UNITIG_LINK(Message*message);
+	void call_RAY_MPI_TAG_UNITIG_LINKS_ARE_READY(Message*message);
+
 	bool m_initialized;
 	void writeSeedStatistics();
 
@@ -25,7 +25,7 @@
 
 void IndexerWorker::constructor(int sequenceId,Parameters*parameters,RingAllocator*outboxAllocator,
 	VirtualCommunicator*vc,WorkerHandle workerId,ArrayOfReads*a,MyAllocator*allocator,
-	ofstream*f,
+	GridTable*subgraph,ofstream*f,
 	map<int,map<int,int> >*forwardStatistics,
 	map<int,map<int,int> >*reverseStatistics,
 
@@ -45,6 +45,7 @@ void IndexerWorker::constructor(int sequenceId,Parameters*parameters,RingAllocat
 	m_parameters=parameters;
 	m_outboxAllocator=outboxAllocator;
 	m_virtualCommunicator=vc;
+	m_subgraph=subgraph;
 	m_workerId=workerId;
 	m_done=false;
 	m_forwardIndexed=false;
@@ -78,6 +79,14 @@ void IndexerWorker::work(){
 			Kmer vertex=read->getVertex(m_position,m_parameters->getWordSize(),'F',m_parameters->getColorSpaceMode());
 			m_vertices.push_back(vertex,m_allocator);
 			int sendTo=m_parameters->_vertexRank(&vertex);
+
+			// the vertex is on this rank, no message is needed
+			if(m_subgraph->isLocalQuery(sendTo)){
+				m_coverages.push_back(m_subgraph->getLocalCoverage(&vertex),m_allocator);
+				m_position++;
+				return;
+			}
+
 			MessageUnit*message=(MessageUnit*)m_outboxAllocator->allocate(1*sizeof(MessageUnit));
 			int bufferPosition=0;
 			vertex.pack(message,&bufferPosition);
@@ -29,6 +29,7 @@
 #include <memory/MyAllocator.h>
 #include <plugin_SequencesLoader/ArrayOfReads.h>
 #include <plugin_SequencesIndexer/DynamicVector.h>
+#include <plugin_VerticesExtractor/GridTable.h>
 #include <scheduling/Worker.h>
 #include <fstream>
 using namespace std;
@@ -55,6 +56,7 @@ class IndexerWorker /*: public Worker*/{
 	bool m_done;
 	int m_position;
 	VirtualCommunicator*m_virtualCommunicator;
+	GridTable*m_subgraph;
 	bool m_indexedTheVertex;
 	Parameters*m_parameters;
 	int m_workerId;
@@ -76,7 +78,7 @@ class IndexerWorker /*: public Worker*/{
 public:
 	void constructor(int sequenceId,Parameters*parameters,RingAllocator*outboxAllocator,
 		VirtualCommunicator*vc,WorkerHandle workerId,ArrayOfReads*a,MyAllocator*allocator,
-	ofstream*f,
+	GridTable*subgraph,ofstream*f,
 	map<int,map<int,int> >*forwardStatistics,
 	map<int,map<int,int> >*reverseStatistics,
 	MessageTag RAY_MPI_TAG_ATTACH_SEQUENCE,
@@ -46,13 +46,13 @@ int PairedRead::getLibrary(){
 	return m_library;
 }
 
-void PairedRead::write(ofstream*f){
+void PairedRead::write(ostream*f){
 	f->write((char*)&m_readIndex,sizeof(uint32_t));
 	f->write((char*)&m_rank,sizeof(uint16_t));
 	f->write((char*)&m_library,sizeof(uint16_t));
 }
 
-void PairedRead::read(ifstream*f){
+void PairedRead::read(istream*f){
 	f->read((char*)&m_readIndex,sizeof(uint32_t));
 	f->read((char*)&m_rank,sizeof(uint16_t));
 	f->read((char*)&m_library,sizeof(uint16_t));
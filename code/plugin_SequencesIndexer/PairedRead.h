@@ -46,8 +46,8 @@ public:
 	ReadHandle getUniqueId();
 	int getLibrary();
 
-	void read(ifstream*f);
-	void write(ofstream*f);
+	void read(istream*f);
+	void write(ostream*f);
 } ATTRIBUTE_PACKED;
 
 #endif
@@ -119,7 +119,7 @@ void SequencesIndexer::call_RAY_SLAVE_MODE_INDEX_SEQUENCES(){
 
 				bool flag;
 				m_aliveWorkers.insert(m_theSequenceId,&m_workAllocator,&flag)->getValue()->constructor(m_theSequenceId,m_parameters,m_outboxAllocator,m_virtualCommunicator,
-					m_theSequenceId,m_myReads,&m_workAllocator,&m_readMarkerFile,&m_forwardStatistics,
+					m_theSequenceId,m_myReads,&m_workAllocator,m_subgraph,&m_readMarkerFile,&m_forwardStatistics,
 					&m_reverseStatistics,
 	RAY_MPI_TAG_ATTACH_SEQUENCE,
 	RAY_MPI_TAG_REQUEST_VERTEX_COVERAGE
@@ -156,6 +156,7 @@ void SequencesIndexer::call_RAY_SLAVE_MODE_INDEX_SEQUENCES(){
 		m_derivative.writeFile(&cout);
 
 		m_virtualCommunicator->printStatistics();
+		m_subgraph->printLocalQueries("selecting optimal read markers");
 
 		if(m_parameters->showMemoryUsage()){
 			showMemoryUsage(m_rank);
@@ -219,9 +220,10 @@ void SequencesIndexer::call_RAY_SLAVE_MODE_INDEX_SEQUENCES(){
 
 void SequencesIndexer::constructor(Parameters*parameters,RingAllocator*outboxAllocator,StaticVector*inbox,StaticVector*outbox,VirtualCommunicator*vc,
 SlaveMode*mode,
-	ArrayOfReads*myReads
+	ArrayOfReads*myReads,GridTable*subgraph
 ){
 	m_mode=mode;
+	m_subgraph=subgraph;
 	m_outboxAllocator=outboxAllocator;
 	m_myReads=myReads;
 	m_outbox=outbox;
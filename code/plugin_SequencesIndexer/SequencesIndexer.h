@@ -34,6 +34,7 @@
 #include <structures/SplayTreeIterator.h>
 #include <structures/StaticVector.h>
 #include <plugin_SequencesLoader/ArrayOfReads.h>
+#include <plugin_VerticesExtractor/GridTable.h>
 #include <profiling/Derivative.h>
 #include <plugin_SequencesLoader/Read.h>
 #include <core/ComputeCore.h>
@@ -88,6 +89,7 @@ class SequencesIndexer: public CorePlugin{
 	StaticVector*m_outbox;
 
 	VirtualCommunicator*m_virtualCommunicator;
+	GridTable*m_subgraph;
 	SplayTree<WorkerHandle,char> m_activeWorkers;
 	SplayTreeIterator<WorkerHandle,char> m_activeWorkerIterator;
 
@@ -110,7 +112,7 @@ public:
 	void call_RAY_SLAVE_MODE_INDEX_SEQUENCES();
 
 	void constructor(Parameters*parameters,RingAllocator*outboxAllocator,StaticVector*inbox,StaticVector*outbox,
-	VirtualCommunicator*vc,SlaveMode*mode,ArrayOfReads*myReads);
+	VirtualCommunicator*vc,SlaveMode*mode,ArrayOfReads*myReads,GridTable*subgraph);
 
 	void setReadiness();
 	MyAllocator*getAllocator();
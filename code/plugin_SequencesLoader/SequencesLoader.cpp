@@ -21,6 +21,7 @@ Ray
 
 #include<string.h>
 #include<plugin_SequencesLoader/SequencesLoader.h>
+#include <application_core/CheckpointFile.h>
 #include <core/OperatingSystem.h>
 #include<communication/Message.h>
 #include<plugin_SeedExtender/BubbleData.h>
@@ -215,7 +216,7 @@ bool SequencesLoader::call_RAY_SLAVE_MODE_LOAD_SEQUENCES(){
 		cout<<"Rank "<<m_parameters->getRank()<<" is reading checkpoint Sequences"<<endl;
 		cout.flush();
 
-		ifstream f(m_parameters->getCheckpointFile("Sequences").c_str());
+		CheckpointReader f(m_parameters,"Sequences");
 		LargeCount count=0;
 		f.read((char*)&count,sizeof(LargeCount));
 		for(LargeIndex i=0;i<count;i++){
@@ -329,7 +330,7 @@ bool SequencesLoader::call_RAY_SLAVE_MODE_LOAD_SEQUENCES(){
 		cout<<"Rank "<<m_parameters->getRank()<<" is writing checkpoint Sequences"<<endl;
 		cout.flush();
 
-		ofstream f(m_parameters->getCheckpointFile("Sequences").c_str());
+		CheckpointWriter f(m_parameters,"Sequences");
 
 		LargeCount count=m_myReads->size();
 		f.write((char*)&count,sizeof(LargeCount));
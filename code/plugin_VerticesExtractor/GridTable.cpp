@@ -56,6 +56,8 @@ void GridTable::constructor(int rank,Parameters*parameters){
 	}
 
 	m_findOperations=0;
+	m_localQueries=0;
+	m_remoteQueries=0;
 
 	m_verbose=false;
 }
@@ -260,3 +262,38 @@ void GridTable::printStatistics(){
 void GridTable::completeResizing(){
 	m_hashTable.completeResizing();
 }
+
+bool GridTable::isLocalQuery(Rank destination){
+	if(destination==m_parameters->getRank()){
+		m_localQueries++;
+		return true;
+	}
+
+	m_remoteQueries++;
+	return false;
+}
+
+CoverageDepth GridTable::getLocalCoverage(Kmer*key){
+	Vertex*node=find(key);
+
+	// if it is not there, then it has a coverage of 0
+	if(node==NULL)
+		return 0;
+
+	return node->getCoverage(key);
+}
+
+void GridTable::printLocalQueries(const char*step){
+	LargeCount total=m_localQueries+m_remoteQueries;
+	double ratio=0;
+
+	if(total>0)
+		ratio=(100.0*m_localQueries)/total;
+
+	printf("Rank %i resolved %lu of %lu queries locally (%.2f%%) while %s\n",
+		m_parameters->getRank(),(unsigned long)m_localQueries,(unsigned long)total,ratio,step);
+	fflush(stdout);
+
+	m_localQueries=0;
+	m_remoteQueries=0;
+}
@@ -43,6 +43,10 @@ class GridTable{
 
 	LargeCount m_findOperations;
 
+	/** queries of workers, by where they were resolved */
+	LargeCount m_localQueries;
+	LargeCount m_remoteQueries;
+
 	/** verbosity */
 	bool m_verbose;
 
@@ -68,6 +72,15 @@ public:
 	MyHashTable<Kmer,Vertex>*getHashTable();
 	void printStatistics();
 	void completeResizing();
+
+	/** a worker about to query a k-mer asks this first: if the
+	 * destination is this rank, the query is resolved with find()
+	 * instead of a message. Every call is counted. */
+	bool isLocalQuery(Rank destination);
+	CoverageDepth getLocalCoverage(Kmer*key);
+
+	/** print and reset the query counters */
+	void printLocalQueries(const char*step);
 };
 
 #endif
@@ -29,6 +29,10 @@ using namespace std;
 
 #define __NO_ORIGIN -999
 
+/* m_unitigLink: bits 0-1 are the first code of the parent,
+ * bits 2-3 the last code of the child */
+#define __UNITIG_LINK_ONE_TO_ONE 16
+
 void Vertex::constructor(){
 	m_coverage_lower=0;
 	m_edges_lower=0;
@@ -36,6 +40,7 @@ void Vertex::constructor(){
 	m_readsStartingHere=NULL;
 	m_directions=NULL;
 	m_assembled=__NO_ORIGIN;
+	m_unitigLink=0;
 
 	m_color=0;
 }
@@ -236,7 +241,7 @@ void Vertex::clearDirections(Kmer*a){
 	m_directions=NULL;
 }
 
-void Vertex::write(Kmer*key,ofstream*f,int kmerLength){
+void Vertex::write(Kmer*key,ostream*f,int kmerLength){
 	int coverage=getCoverage(key);
 	key->write(f);
 	f->write((char*)&coverage,sizeof(int));
@@ -254,7 +259,7 @@ void Vertex::write(Kmer*key,ofstream*f,int kmerLength){
 	}
 }
 
-void Vertex::writeAnnotations(Kmer*key,ofstream*f,int kmerLength,bool color){
+void Vertex::writeAnnotations(Kmer*key,ostream*f,int kmerLength,bool color){
 	key->write(f);
 
 	Kmer complement=key->complementVertex(kmerLength,color);
@@ -297,3 +302,43 @@ void Vertex::setKey(Kmer key){
 }
 
 
+
+void Vertex::setUnitigLink(Kmer*a,bool oneToOne,Kmer*parent,Kmer*child,int k,bool colorSpace){
+	m_unitigLink=0;
+
+	if(!oneToOne)
+		return;
+
+	Kmer lowerParent=*parent;
+	Kmer lowerChild=*child;
+
+	// the parent of the lower k-mer is the complement of the child of the higher one
+	if(!(*a==m_lowerKey)){
+		lowerParent=child->complementVertex(k,colorSpace);
+		lowerChild=parent->complementVertex(k,colorSpace);
+	}
+
+	m_unitigLink=__UNITIG_LINK_ONE_TO_ONE|lowerParent.getFirstSegmentFirstCode(k)
+		|(lowerChild.getSecondSegmentLastCode(k)<<2);
+}
+
+bool Vertex::getUnitigLink(Kmer*a,Kmer*parent,Kmer*child,int k,bool colorSpace){
+	if(!(m_unitigLink&__UNITIG_LINK_ONE_TO_ONE))
+		return false;
+
+	uint8_t parentCode=m_unitigLink&3;
+	uint8_t childCode=(m_unitigLink>>2)&3;
+
+	Kmer lowerParent=m_lowerKey._getIngoingEdges(1<<parentCode,k)[0];
+	Kmer lowerChild=m_lowerKey._getOutgoingEdges(1<<(4+childCode),k)[0];
+
+	if(*a==m_lowerKey){
+		*parent=lowerParent;
+		*child=lowerChild;
+	}else{
+		*parent=lowerChild.complementVertex(k,colorSpace);
+		*child=lowerParent.complementVertex(k,colorSpace);
+	}
+
+	return true;
+}
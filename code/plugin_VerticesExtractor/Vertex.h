@@ -75,6 +75,9 @@ public:
 /** the greatest rank that assembled the k-mer **/
 	Rank m_assembled;
 
+/** the unique parent and child of the lower k-mer, computed before seeding **/
+	uint8_t m_unitigLink;
+
 
 	void addOutgoingEdge_ClassicMethod(Kmer*vertex,Kmer*a,int k);
 	void addIngoingEdge_ClassicMethod(Kmer*vertex,Kmer*a,int k);
@@ -101,8 +104,8 @@ public:
 	bool isAssembled();
 	bool isAssembledByGreaterRank(Rank origin);
 
-	void write(Kmer*key,ofstream*f,int kmerLength);
-	void writeAnnotations(Kmer*key,ofstream*f,int kmerLength,bool color);
+	void write(Kmer*key,ostream*f,int kmerLength);
+	void writeAnnotations(Kmer*key,ostream*f,int kmerLength,bool color);
 
 	VirtualKmerColorHandle getVirtualColor();
 
@@ -111,6 +114,14 @@ public:
 	Kmer getKey();
 	void setKey(Kmer key);
 
+/** store the outcome of the 1-1 test of a k-mer.
+ * Only one link is stored, the links of the other k-mer are
+ * obtained by complementing. **/
+	void setUnitigLink(Kmer*a,bool oneToOne,Kmer*parent,Kmer*child,int k,bool colorSpace);
+
+/** returns true if the k-mer passed the 1-1 test **/
+	bool getUnitigLink(Kmer*a,Kmer*parent,Kmer*child,int k,bool colorSpace);
+
 
 
 } ATTRIBUTE_PACKED;
@@ -0,0 +1,97 @@
+#!/usr/bin/python
+"""Dump a table from BiologicalAbundances/AbundanceTables.bin in tsv format
+
+The file is written by Ray when -write-abundance-tables is provided.
+Tables: sequences, contigs, taxons
+
+Usage:
+    read-abundance-tables.py AbundanceTables.bin [sequences|contigs|taxons]
+
+Without a table name, the row groups are listed.
+
+Sebastien Boisvert
+"""
+
+import sys
+import struct
+
+TABLES=['sequences','contigs','taxons']
+
+INTEGER=0
+REAL=1
+TEXT=2
+
+def readRowGroups(fileName):
+	stream=open(fileName,'rb')
+	data=stream.read()
+	stream.close()
+
+	position=0
+
+	while position<len(data):
+		magic=data[position:position+4]
+		if magic!=b'RCRG':
+			sys.stderr.write("Error: bad row group at offset "+str(position)+"\n")
+			sys.exit(1)
+		position+=4
+
+		version,table,rank=struct.unpack_from('<III',data,position)
+		position+=12
+		rows,=struct.unpack_from('<Q',data,position)
+		position+=8
+		columns,=struct.unpack_from('<I',data,position)
+		position+=4
+
+		names=[]
+		values=[]
+
+		for i in range(columns):
+			columnType,nameLength=struct.unpack_from('<II',data,position)
+			position+=8
+			name=data[position:position+nameLength].decode('utf-8')
+			position+=nameLength
+			bytes,=struct.unpack_from('<Q',data,position)
+			position+=8
+
+			if columnType==INTEGER:
+				column=list(struct.unpack_from('<'+str(rows)+'q',data,position))
+			elif columnType==REAL:
+				column=list(struct.unpack_from('<'+str(rows)+'d',data,position))
+			else:
+				offsets=struct.unpack_from('<'+str(rows+1)+'I',data,position)
+				start=position+4*(rows+1)
+				column=[]
+				for j in range(rows):
+					column.append(data[start+offsets[j]:start+offsets[j+1]].decode('utf-8','replace'))
+
+			position+=bytes
+
+			names.append(name)
+			values.append(column)
+
+		yield (table,rank,rows,names,values)
+
+if len(sys.argv)<2 or len(sys.argv)>3:
+	sys.stdout.write(__doc__)
+	sys.exit(1)
+
+fileName=sys.argv[1]
+
+if len(sys.argv)==2:
+	for table,rank,rows,names,values in readRowGroups(fileName):
+		sys.stdout.write(TABLES[table]+"	rank "+str(rank)+"	"+str(rows)+" rows\n")
+	sys.exit(0)
+
+wanted=TABLES.index(sys.argv[2])
+printedHeader=False
+
+for table,rank,rows,names,values in readRowGroups(fileName):
+	if table!=wanted:
+		continue
+
+	if not printedHeader:
+		sys.stdout.write("#"+"	".join(names)+"\n")
+		printedHeader=True
+
+	for i in range(rows):
+		sys.stdout.write("	".join([str(column[i]) for column in values])+"\n")